@@ -0,0 +1,230 @@
+#include "harness.hpp"
+
+#include "csr_graph.hpp"
+#include "color.hpp"
+#include "dsatur_color.hpp"
+#include "recolor.hpp"
+#include "fastwclq.hpp"
+#include "branching_strategy.hpp"
+#include "common.hpp"
+#include "graph_generators.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Micro-benchmarks of the kernels of the search on every graph of a directory: clone,
+ * merge, edge insertion and lookup, colorings, recoloring, clique, branching and the
+ * (de)serialization of the branches exchanged between ranks.
+ *
+ * Usage: bench [--graphs=<directory>] [--filter=<substring>] [--generate=<spec>]... [--repetitions=<n>]
+ *              [--warmup=<n>] [--budget=<seconds>] [--csv=<file>] [--json=<file>]
+ *
+ * --generate adds a synthetic graph (see GraphGenerator::FromSpec, e.g. gnp:n=500,p=0.1), the
+ * directory is then only read if --graphs is given too.
+ */
+
+// results of the kernels, so that the compiler keeps them
+static volatile long sink;
+
+/**
+ * @brief up to count distinct pairs of non adjacent vertices, drawn with a fixed seed
+ */
+static std::vector<std::pair<int, int>> NonAdjacentPairs(const Graph& graph, size_t count) {
+    const std::vector<int>& vertices = graph.GetVertices();
+    std::vector<std::pair<int, int>> pairs;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> draw(0, vertices.size() - 1);
+    for ( size_t attempt = 0; attempt < 20 * count && pairs.size() < count; attempt++ ) {
+        int v = vertices[draw(random)], w = vertices[draw(random)];
+        if ( v == w || graph.HasEdge(v, w) ||
+             std::find(pairs.begin(), pairs.end(), std::make_pair(std::min(v, w), std::max(v, w))) != pairs.end() ) {
+            continue;
+        }
+        pairs.emplace_back(std::min(v, w), std::max(v, w));
+    }
+    return pairs;
+}
+
+static void BenchGraph(BenchHarness& harness, const CSRGraph& graph, const std::string& name) {
+    auto none = [] { return 0; };
+    auto clone = [&graph] { return graph.Clone(); };
+
+    harness.Run("clone", name, none, [&graph](int) { sink = sink + graph.Clone()->GetNumVertices(); });
+
+    std::vector<std::pair<int, int>> pairs = NonAdjacentPairs(graph, 64);
+    if ( !pairs.empty() ) {
+        std::pair<int, int> merged = pairs.front();
+        harness.Run("merge_vertices", name, clone, [merged](GraphPtr& g) { g->MergeVertices(merged.first, merged.second); });
+        harness.Run("add_edge", name, clone, [&pairs](GraphPtr& g) {
+            for ( const auto& [v, w] : pairs ) {
+                g->AddEdge(v, w);
+            }
+        }, pairs.size());
+    }
+
+    std::vector<std::pair<int, int>> queries;
+    {
+        const std::vector<int>& vertices = graph.GetVertices();
+        std::mt19937 random(7);
+        std::uniform_int_distribution<size_t> draw(0, vertices.size() - 1);
+        for ( int i = 0; i < 1024; i++ ) {
+            queries.emplace_back(vertices[draw(random)], vertices[draw(random)]);
+        }
+    }
+    harness.Run("has_edge", name, none, [&graph, &queries](int) {
+        long found = 0;
+        for ( const auto& [v, w] : queries ) {
+            found += graph.HasEdge(v, w);
+        }
+        sink = sink + found;
+    }, queries.size());
+
+    GreedyColorStrategy greedy;
+    DSaturColorStrategy dsatur;
+    GreedySwapRecolorStrategy recolor;
+    harness.Run("greedy_color", name, clone, [&greedy](GraphPtr& g) {
+        unsigned short k;
+        greedy.Color(*g, k);
+        sink = sink + k;
+    });
+    harness.Run("dsatur_color", name, clone, [&dsatur](GraphPtr& g) {
+        unsigned short k;
+        dsatur.Color(*g, k);
+        sink = sink + k;
+    });
+    auto colored = [&graph, &greedy] {
+        GraphPtr g = graph.Clone();
+        unsigned short k;
+        greedy.Color(*g, k);
+        return g;
+    };
+    harness.Run("greedy_swap_recolor", name, colored, [&recolor](GraphPtr& g) { sink = sink + recolor.Recolor(*g); });
+
+    FastCliqueStrategy clique;
+    harness.Run("fast_clique", name, none, [&graph, &clique](int) { sink = sink + clique.FindClique(graph); });
+
+    NeighboursBranchingStrategy branching;
+    harness.Run("neighbours_branching", name, clone, [&branching](GraphPtr& g) {
+        sink = sink + branching.ChooseVertices(*g).first;
+    });
+
+    Branch branch(graph.Clone(), 1, graph.GetNumVertices(), 1);
+    std::vector<char> buffer = branch.serialize();
+    harness.Run("serialize", name, none, [&branch](int) { sink = sink + branch.serialize().size(); });
+    harness.Run("deserialize", name, none, [&buffer](int) { sink = sink + Branch::deserialize(buffer).depth; });
+}
+
+int main(int argc, char** argv) {
+    std::string graphs_directory = "../src/scripts/graphs_instances";
+    std::string filter;
+    std::vector<std::string> generate;
+    bool graphs_given = false;
+    std::string csv_file;
+    std::string json_file;
+    int repetitions = 15;
+    int warmup = 2;
+    double budget = 2.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t pos = arg.find('=');
+        if (pos == std::string::npos) {
+            std::cerr << "Error: Invalid argument format " << arg << "\n";
+            return 1;
+        }
+        std::string key = arg.substr(0, pos);
+        std::string value = arg.substr(pos + 1);
+        try {
+            if (key == "--graphs") {
+                graphs_directory = value;
+                graphs_given = true;
+            } else if (key == "--filter") {
+                filter = value;
+            } else if (key == "--generate") {
+                generate.push_back(value);
+            } else if (key == "--repetitions") {
+                repetitions = std::max(1, std::stoi(value));
+            } else if (key == "--warmup") {
+                warmup = std::stoi(value);
+            } else if (key == "--budget") {
+                budget = std::stod(value);
+            } else if (key == "--csv") {
+                csv_file = value;
+            } else if (key == "--json") {
+                json_file = value;
+            } else {
+                std::cerr << "Error: Unknown argument " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Invalid value for " << key << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<std::filesystem::path> graph_files;
+    if (graphs_given || generate.empty()) {
+        try {
+            for (const auto& entry : std::filesystem::directory_iterator(graphs_directory)) {
+                if (entry.path().extension() == ".col" && entry.path().filename().string().find(filter) != std::string::npos) {
+                    graph_files.push_back(entry.path());
+                }
+            }
+        } catch (const std::filesystem::filesystem_error& e) {
+            std::cerr << "Error: cannot list " << graphs_directory << ": " << e.what() << "\n";
+            return 1;
+        }
+        std::sort(graph_files.begin(), graph_files.end());
+    }
+
+    BenchHarness harness(warmup, repetitions, budget);
+    std::cout << std::left << std::setw(22) << "kernel" << std::setw(20) << "graph" << std::right << std::setw(6) << "reps"
+              << std::setw(14) << "median_ns" << std::setw(14) << "p90_ns" << std::setw(14) << "ops/s" << std::endl;
+    auto bench_and_print = [&harness](const CSRGraph& graph, const std::string& name) {
+        size_t first = harness.Results().size();
+        BenchGraph(harness, graph, name);
+        for (size_t i = first; i < harness.Results().size(); i++) {
+            const BenchResult& r = harness.Results()[i];
+            std::cout << std::left << std::setw(22) << r.kernel << std::setw(20) << r.graph << std::right
+                      << std::setw(6) << r.repetitions << std::fixed << std::setprecision(1) << std::setw(14) << r.median_ns
+                      << std::setw(14) << r.p90_ns << std::setprecision(0) << std::setw(14) << r.OpsPerSecond()
+                      << std::defaultfloat << std::endl;
+        }
+    };
+    for (const std::filesystem::path& file : graph_files) {
+        std::unique_ptr<CSRGraph> graph(CSRGraph::LoadFromDimacs(file.string()));
+        if (!graph) {
+            std::cerr << "Error: cannot load " << file << "\n";
+            continue;
+        }
+        bench_and_print(*graph, file.filename().string());
+    }
+    for (const std::string& spec : generate) {
+        GeneratedGraph generated;
+        std::string error;
+        if (!GraphGenerator::FromSpec(spec, generated, error)) {
+            std::cerr << "Error: " << error << "\n";
+            return 1;
+        }
+        bench_and_print(*generated.ToCSRGraph(), generated.name);
+    }
+
+    if (!csv_file.empty()) {
+        std::ofstream out(csv_file);
+        harness.WriteCsv(out);
+    }
+    if (!json_file.empty()) {
+        std::ofstream out(json_file);
+        harness.WriteJson(out);
+    }
+    return 0;
+}
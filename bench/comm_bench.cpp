@@ -0,0 +1,556 @@
+#include <mpi.h>
+#include <omp.h>
+#include <unistd.h>
+
+#include "branch_n_bound_par.hpp"
+#include "csr_graph.hpp"
+#include "graph_generators.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * MPI micro-benchmarks of the communication layer of the solvers, measured without a search
+ * around it, so that a change of the layer (or of --sol_gather_period) is judged on its own:
+ *   - branch: round trip of a node through sendBranch and recvBranch, between rank 0 and the
+ *     last rank, for the root node of every graph;
+ *   - ub: time for an upper bound improved on one rank to be known by all of them through
+ *     gatherRound, with the period and the polling of the solution gatherer, for every --periods
+ *     (and a bare round), every rank sharing --ub_nogoods nogoods per round;
+ *   - termination: time from the last worker going idle to every rank leaving the terminator;
+ *   - steal: steals per second and their latency when 1..p-1 thieves ask rank 0 for work at
+ *     once, through request_work and serveWorkRequests.
+ *
+ * Usage: mpirun -np <p> ./comm_bench [--only=<branch|ub|termination|steal>] [--graphs=<directory>]
+ *        [--filter=<substring>] [--generate=<spec>]... [--repetitions=<n>] [--periods=<s,s>]
+ *        [--ub_trials=<n>] [--ub_nogoods=<n>] [--steal_graph=<file>] [--steal_seconds=<s>] [--seed=<seed>] [--csv=<file>]
+ */
+
+// tags of the benchmark, every benchmark also runs on its own communicator
+#define TAG_BRANCH 1
+#define TAG_IDLE 5
+#define TAG_CLOCK 8
+
+// polling of the solver threads (thread_1_solution_gatherer, thread_0_terminator), gatherRound
+// polls its collectives on its own
+static constexpr auto GATHER_POLL = std::chrono::milliseconds(100);
+static constexpr useconds_t TERMINATOR_POLL_US = 10000;
+
+struct CommResult {
+    std::string benchmark;
+    std::string name;
+    int samples = 0;
+    long bytes = 0;
+    double median_us = 0;
+    double p10_us = 0;
+    double p90_us = 0;
+    double per_second = 0;
+};
+
+static double Percentile(std::vector<double> values, double fraction) {
+    if ( values.empty() ) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, (size_t) (fraction * values.size()))];
+}
+
+static CommResult Summarize(const std::string& benchmark, const std::string& name, const std::vector<double>& seconds) {
+    CommResult result;
+    result.benchmark = benchmark;
+    result.name = name;
+    result.samples = seconds.size();
+    result.median_us = 1e6 * Percentile(seconds, 0.5);
+    result.p10_us = 1e6 * Percentile(seconds, 0.1);
+    result.p90_us = 1e6 * Percentile(seconds, 0.9);
+    return result;
+}
+
+/**
+ * @brief offset of the clock of this rank from the one of rank 0 (MPI_Wtime need not be global),
+ *        from the fastest of a few ping-pongs
+ */
+static double ClockOffset(MPI_Comm comm) {
+    int rank, p;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &p);
+    double offset = 0;
+    for ( int other = 1; other < p; other++ ) {
+        if ( rank == 0 ) {
+            double best_round_trip = 1e9, other_offset = 0;
+            for ( int i = 0; i < 10; i++ ) {
+                double sent = MPI_Wtime(), other_time;
+                MPI_Send(&sent, 1, MPI_DOUBLE, other, TAG_CLOCK, comm);
+                MPI_Recv(&other_time, 1, MPI_DOUBLE, other, TAG_CLOCK, comm, MPI_STATUS_IGNORE);
+                double received = MPI_Wtime();
+                if ( received - sent < best_round_trip ) {
+                    best_round_trip = received - sent;
+                    other_offset = other_time - (sent + received) / 2;
+                }
+            }
+            MPI_Send(&other_offset, 1, MPI_DOUBLE, other, TAG_CLOCK, comm);
+        } else if ( rank == other ) {
+            for ( int i = 0; i < 10; i++ ) {
+                double sent;
+                MPI_Recv(&sent, 1, MPI_DOUBLE, 0, TAG_CLOCK, comm, MPI_STATUS_IGNORE);
+                double now = MPI_Wtime();
+                MPI_Send(&now, 1, MPI_DOUBLE, 0, TAG_CLOCK, comm);
+            }
+            MPI_Recv(&offset, 1, MPI_DOUBLE, 0, TAG_CLOCK, comm, MPI_STATUS_IGNORE);
+        }
+    }
+    return offset;
+}
+
+/**
+ * @brief round trips of the root node of every graph between rank 0 and the last rank
+ */
+static void BenchBranch(const std::vector<std::pair<std::string, std::unique_ptr<CSRGraph>>>& graphs, int repetitions,
+                        MPI_Comm comm, std::vector<CommResult>& results) {
+    int rank, p;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &p);
+    int partner = p - 1;
+    for ( const auto& [name, graph] : graphs ) {
+        std::vector<double> round_trips;
+        Branch root(graph->Clone(), 1, graph->GetNumVertices(), 1);
+        // two untimed round trips first
+        for ( int i = -2; i < repetitions; i++ ) {
+            if ( rank == 0 ) {
+                double start = MPI_Wtime();
+                sendBranch(root, partner, TAG_BRANCH, comm);
+                Branch back = recvBranch(partner, TAG_BRANCH, comm);
+                if ( i >= 0 ) {
+                    round_trips.push_back(MPI_Wtime() - start);
+                }
+            } else if ( rank == partner ) {
+                Branch node = recvBranch(0, TAG_BRANCH, comm);
+                sendBranch(node, 0, TAG_BRANCH, comm);
+            }
+        }
+        if ( rank == 0 ) {
+            CommResult result = Summarize("branch", name, round_trips);
+            result.bytes = root.serialize().size();
+            result.per_second = result.median_us > 0 ? 2 * result.bytes / result.median_us : 0;   // MB/s
+            results.push_back(result);
+        }
+    }
+}
+
+/**
+ * @brief latency of an upper bound improvement with the solution gatherer: every rank runs a
+ *        round of gatherRound once per period (checking the period every GATHER_POLL), one rank
+ *        improves its bound at a random time of the period
+ */
+static void BenchUpperBound(const std::vector<int>& periods, int trials, int repetitions, int nogood_count,
+                            unsigned long seed, MPI_Comm comm, std::vector<CommResult>& results) {
+    int rank, p;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &p);
+    double offset = ClockOffset(comm);
+
+    // nogoods of 4 vertices, flattened as the gatherer shares them
+    std::vector<int> nogoods;
+    for ( int i = 0; i < nogood_count; i++ ) {
+        nogoods.insert(nogoods.end(), {4, i, i + 1, i + 2, i + 3});
+    }
+    std::vector<double> local(GATHER_FIELDS, 0);
+    local[GATHER_NOGOODS] = nogoods.size();
+    std::vector<double> all_fields;
+    std::vector<int> all_nogoods;
+
+    // the floor: one round right away
+    std::vector<double> rounds;
+    for ( int i = -2; i < repetitions; i++ ) {
+        local[GATHER_UB] = 100;
+        MPI_Barrier(comm);
+        double start = MPI_Wtime();
+        gatherRound(local, nogoods, nogood_count > 0, all_fields, all_nogoods, comm);
+        if ( i >= 0 ) {
+            rounds.push_back(MPI_Wtime() - start);
+        }
+    }
+    if ( rank == 0 ) {
+        CommResult result = Summarize("ub", "round nogoods=" + std::to_string(nogood_count), rounds);
+        result.bytes = p * (GATHER_FIELDS * sizeof(double) + nogoods.size() * sizeof(int));
+        results.push_back(result);
+    }
+
+    std::mt19937 random(seed);
+    for ( int period : periods ) {
+        std::vector<double> latencies;
+        for ( int trial = 0; trial < trials; trial++ ) {
+            int improver = trial % p;
+            double delay = std::uniform_real_distribution<double>(0, period)(random);
+            MPI_Bcast(&delay, 1, MPI_DOUBLE, 0, comm);
+
+            MPI_Barrier(comm);
+            double start = MPI_Wtime(), last_gather_time = start, improved_at = 0, known_at = 0;
+            local[GATHER_UB] = 100;
+            while ( known_at == 0 ) {
+                double current_time = MPI_Wtime();
+                if ( rank == improver && local[GATHER_UB] == 100 && current_time - start >= delay ) {
+                    local[GATHER_UB] = 99;
+                    improved_at = current_time;
+                }
+                if ( current_time - last_gather_time < period ) {
+                    std::this_thread::sleep_for(GATHER_POLL);
+                    continue;
+                }
+                gatherRound(local, nogoods, nogood_count > 0, all_fields, all_nogoods, comm);
+                // the same bounds reached every rank, which all stop after this round
+                for ( int i = 0; i < p; i++ ) {
+                    if ( all_fields[GATHER_FIELDS*i + GATHER_UB] == 99 ) {
+                        known_at = MPI_Wtime();
+                    }
+                }
+                last_gather_time = current_time;
+            }
+
+            double times[2] = {improved_at - offset, known_at - offset};
+            std::vector<double> all_times(2 * p);
+            MPI_Gather(times, 2, MPI_DOUBLE, all_times.data(), 2, MPI_DOUBLE, 0, comm);
+            if ( rank == 0 ) {
+                double known_by_all = 0;
+                for ( int i = 0; i < p; i++ ) {
+                    known_by_all = std::max(known_by_all, all_times[2 * i + 1]);
+                }
+                latencies.push_back(known_by_all - all_times[2 * improver]);
+            }
+        }
+        if ( rank == 0 ) {
+            results.push_back(Summarize("ub", "period=" + std::to_string(period), latencies));
+        }
+    }
+}
+
+/**
+ * @brief time from the last idle notification to the end of the terminator loop on every rank:
+ *        the workers go idle at random times, rank 0 collects their notifications and the
+ *        verdict is broadcast every TERMINATOR_POLL_US, as in thread_0_terminator
+ */
+static void BenchTermination(int repetitions, unsigned long seed, MPI_Comm comm, std::vector<CommResult>& results) {
+    int rank, p;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &p);
+    double offset = ClockOffset(comm);
+    std::mt19937 random(seed + rank);
+
+    std::vector<double> latencies;
+    for ( int trial = 0; trial < repetitions; trial++ ) {
+        double idle_at = 0, terminated_at = 0;
+        int idle_delay_us = std::uniform_int_distribution<int>(0, 50000)(random);
+        MPI_Barrier(comm);
+
+        #pragma omp parallel num_threads(2) default(shared)
+        {
+            if ( omp_get_thread_num() == 0 ) {
+                std::vector<int> idle_status(p, 0);
+                int solution_found = 0, timeout_signal = 0;
+                while ( true ) {
+                    if ( rank == 0 ) {
+                        while ( true ) {
+                            int flag_idle = 0, worker_idle_status = 0;
+                            MPI_Status status_idle;
+                            MPI_Iprobe(MPI_ANY_SOURCE, TAG_IDLE, comm, &flag_idle, &status_idle);
+                            if ( !flag_idle ) break;
+                            MPI_Recv(&worker_idle_status, 1, MPI_INT, status_idle.MPI_SOURCE, TAG_IDLE, comm,
+                                     MPI_STATUS_IGNORE);
+                            idle_status[status_idle.MPI_SOURCE] = worker_idle_status;
+                        }
+                        solution_found = idleGroup(idle_status, {}) != -1;
+                    }
+                    MPI_Bcast(&solution_found, 1, MPI_INT, 0, comm);
+                    MPI_Bcast(&timeout_signal, 1, MPI_INT, 0, comm);
+                    if ( solution_found ) {
+                        terminated_at = MPI_Wtime();
+                        break;
+                    }
+                    usleep(TERMINATOR_POLL_US);
+                }
+            } else {
+                usleep(idle_delay_us);
+                int idle_status = 1;
+                idle_at = MPI_Wtime();
+                MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, comm);
+            }
+        }
+
+        double times[2] = {idle_at - offset, terminated_at - offset};
+        std::vector<double> all_times(2 * p);
+        MPI_Gather(times, 2, MPI_DOUBLE, all_times.data(), 2, MPI_DOUBLE, 0, comm);
+        if ( rank == 0 ) {
+            double last_idle = 0, last_terminated = 0;
+            for ( int i = 0; i < p; i++ ) {
+                last_idle = std::max(last_idle, all_times[2 * i]);
+                last_terminated = std::max(last_terminated, all_times[2 * i + 1]);
+            }
+            latencies.push_back(last_terminated - last_idle);
+        }
+    }
+    if ( rank == 0 ) {
+        results.push_back(Summarize("termination", "ranks=" + std::to_string(p), latencies));
+    }
+}
+
+/**
+ * @brief steals from rank 0 by 1..p-1 thieves at once for `seconds`: rank 0 answers with
+ *        serveWorkRequests, the thieves call request_work with all the weight on rank 0
+ */
+static void BenchSteal(const CSRGraph& graph, const std::string& name, double seconds, MPI_Comm comm,
+                       std::vector<CommResult>& results) {
+    int rank, p;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &p);
+    std::vector<double> weights(p, 0);
+    weights[0] = 1;
+
+    for ( int thieves = 1; thieves < p; thieves++ ) {
+        // the employer answers every 10 ms, the queue cannot be emptied in the time given
+        BranchQueue queue{BranchOrder{}};
+        std::mutex queue_mutex;
+        if ( rank == 0 ) {
+            for ( int i = 0; i < 150 * seconds + 2; i++ ) {
+                queue.push(Branch(graph.Clone(), 1, graph.GetNumVertices(), 1));
+            }
+        }
+        std::vector<double> latencies;
+        long bytes = Branch(graph.Clone(), 1, graph.GetNumVertices(), 1).serialize().size();
+
+        MPI_Barrier(comm);
+        double window = 0;
+        #pragma omp parallel num_threads(2) default(shared)
+        {
+            if ( omp_get_thread_num() == 1 ) {
+                if ( rank == 0 ) {
+                    serveWorkRequests(queue_mutex, queue, comm);
+                }
+            } else {
+                if ( rank >= 1 && rank <= thieves ) {
+                    BranchQueue stolen{BranchOrder{}};
+                    std::mutex stolen_mutex;
+                    Branch current;
+                    double start = MPI_Wtime();
+                    while ( MPI_Wtime() - start < seconds ) {
+                        double asked = MPI_Wtime();
+                        if ( request_work(rank, p, stolen, stolen_mutex, current, comm, weights) ) {
+                            latencies.push_back(MPI_Wtime() - asked);
+                            stolen.pop();
+                        }
+                    }
+                    window = MPI_Wtime() - start;
+                }
+                // every request was answered, the employer can stop
+                MPI_Barrier(comm);
+                terminate_flag.store(true);
+            }
+        }
+        terminate_flag.store(false);
+
+        int count = latencies.size();
+        std::vector<int> counts(p);
+        MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm);
+        std::vector<int> displacements(p, 0);
+        for ( int i = 1; i < p; i++ ) {
+            displacements[i] = displacements[i - 1] + counts[i - 1];
+        }
+        std::vector<double> all_latencies(rank == 0 ? displacements[p - 1] + counts[p - 1] : 0);
+        MPI_Gatherv(latencies.data(), count, MPI_DOUBLE, all_latencies.data(), counts.data(), displacements.data(),
+                    MPI_DOUBLE, 0, comm);
+        double longest_window = 0;
+        MPI_Reduce(&window, &longest_window, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+        if ( rank == 0 ) {
+            CommResult result = Summarize("steal", name + " thieves=" + std::to_string(thieves), all_latencies);
+            result.bytes = bytes;
+            result.per_second = longest_window > 0 ? all_latencies.size() / longest_window : 0;
+            results.push_back(result);
+        }
+    }
+}
+
+static std::vector<int> ParseList(const std::string& value) {
+    std::vector<int> list;
+    std::stringstream items(value);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        if (!item.empty()) list.push_back(std::stoi(item));
+    }
+    return list;
+}
+
+int main(int argc, char** argv) {
+    std::string only;
+    std::string graphs_directory = "../src/scripts/graphs_instances";
+    std::string filter;
+    std::vector<std::string> generate;
+    bool graphs_given = false;
+    int repetitions = 20;
+    std::vector<int> periods = {1, 2};
+    int ub_trials = 5;
+    int ub_nogoods = 0;
+    std::string steal_graph = "le450_15b.col";
+    double steal_seconds = 2.0;
+    unsigned long seed = 1;
+    std::string csv_file;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t pos = arg.find('=');
+        if (pos == std::string::npos) {
+            std::cerr << "Error: Invalid argument format " << arg << "\n";
+            return 1;
+        }
+        std::string key = arg.substr(0, pos);
+        std::string value = arg.substr(pos + 1);
+        try {
+            if (key == "--only") {
+                only = value;
+            } else if (key == "--graphs") {
+                graphs_directory = value;
+                graphs_given = true;
+            } else if (key == "--filter") {
+                filter = value;
+            } else if (key == "--generate") {
+                generate.push_back(value);
+            } else if (key == "--repetitions") {
+                repetitions = std::max(1, std::stoi(value));
+            } else if (key == "--periods") {
+                periods = ParseList(value);
+            } else if (key == "--ub_trials") {
+                ub_trials = std::max(1, std::stoi(value));
+            } else if (key == "--ub_nogoods") {
+                ub_nogoods = std::max(0, std::stoi(value));
+            } else if (key == "--steal_graph") {
+                steal_graph = value;
+            } else if (key == "--steal_seconds") {
+                steal_seconds = std::stod(value);
+            } else if (key == "--seed") {
+                seed = std::stoul(value);
+            } else if (key == "--csv") {
+                csv_file = value;
+            } else {
+                std::cerr << "Error: Unknown argument " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Invalid value for " << key << "\n";
+            return 1;
+        }
+    }
+    if (!only.empty() && only != "branch" && only != "ub" && only != "termination" && only != "steal") {
+        std::cerr << "Error: Invalid value for --only\n";
+        return 1;
+    }
+
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    if (provided < MPI_THREAD_MULTIPLE) {
+        std::cerr << "MPI does not support full multithreading!" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    int rank, p;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+    if (p < 2) {
+        if (rank == 0) std::cerr << "Error: comm_bench needs at least 2 ranks\n";
+        MPI_Finalize();
+        return 1;
+    }
+
+    // every rank reads the graphs, so that every rank fails on the same ones
+    std::vector<std::pair<std::string, std::unique_ptr<CSRGraph>>> graphs;
+    std::vector<std::filesystem::path> graph_files;
+    if (graphs_given || generate.empty()) {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(graphs_directory, error)) {
+            if (entry.path().extension() == ".col" && entry.path().filename().string().find(filter) != std::string::npos) {
+                graph_files.push_back(entry.path());
+            }
+        }
+        std::sort(graph_files.begin(), graph_files.end());
+    }
+    for (const std::filesystem::path& file : graph_files) {
+        Dimacs dimacs;
+        std::unique_ptr<CSRGraph> graph(CSRGraph::LoadFromDimacs(file.string(), dimacs));
+        if (graph) {
+            graphs.emplace_back(file.filename().string(), std::move(graph));
+        }
+    }
+    for (const std::string& spec : generate) {
+        GeneratedGraph generated;
+        std::string error;
+        if (!GraphGenerator::FromSpec(spec, generated, error)) {
+            if (rank == 0) std::cerr << "Error: " << error << "\n";
+            MPI_Finalize();
+            return 1;
+        }
+        graphs.emplace_back(generated.name, generated.ToCSRGraph());
+    }
+
+    std::vector<CommResult> results;
+    MPI_Comm comm;
+    auto run = [&only](const std::string& benchmark) { return only.empty() || only == benchmark; };
+    if (run("branch")) {
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        BenchBranch(graphs, repetitions, comm, results);
+        MPI_Comm_free(&comm);
+    }
+    if (run("ub")) {
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        BenchUpperBound(periods, ub_trials, repetitions, ub_nogoods, seed, comm, results);
+        MPI_Comm_free(&comm);
+    }
+    if (run("termination")) {
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        BenchTermination(repetitions, seed, comm, results);
+        MPI_Comm_free(&comm);
+    }
+    if (run("steal")) {
+        Dimacs dimacs;
+        std::unique_ptr<CSRGraph> graph(CSRGraph::LoadFromDimacs(graphs_directory + "/" + steal_graph, dimacs));
+        if (!graph) {
+            if (rank == 0) std::cerr << "Error: " << dimacs.getError() << ", " << steal_graph << "\n";
+            MPI_Finalize();
+            return 1;
+        }
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+        BenchSteal(*graph, steal_graph, steal_seconds, comm, results);
+        MPI_Comm_free(&comm);
+    }
+
+    if (rank == 0) {
+        std::cout << std::left << std::setw(13) << "benchmark" << std::setw(36) << "case" << std::right << std::setw(8)
+                  << "samples" << std::setw(10) << "bytes" << std::setw(13) << "median_us" << std::setw(13) << "p90_us"
+                  << std::setw(12) << "rate" << std::endl;
+        for (const CommResult& r : results) {
+            std::cout << std::left << std::setw(13) << r.benchmark << std::setw(36) << r.name << std::right
+                      << std::setw(8) << r.samples << std::setw(10) << r.bytes << std::fixed << std::setprecision(1)
+                      << std::setw(13) << r.median_us << std::setw(13) << r.p90_us << std::setw(12) << r.per_second
+                      << std::defaultfloat << std::endl;
+        }
+        std::cout << "rate: MB/s of a branch round trip, steals/s over all the thieves; bytes: gathered by a rank in"
+                  << " a round of ub" << std::endl;
+
+        if (!csv_file.empty()) {
+            std::ofstream out(csv_file);
+            out << "benchmark,case,ranks,samples,bytes,median_us,p10_us,p90_us,rate\n";
+            for (const CommResult& r : results) {
+                out << r.benchmark << "," << r.name << "," << p << "," << r.samples << "," << r.bytes << ","
+                    << r.median_us << "," << r.p10_us << "," << r.p90_us << "," << r.per_second << "\n";
+            }
+        }
+    }
+    MPI_Finalize();
+    return 0;
+}
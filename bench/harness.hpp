@@ -0,0 +1,127 @@
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief timings of a kernel on a graph
+ */
+struct BenchResult {
+    std::string kernel;
+    std::string graph;
+    int repetitions = 0;
+    long ops_per_repetition = 1;    // operations timed together in a repetition
+    double min_ns = 0;              // per operation
+    double median_ns = 0;
+    double p10_ns = 0;
+    double p90_ns = 0;
+
+    double OpsPerSecond() const { return median_ns > 0 ? 1e9 / median_ns : 0; }
+};
+
+/**
+ * @brief minimal micro-benchmark harness: warm-up, repetitions and their percentiles
+ *
+ * @details a repetition first runs the untimed setup, which builds the state the kernel
+ *          consumes (e.g. a fresh clone of the graph for a kernel modifying it), then times
+ *          the kernel on it. Kernels too short to be timed alone run a batch of operations
+ *          per repetition, the times are then reported per operation. <br>
+ *          Slow kernels stop repeating once they took the time budget, after at least
+ *          MIN_REPETITIONS repetitions.
+ */
+class BenchHarness {
+    public:
+        static constexpr int MIN_REPETITIONS = 3;
+
+        /**
+         * @param warmup untimed runs of a kernel before its repetitions
+         * @param repetitions timed runs of a kernel
+         * @param budget_seconds time after which a kernel stops repeating
+         */
+        BenchHarness(int warmup, int repetitions, double budget_seconds)
+        : _warmup{warmup}, _repetitions{repetitions}, _budget_seconds{budget_seconds} {}
+
+        /**
+         * @param setup returns the state of a repetition, not timed
+         * @param kernel called on the state, timed
+         * @param ops operations done by a call of the kernel
+         */
+        template <typename Setup, typename Kernel>
+        BenchResult Run(const std::string& kernel_name, const std::string& graph_name, Setup setup, Kernel kernel,
+                        long ops = 1) {
+            auto budget_end = std::chrono::steady_clock::now() + std::chrono::duration<double>(_budget_seconds);
+            for ( int i = 0; i < _warmup && std::chrono::steady_clock::now() < budget_end; i++ ) {
+                auto state = setup();
+                kernel(state);
+            }
+
+            std::vector<double> times;
+            times.reserve(_repetitions);
+            for ( int i = 0; i < _repetitions; i++ ) {
+                auto state = setup();
+                auto start = std::chrono::steady_clock::now();
+                kernel(state);
+                auto end = std::chrono::steady_clock::now();
+                times.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+                if ( (int) times.size() >= MIN_REPETITIONS && end > budget_end ) {
+                    break;
+                }
+            }
+            std::sort(times.begin(), times.end());
+
+            BenchResult result;
+            result.kernel = kernel_name;
+            result.graph = graph_name;
+            result.repetitions = times.size();
+            result.ops_per_repetition = ops;
+            result.min_ns = times.front();
+            result.median_ns = Percentile(times, 0.5);
+            result.p10_ns = Percentile(times, 0.1);
+            result.p90_ns = Percentile(times, 0.9);
+            _results.push_back(result);
+            return result;
+        }
+
+        const std::vector<BenchResult>& Results() const { return _results; }
+
+        void WriteCsv(std::ostream& out) const {
+            out << "kernel,graph,repetitions,ops_per_repetition,min_ns,p10_ns,median_ns,p90_ns,ops_per_sec\n";
+            out << std::setprecision(6);
+            for ( const BenchResult& r : _results ) {
+                out << r.kernel << "," << r.graph << "," << r.repetitions << "," << r.ops_per_repetition << ","
+                    << r.min_ns << "," << r.p10_ns << "," << r.median_ns << "," << r.p90_ns << ","
+                    << r.OpsPerSecond() << "\n";
+            }
+        }
+
+        void WriteJson(std::ostream& out) const {
+            out << "{\n  \"results\": [";
+            out << std::setprecision(6);
+            for ( size_t i = 0; i < _results.size(); i++ ) {
+                const BenchResult& r = _results[i];
+                out << (i == 0 ? "\n" : ",\n") << "    {\"kernel\": \"" << r.kernel << "\", \"graph\": \"" << r.graph
+                    << "\", \"repetitions\": " << r.repetitions << ", \"ops_per_repetition\": " << r.ops_per_repetition
+                    << ", \"min_ns\": " << r.min_ns << ", \"p10_ns\": " << r.p10_ns << ", \"median_ns\": " << r.median_ns
+                    << ", \"p90_ns\": " << r.p90_ns << ", \"ops_per_sec\": " << r.OpsPerSecond() << "}";
+            }
+            out << "\n  ]\n}\n";
+        }
+
+    private:
+        int _warmup;
+        int _repetitions;
+        double _budget_seconds;
+        std::vector<BenchResult> _results;
+
+        static double Percentile(const std::vector<double>& sorted, double fraction) {
+            size_t index = std::min(sorted.size() - 1, (size_t) (fraction * sorted.size()));
+            return sorted[index];
+        }
+};
+
+#endif // BENCH_HARNESS_HPP
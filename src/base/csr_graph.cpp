@@ -1,15 +1,50 @@
 #include "csr_graph.hpp"
+#include "solver_stats.hpp"
 
 #include <cmath>
 #include <cstring>
+#include <algorithm>
 
 CSRGraph* CSRGraph::LoadFromDimacs(const std::string& file_name) {
 	Dimacs dimacs;
-	dimacs.load(file_name.c_str());
+	CSRGraph* graph = LoadFromDimacs(file_name, dimacs);
+	if ( graph == nullptr ) {
+		// an unreadable file still yields an (empty) graph
+		graph = new CSRGraph(dimacs);
+	}
+	return graph;
+}
+
+CSRGraph* CSRGraph::LoadFromDimacs(const std::string& file_name, Dimacs& dimacs) {
+	// first pass: only the number of vertices and the degrees are read
+	dimacs.keepEdges(false);
+	if ( !dimacs.load(file_name.c_str()) ) {
+		return nullptr;
+	}
+
+	// second pass: edges go directly into the neighbour lists reserved by the constructor
 	CSRGraph* graph = new CSRGraph(dimacs);
+	dimacs.streamEdges(file_name.c_str(), [graph](int v, int w) { 
+		graph->InsertLoadedEdge(v, w); 
+	});
+	graph->FinishLoading();
+
 	return graph;
 }
 
+CSRGraph* CSRGraph::FromEdges(int num_vertices, const std::vector<std::pair<int, int>>& edges) {
+	Dimacs dimacs;
+	dimacs.numVertices = num_vertices;
+	dimacs.numEdges = edges.size();
+	dimacs.degrees.assign(num_vertices + 1, 0);
+	for ( const std::pair<int, int>& edge : edges ) {
+		dimacs.degrees[edge.first]++;
+		dimacs.degrees[edge.second]++;
+	}
+	dimacs.edges = edges;
+	return new CSRGraph(dimacs);
+}
+
 CSRGraph::CSRGraph()
     : _vertices(0),
       _degrees(1),
@@ -247,18 +282,19 @@ void CSRGraph::RemoveVertex(int v) {
 	// removing the vertex
 	_vertices.erase(std::find(_vertices.begin(), _vertices.end(), v));
 
-	// removing the vertices
-	_nEdges -= _edges[v].size();
-	_edges[v].clear();
-	for (int vertex : _vertices) {
+	// removing the edges, only the neighbours of v have to be updated
+	for (int neighbour : _edges[v]) {
+		if (neighbour == v) continue;
 		auto it =
-		    std::find(_edges[vertex].begin(), _edges[vertex].end(), v);
-		if (it != _edges[vertex].end()) {
-			std::swap(*it, _edges[vertex].back());
-			_edges[vertex].pop_back();
-			_degrees[vertex]--;
+		    std::find(_edges[neighbour].begin(), _edges[neighbour].end(), v);
+		if (it != _edges[neighbour].end()) {
+			// erase keeps the order of the row (see SortAdjacency)
+			_edges[neighbour].erase(it);
+			_degrees[neighbour]--;
 		}
 	}
+	_nEdges -= _edges[v].size();
+	_edges[v].clear();
 
 	_degrees[v] = 0;
 }
@@ -524,6 +560,12 @@ std::vector<unsigned short> CSRGraph::GetColoring() const {
 	return colors;
 }
 
+void CSRGraph::SortAdjacency() {
+	for (int vertex : _vertices) {
+		std::sort(_edges[vertex].begin(), _edges[vertex].end());
+	}
+}
+
 std::vector<unsigned short> CSRGraph::GetFullColoring() const {
 	return _coloring;
 }
@@ -533,11 +575,44 @@ unsigned short CSRGraph::GetColor(int vertex) const {
 }
 
 std::unique_ptr<Graph> CSRGraph::Clone() const {
+	PhaseTimer timer(StatPhase::CLONE);
+	SolverStats::Count(StatCounter::CLONES);
 	std::unique_ptr<CSRGraph> graph = std::make_unique<CSRGraph>(*this);
 
 	return std::move(graph);
 }
 
+std::unique_ptr<CSRGraph> CSRGraph::InducedSubgraph(const std::vector<int>& vertices) const {
+	auto subgraph = std::make_unique<CSRGraph>();
+	size_t size = _edges.size();
+	subgraph->_vertices = vertices;
+	subgraph->_edges.assign(size, {});
+	subgraph->_degrees.assign(size, 0);
+	subgraph->_coloring.assign(size, 0);
+	subgraph->_merged_vertices.assign(size, {});
+	subgraph->_max_vertex = _max_vertex;
+
+	std::vector<char> inside(size, 0);
+	for (int vertex : vertices) {
+		inside[vertex] = 1;
+	}
+
+	size_t num_entries = 0;
+	for (int vertex : vertices) {
+		std::vector<int>& row = subgraph->_edges[vertex];
+		for (int neighbour : _edges[vertex]) {
+			if (inside[neighbour]) {
+				row.push_back(neighbour);
+			}
+		}
+		subgraph->_degrees[vertex] = row.size();
+		num_entries += row.size();
+	}
+	subgraph->_nEdges = num_entries / 2;
+
+	return subgraph;
+}
+
 // ------------------------ PROTECTED --------------------------
 CSRGraph::CSRGraph(const Dimacs& dimacs_graph) 
 : _vertices(dimacs_graph.numVertices), 
@@ -554,25 +629,38 @@ CSRGraph::CSRGraph(const Dimacs& dimacs_graph)
         _edges[vertex].reserve(dimacs_graph.degrees[vertex]);
     }
 
+    // empty when the loader was told not to keep the edges (see LoadFromDimacs)
     for ( const std::pair<int, int>& edge : dimacs_graph.edges ) {
-        // skipping already inserted edges
-        if ( std::find(_edges[edge.first].begin(), 
-                       _edges[edge.first].end(), 
-                        edge.second) != _edges[edge.first].end() ) {
-            continue;
-        }
-        if ( edge.first != edge.second ) {
-            _edges[edge.first].push_back(edge.second);
-            _edges[edge.second].push_back(edge.first);
-        } else if ( edge.first == edge.second ) {
-            _edges[edge.first].push_back(edge.second);
-        } 
+        InsertLoadedEdge(edge.first, edge.second);
+    }
+
+    FinishLoading();
+}
+
+void CSRGraph::InsertLoadedEdge(int v, int w)
+{
+    // skipping already inserted edges
+    if ( std::find(_edges[v].begin(), _edges[v].end(), w) != _edges[v].end() ) {
+        return;
+    }
+    if ( v != w ) {
+        _edges[v].push_back(w);
+        _edges[w].push_back(v);
+    } else {
+        _edges[v].push_back(w);
     }
+}
 
+void CSRGraph::FinishLoading()
+{
     _degrees.clear();
     _degrees.resize(_vertices.size()+1);
     for (int i = 0; i < _vertices.size(); i++) {
-        _degrees[_vertices[i]] = _edges[_vertices[i]].size();
+        std::vector<int>& neighbours = _edges[_vertices[i]];
+        // degrees were counted with duplicated edges: giving back the unused capacity
+        if ( neighbours.capacity() > neighbours.size() ) {
+            neighbours.shrink_to_fit();
+        }
+        _degrees[_vertices[i]] = neighbours.size();
     }
-
 }
@@ -20,6 +20,21 @@
 class CSRGraph : public Graph {
     public:
         static CSRGraph* LoadFromDimacs(const std::string& file_name);
+        /**
+         * @brief loads the graph in two passes: the first one only counts the degrees
+         *        (through `dimacs`), the second one streams the edges straight into the
+         *        preallocated neighbour lists. Peak memory is thus the one of the final graph
+         * 
+         * @param file_name DIMACS file to load
+         * @param dimacs loader used for the first pass; on failure its getError() explains why
+         * @return the loaded graph, nullptr if the file could not be parsed
+         */
+        static CSRGraph* LoadFromDimacs(const std::string& file_name, Dimacs& dimacs);
+        /**
+         * @brief builds the graph of vertices 1..num_vertices from an edge list, as if it was
+         *        loaded from a DIMACS file (e.g. for the synthetic graphs of GraphGenerator)
+         */
+        static CSRGraph* FromEdges(int num_vertices, const std::vector<std::pair<int, int>>& edges);
 
         CSRGraph();
         CSRGraph(const CSRGraph& other)=default;
@@ -48,6 +63,18 @@ class CSRGraph : public Graph {
         // --------------------- GETTERS ----------------------
         virtual void GetNeighbours(int vertex, std::vector<int> &result) const override;
         virtual void GetNeighbours(int vertex, std::set<int> &result) const override;
+        /**
+         * @brief gives direct (read-only) access to the neighbour list of `vertex`,
+         *        without copying it
+         * @warning the reference is invalidated by any modifier of the graph
+         */
+        const std::vector<int>& GetAdjacency(int vertex) const { return _edges[vertex]; }
+        /**
+         * @brief sorts every neighbour list, so that GetAdjacency can be used with set 
+         *        algorithms (e.g. std::includes). RemoveVertex keeps the lists sorted, 
+         *        the other modifiers do not
+         */
+        void SortAdjacency();
 
         virtual bool HasEdge(int v, int w) const override;
 
@@ -80,12 +107,30 @@ class CSRGraph : public Graph {
 
 
         virtual std::unique_ptr<Graph> Clone() const override;
+        /**
+         * @brief builds the subgraph induced by `vertices`, keeping their labels
+         *        (so that a coloring of the subgraph is also indexed like this graph)
+         * 
+         * @param vertices vertices of this graph to keep
+         * @return the induced subgraph, uncolored
+         */
+        std::unique_ptr<CSRGraph> InducedSubgraph(const std::vector<int>& vertices) const;
 
         virtual ~CSRGraph() = default;
 
     private:
         CSRGraph(const Dimacs& dimacs_graph);
 
+        /**
+         * @brief inserts an edge read from file, skipping duplicates
+         * @warning only used while loading, since history and degrees are not updated
+         */
+        void InsertLoadedEdge(int v, int w);
+        /**
+         * @brief computes degrees and releases the capacity left by skipped duplicates
+         */
+        void FinishLoading();
+
         /**
          * @brief number of edges in the graph
          * @details needed since _edges contains duplicated vertices (but it is not true
@@ -5,12 +5,13 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
 
 
 const bool ENABLE_DEBUG_OUT_READING = false;
 
 
-Dimacs::Dimacs() : numVertices(0), adjacencyMatrixSizeLimit(1000000000 /* 1GB */) {
+Dimacs::Dimacs() : numVertices(0), numEdges(0), adjacencyMatrixSizeLimit(1000000000 /* 1GB */) {
 }
 
 Dimacs::~Dimacs() {
@@ -52,6 +53,25 @@ bool Dimacs::load(const char* fname) {
 	return loop(&Dimacs::parseLine);
 }
 
+bool Dimacs::streamEdges(const char* fname, const std::function<void(int, int)>& visit) const {
+    std::ifstream file(fname);
+    if (!file) {
+        return false;
+    }
+
+    // the file was already validated by load(), so lines are parsed without checks
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() > 0 && line[0] == 'e') {
+            char* end;
+            unsigned long v1 = std::strtoul(line.c_str() + 1, &end, 10);
+            unsigned long v2 = std::strtoul(end, nullptr, 10);
+            visit(static_cast<int>(v1), static_cast<int>(v2));
+        }
+    }
+    return true;
+}
+
 
 std::vector<std::vector<char> > Dimacs::getAdjacencyMatrix() const {
     if (getMaxVertexIndex() * getMaxVertexIndex() > adjacencyMatrixSizeLimit)
@@ -70,26 +90,11 @@ std::vector<std::vector<char> > Dimacs::getAdjacencyMatrix() const {
     return matrix;
 }
 
-/*
 void Dimacs::calculateGraphStats(int& maxDegree, int& minDegree, std::vector<float>& degreeHistogram) {
-    auto degCopy = degrees;
-    std::sort(degCopy.begin(), degCopy.end());
-    size_t n = degCopy.size();
-    size_t m = degreeHistogram.size();
-    int cnt = 0;
-    size_t di = n-1;
-    for (size_t i = 0; i < m; ++i) {
-        float bound = (m-i-1)*(float)n / m;
-        while (degCopy[di] > bound && di > 0) {
-            --di;
-            ++cnt;
-        }
-        degreeHistogram[i] = cnt / (float)n;
-        cnt = 0;
-    }
-    maxDegree = degCopy.front();
-    minDegree = degCopy.back();
-}*/
+    // vertices are numbered from 1, degrees[0] is not a vertex
+    std::vector<int> vertexDegrees(degrees.size() > 1 ? degrees.begin() + 1 : degrees.end(), degrees.end());
+    degreeStats(vertexDegrees, maxDegree, minDegree, degreeHistogram);
+}
 
 bool Dimacs::parseProblemLine(std::istringstream& ss, std::string& line) {
 	if (line[0] == 'p') { // problem line
@@ -106,7 +111,8 @@ bool Dimacs::parseProblemLine(std::istringstream& ss, std::string& line) {
 		ss >> numVertices >> nEdges;
         // since DIMACS counts from 1 on, the storage should be larger by 1, since 0 is included implicitly
         maxVertexIndex = numVertices+1;
-		edges.reserve(nEdges);
+		if (storeEdges)
+			edges.reserve(nEdges);
 		degrees.resize(maxVertexIndex, 0);
         if (ENABLE_DEBUG_OUT_READING)
             std::cout << "problem specs: num edges = " << nEdges << ", max vertex index = " << maxVertexIndex << "\n";
@@ -129,7 +135,9 @@ bool Dimacs::parseSpecsLine(std::istringstream& ss, std::string& line) {
 			errorFlag = true;
 			return false;
 		}
-		edges.push_back(std::make_pair(v1, v2));
+		if (storeEdges)
+			edges.push_back(std::make_pair(v1, v2));
+		numEdges++;
 		degrees[v1]++;
 		degrees[v2]++;
 	} 
@@ -2,6 +2,7 @@
 #define DIMACS_H
 
 
+#include <functional>
 #include <utility>
 #include <vector>
 #include <string>
@@ -18,23 +19,38 @@ protected: public:
     
     std::vector<int> degrees;
     unsigned int numVertices;
+    unsigned int numEdges;
     unsigned long maxVertexIndex;
     unsigned long long int adjacencyMatrixSizeLimit; // TODO: set this from commandline
 	std::string error;
 	bool errorFlag;
 	bool edgeNotSpecified = false;
+	bool storeEdges = true;
     
 public:
     Dimacs();
     ~Dimacs();
     
     void allowNotSpecifiedEdge(bool allow=true) {edgeNotSpecified = allow;}
+    /**
+     * @brief whether load() keeps the edge list in memory. When disabled only the
+     *        vertex count and the degrees are collected, so that the edges can be
+     *        streamed afterwards with streamEdges() into a preallocated structure
+     */
+    void keepEdges(bool keep=true) {storeEdges = keep;}
     bool load(const char* fname) override;
+    /**
+     * @brief reads again the edge lines of an already loaded file, calling `visit`
+     *        for each of them without storing anything
+     * @return false if the file cannot be opened
+     */
+    bool streamEdges(const char* fname, const std::function<void(int, int)>& visit) const;
     unsigned int getNumVertices() const override        {return numVertices;}
     unsigned int getMaxVertexIndex() const override    {return maxVertexIndex;}
-    unsigned int getNumEdges() const override           {return edges.size();}
+    unsigned int getNumEdges() const override           {return numEdges;}
     std::vector<std::vector<char> > getAdjacencyMatrix() const override;
     std::vector<int> getDegrees() const override        {return degrees;}
+    void calculateGraphStats(int& maxDegree, int& minDegree, std::vector<float>& degreeHistogram) override;
 	const std::string& getError() const override        {return error;}
     bool verticesAreMappedFrom1based() const override   {return false;}
 	
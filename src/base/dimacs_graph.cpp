@@ -1,4 +1,5 @@
 #include "dimacs_graph.hpp"
+#include "solver_stats.hpp"
 
 #include <iostream>
 #include <algorithm>
@@ -233,6 +234,8 @@ int DimacsGraph::GetVertexWithMaxDegree() const {
 
 std::unique_ptr<Graph> DimacsGraph::Clone() const
 {
+    PhaseTimer timer(StatPhase::CLONE);
+    SolverStats::Count(StatCounter::CLONES);
     std::unique_ptr<DimacsGraph> clone = std::make_unique<DimacsGraph>(*this);
 
     return std::move(clone);
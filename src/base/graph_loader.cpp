@@ -7,21 +7,29 @@
 
 
 void GraphLoader::calculateGraphStats(int& maxDegree, int& minDegree, std::vector<float>& degreeHistogram) {
-    auto degCopy = getDegrees();
-    std::sort(degCopy.begin(), degCopy.end());
-    size_t n = degCopy.size();
+    degreeStats(getDegrees(), maxDegree, minDegree, degreeHistogram);
+}
+
+void GraphLoader::degreeStats(std::vector<int> degrees, int& maxDegree, int& minDegree, std::vector<float>& degreeHistogram) {
+    std::fill(degreeHistogram.begin(), degreeHistogram.end(), 0.0f);
+    if (degrees.empty()) {
+        maxDegree = minDegree = 0;
+        return;
+    }
+    std::sort(degrees.begin(), degrees.end());
+    size_t n = degrees.size();
     size_t m = degreeHistogram.size();
-    int cnt = 0;
-    size_t di = n-1;
+    // degrees[di, n) are already counted, the lowest band takes all the remaining ones
+    size_t di = n;
     for (size_t i = 0; i < m; ++i) {
         float bound = (m-i-1)*(float)n / m;
-        while (degCopy[di] > bound && di > 0) {
+        int cnt = 0;
+        while (di > 0 && (i == m-1 || degrees[di-1] > bound)) {
             --di;
             ++cnt;
         }
         degreeHistogram[i] = cnt / (float)n;
-        cnt = 0;
     }
-    maxDegree = degCopy.front();
-    minDegree = degCopy.back();
+    maxDegree = degrees.back();
+    minDegree = degrees.front();
 }
@@ -66,11 +66,13 @@ public:
     
     /**
      * @brief Calculate some graph statistics: min and max degree, and histogram of degrees.
-     * @param maxdegree the output variable - minimal degree of a vertex in the graph
-     * @param minDegree the output variable - maximal degree of a vertex in the graph
-     * @param degreeHistogram - histogram of degrees, one entry for each degree between min and max (inclusive).
+     * @param maxDegree the output variable - maximal degree of a vertex in the graph
+     * @param minDegree the output variable - minimal degree of a vertex in the graph
+     * @param degreeHistogram - histogram of degrees, its size (set by the caller) is the number of bands: 
+     * entry i is the fraction of the vertices whose degree is in the i-th band of [0, number of vertices], 
+     * from the highest band to the lowest one.
      */
-    virtual void calculateGraphStats(int& maxdegree, int& minDegree, std::vector<float>& degreeHistogram);
+    virtual void calculateGraphStats(int& maxDegree, int& minDegree, std::vector<float>& degreeHistogram);
     
     /**
      * @brief Get the last error message (load produces error messages)
@@ -83,6 +85,12 @@ public:
      * @return true for 1-based indexing converted to 0-based indexing
      */
     virtual bool verticesAreMappedFrom1based() const = 0;
+
+protected:
+    /**
+     * @brief Statistics of calculateGraphStats computed from the degree of each vertex.
+     */
+    static void degreeStats(std::vector<int> degrees, int& maxDegree, int& minDegree, std::vector<float>& degreeHistogram);
 };
 
 
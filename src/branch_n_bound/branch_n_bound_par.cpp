@@ -10,9 +10,13 @@
 #define TAG_WORK_STEALING 6
 #define TAG_TIMEOUT_SOLUTION 7
 
+// values of solution_found broadcast by the terminator
+#define FOUND_EXPECTED 1	// a branch reached the expected chromatic number
+#define FOUND_ALL_IDLE 2	// every process of a group ran out of work, the incumbents have to be gathered
+#define FOUND_BOUND 3		// the best coloring meets the lower bound, the incumbents have to be gathered
+
 std::atomic<bool> terminate_flag = false;
 std::mutex queue_mutex;	 // avoid concurrent access to the queue
-std::mutex log_mutex;
 
 std::mutex branching_mutex;
 std::mutex task_mutex;
@@ -34,7 +38,9 @@ void BranchNBoundPar::ColorInitialGraph(Graph &graph_to_color, const Branch &opt
 {
 	std::vector<int> vertices 						  = optimal_branch.g->GetVertices();
 	std::vector<unsigned short> optimal_full_coloring = optimal_branch.g->GetFullColoring();
-	std::vector<unsigned short> full_coloring(graph_to_color.GetNumVertices()+1);
+	// vertices are labels, which may exceed the number of vertices (e.g. after removals)
+	std::vector<unsigned short> full_coloring(std::max<size_t>(graph_to_color.GetHighestVertex()+1, 
+															   optimal_full_coloring.size()));
 	for ( int vertex : vertices ) {
 		// coloring the vertex...
 		full_coloring[vertex] = optimal_full_coloring[vertex];
@@ -48,6 +54,72 @@ void BranchNBoundPar::ColorInitialGraph(Graph &graph_to_color, const Branch &opt
 	graph_to_color.SetFullColoring(full_coloring);
 }
 
+GraphPtr BranchNBoundPar::PeelToTarget(Graph &g, std::vector<int> &peeled, unsigned short &ub)
+{
+	GraphPtr core = g.Clone();
+	peeled = PeelKCore(*core, _best_ub.load() - 1);
+	if ( core->GetNumVertices() == 0 ) {
+		std::vector<unsigned short> full_coloring(g.GetHighestVertex() + 1, 0);
+		ub = ExtendCoreColoring(g, peeled, full_coloring);
+		g.SetFullColoring(full_coloring);
+	}
+	return core;
+}
+
+void BranchNBoundPar::BoundNode(Graph &g, int &lb, unsigned short &ub)
+{
+	std::vector<int> peeled;
+	GraphPtr core = _decision_mode ? PeelToTarget(g, peeled, ub) : nullptr;
+	if ( peeled.empty() ) {
+		lb = _clique_strat.FindClique(g);
+		_color_strat.Color(g, ub);
+		return;
+	}
+	if ( core->GetNumVertices() == 0 ) {
+		lb = 1;	// no clique reaches the target, the node is only kept for lower ones
+		return;
+	}
+
+	// a clique with best_ub vertices, the only one that prunes, is never peeled
+	lb = _clique_strat.FindClique(*core);
+	_color_strat.Color(*core, ub);
+	ub = ColorFromCore(g, *core, peeled);
+}
+
+unsigned short BranchNBoundPar::ColorFromCore(Graph &g, const Graph &core, const std::vector<int> &peeled)
+{
+	// the coloring of the core only covers its own labels
+	std::vector<unsigned short> core_coloring = core.GetFullColoring();
+	std::vector<unsigned short> full_coloring(g.GetHighestVertex() + 1, 0);
+	for ( int vertex : core.GetVertices() ) {
+		full_coloring[vertex] = core_coloring[vertex];
+	}
+	unsigned short num_colors = ExtendCoreColoring(g, peeled, full_coloring);
+	g.SetFullColoring(full_coloring);
+	return num_colors;
+}
+
+bool BranchNBoundPar::UseSat(const Graph &residual, int lb) const
+{
+	return ( _sat_max_vertices > 0 && residual.GetNumVertices() <= (size_t)_sat_max_vertices ) ||
+		   ( _sat_max_gap > 0 && _best_ub.load() - lb <= _sat_max_gap );
+}
+
+bool BranchNBoundPar::BoundChild(Graph &child, int u, int v, int &lb, unsigned short &ub)
+{
+	if ( _nogoods && _nogoods->Prunes(child, u, v, _best_ub.load()) ) {
+		lb = _best_ub.load();
+		ub = USHRT_MAX;
+		return false;
+	}
+	BoundNode(child, lb, ub);
+	// lb > 1: a clique was searched, the node was not emptied by peeling
+	if ( _nogoods && lb > 1 && lb >= _best_ub.load() ) {
+		_nogoods->Record(_clique_strat.GetClique());
+	}
+	return true;
+}
+
 void BranchNBoundPar::UpdateCurrentBest(int depth, int lb, unsigned short ub, GraphPtr graph)
 {
     std::lock_guard<std::mutex> lock(_best_branch_mutex);
@@ -57,29 +129,33 @@ void BranchNBoundPar::UpdateCurrentBest(int depth, int lb, unsigned short ub, Gr
 	best.ub = ub;
 	best.g = std::move(graph);
 	_current_best = std::move(best);
+	_incumbent_time = MPI_Wtime() - _solve_start_time;
 }
 
-void BranchNBoundPar::Log_par(const std::string &message, int depth)
+unsigned short BranchNBoundPar::SeedInitialColoring(const Graph& g)
 {
-	if ( !_logging_flag ) return;
-
-    std::lock_guard<std::mutex> lock(log_mutex);
-    if (_log_file.is_open()) {
-        // Get the current MPI walltime
-        double timestamp = MPI_Wtime();
+	_best_ub.store(USHRT_MAX);
+	{
+		std::lock_guard<std::mutex> lock(_best_branch_mutex);
+		_current_best = Branch();
+		_incumbent_time = -1;
+	}
+	if ( _initial_coloring.empty() ) {
+		return USHRT_MAX;
+	}
 
-        // Indentation based on depth
-        std::string indentation(depth * 2, ' ');
+	unsigned short ub = 0;
+	for ( int vertex : g.GetVertices() ) {
+		ub = std::max(ub, _initial_coloring[vertex]);
+	}
 
-        int rank;
-        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-        int thread_id = omp_get_thread_num();
+	auto colored = g.Clone();
+	colored->SetFullColoring(_initial_coloring);
+	_best_ub.store(ub);
+	UpdateCurrentBest(0, 0, ub, std::move(colored));
+	LOG_EVENT(_log, INIT_COLORING, 0, ub);
 
-        // Log the message with the timestamp
-        _log_file << indentation << "[Rank " << rank
-                      << " | Thread " << thread_id << "] "
-                      << "[Time " << timestamp << "] " << message << std::endl;
-    }
+	return ub;
 }
 
 void printMessage(const std::string& msg) {
@@ -100,10 +176,17 @@ void printMessage(const std::string& msg) {
  * @param comm The MPI communicator used for communication.
  */
 void sendBranch(const Branch& b, int dest, int tag, MPI_Comm comm) {
-	std::vector<char> buffer = b.serialize();
+	std::vector<char> buffer;
+	{
+		PhaseTimer timer(StatPhase::SERIALIZE);
+		buffer = b.serialize();
+	}
 	int size = buffer.size();
 	MPI_Request request[2];	
 	int completed = 0;
+	SolverStats::Count(StatCounter::BYTES_SENT, sizeof(size) + size);
+	PhaseTimer timer(StatPhase::MPI);
+	TimelineTrace::MessageSent(comm, dest, tag);
 
 	MPI_Isend(&size, 1, MPI_INT, dest, tag, comm, &request[0]);
     
@@ -137,6 +220,8 @@ Branch recvBranch(int source, int tag, MPI_Comm comm) {
     MPI_Request request[2];
     int size = 0;
     int flag = 0;
+	// the deserialization is not part of the communication
+	std::optional<PhaseTimer> timer(std::in_place, StatPhase::MPI);
 
 	MPI_Irecv(&size, 1, MPI_INT, source, tag, comm, &request[0]);
 
@@ -167,11 +252,112 @@ Branch recvBranch(int source, int tag, MPI_Comm comm) {
         return Branch();
     }
 
+	TimelineTrace::MessageReceived(comm, source, tag);
+	timer.reset();
+	SolverStats::Count(StatCounter::BYTES_RECEIVED, sizeof(size) + size);
+	PhaseTimer deserialize_timer(StatPhase::SERIALIZE);
 	return Branch::deserialize(buffer);
 }
 
+/**
+ * @brief Waits for a non-blocking collective of the gatherer until it completes, even when the
+ * search terminates: every rank keeps taking part in the rounds of the gatherer until one of
+ * them reports it stopped, so the operation completes before its buffers are released.
+ *
+ * @param request The request of the operation.
+ */
+void completeRequest(MPI_Request& request) {
+	int flag = 0;
+	MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+	while (!flag) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+	}
+}
 
-void BranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_time, 
+/**
+ * @brief One round of the solution gatherer: every rank contributes its block of GATHER_FIELDS, 
+ * then, unless a rank reported it stopped, the flattened nogoods it shares. Both collectives 
+ * complete even when the search terminated, see completeRequest.
+ *
+ * @param local The block of this rank, whose GATHER_NOGOODS is the length of nogoods.
+ * @param nogoods The nogoods of this rank, flattened as size, vertices...
+ * @param share_nogoods Whether the nogoods are exchanged, the same on every rank.
+ * @param all_fields The blocks of all the ranks, in rank order.
+ * @param all_nogoods The nogoods of all the ranks, flattened.
+ * @param comm The communicator of the gatherer.
+ * @return false if a rank reported it stopped, all_nogoods is then left empty.
+ */
+bool gatherRound(const std::vector<double>& local, const std::vector<int>& nogoods, bool share_nogoods, 
+				 std::vector<double>& all_fields, std::vector<int>& all_nogoods, MPI_Comm comm) {
+	int p;
+	MPI_Comm_size(comm, &p);
+	all_fields.assign(GATHER_FIELDS * p, 0);
+	all_nogoods.clear();
+	MPI_Request request;
+	MPI_Iallgather(local.data(), GATHER_FIELDS, MPI_DOUBLE, all_fields.data(), GATHER_FIELDS, MPI_DOUBLE, 
+				   comm, &request);
+	completeRequest(request);
+	for ( int i = 0; i < p; i++ ) {
+		if ( all_fields[GATHER_FIELDS*i + GATHER_STOPPED] != 0 ) {
+			return false;
+		}
+	}
+	if ( !share_nogoods ) {
+		return true;
+	}
+
+	std::vector<int> sizes(p);
+	std::vector<int> displacements(p, 0);
+	for ( int i = 0; i < p; i++ ) {
+		sizes[i] = all_fields[GATHER_FIELDS*i + GATHER_NOGOODS];
+		if ( i > 0 ) {
+			displacements[i] = displacements[i-1] + sizes[i-1];
+		}
+	}
+	all_nogoods.resize(displacements[p-1] + sizes[p-1]);
+	MPI_Iallgatherv(nogoods.data(), nogoods.size(), MPI_INT, all_nogoods.data(), sizes.data(), displacements.data(), 
+					MPI_INT, comm, &request);
+	completeRequest(request);
+	return true;
+}
+
+/**
+ * @brief Chooses the branching vertices of a node, timed as the branching phase.
+ *
+ * @param strategy The branching strategy of the solver.
+ * @param graph The node to branch on.
+ * @return The pair of vertices, -1 if there is none.
+ */
+std::pair<int, int> chooseVertices(BranchingStrategy& strategy, Graph& graph) {
+	PhaseTimer timer(StatPhase::BRANCHING);
+	return strategy.ChooseVertices(graph);
+}
+
+/**
+ * @brief Finds a group whose processes are all idle: with no work left to steal within 
+ * the group, it has exhausted its search tree.
+ *
+ * @param idle_status The idle status of each process.
+ * @param group_of_rank The group of each process, empty for a single group.
+ * @return The group whose processes are all idle, -1 if there is none.
+ */
+int idleGroup(const std::vector<int>& idle_status, const std::vector<int>& group_of_rank) {
+	int num_groups = group_of_rank.empty() ? 1 : *std::max_element(group_of_rank.begin(), group_of_rank.end()) + 1;
+	std::vector<bool> busy(num_groups, false);
+	for (size_t rank = 0; rank < idle_status.size(); rank++) {
+		if (idle_status[rank] != 1) {
+			busy[group_of_rank.empty() ? 0 : group_of_rank[rank]] = true;
+		}
+	}
+	for (int group = 0; group < num_groups; group++) {
+		if (!busy[group]) return group;
+	}
+	return -1;
+}
+
+
+void BranchNBoundPar::thread_0_terminator(int my_rank, int p, double global_start_time, 
 	int timeout_seconds, double &optimum_time,
 	Graph& graph_to_color) {
 	int solution_found = 0;
@@ -189,16 +375,16 @@ void BranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_t
 			// Check if timeout is reached, broadcast timeout signal
 			if (MPI_Wtime() - global_start_time >= timeout_seconds) {
 				timeout_signal = 1;
-				Log_par("[TERMINATION]: Timeout reached.", 0);
+				LOG_EVENT(_log, TIMEOUT, 0);
 			}
 
-			MPI_Iprobe(MPI_ANY_SOURCE, TAG_SOLUTION_FOUND, MPI_COMM_WORLD, &flag_solution, &status_solution);
+			MPI_Iprobe(MPI_ANY_SOURCE, TAG_SOLUTION_FOUND, _comm, &flag_solution, &status_solution);
 			// Check if a solution is being communicated
 			if (flag_solution) {
 				unsigned short solution = 0;
 				MPI_Request recv_request;
 				MPI_Status recv_status;
-				MPI_Irecv(&solution, 1, MPI_UNSIGNED_SHORT, status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, MPI_COMM_WORLD, &recv_request);
+				MPI_Irecv(&solution, 1, MPI_UNSIGNED_SHORT, status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, _comm, &recv_request);
 				_best_ub.store(solution);
 
 				int completed = 0;
@@ -210,14 +396,20 @@ void BranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_t
 				}
 
 				//Branch optimal_branch = Branch::deserialize(buffer);
-				Branch optimal_branch = recvBranch(status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, MPI_COMM_WORLD);
+				Branch optimal_branch = recvBranch(status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, _comm);
 
 				ColorInitialGraph(graph_to_color, optimal_branch);
 
 				_best_ub.store(optimal_branch.ub);
-
-				solution_found = 1;
-				Log_par("[TERMINATION]: Solution found communicated.", 0);
+				_incumbent_rank = status_solution.MPI_SOURCE;
+				// the worker also stops at a coloring which meets a lower bound, which is a proof:
+				// only reaching the expected chromatic number is not
+				bool bound_met = optimal_branch.ub <= std::max(_known_lb, _global_lb.load()) || 
+								 (optimal_branch.depth == 0 && optimal_branch.lb >= optimal_branch.ub);
+				_outcome = bound_met ? SolveOutcome::PROVEN : SolveOutcome::EXPECTED;
+
+				solution_found = FOUND_EXPECTED;
+				LOG_EVENT(_log, SOLUTION_COMMUNICATED, 0);
 				optimum_time = MPI_Wtime() - global_start_time;
 
 			}
@@ -225,7 +417,7 @@ void BranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_t
 			// Listen for idle status updates from workers
 			while (true) {
 				int flag_idle = 0;
-				MPI_Iprobe(MPI_ANY_SOURCE, TAG_IDLE, MPI_COMM_WORLD, &flag_idle, &status_idle);
+				MPI_Iprobe(MPI_ANY_SOURCE, TAG_IDLE, _comm, &flag_idle, &status_idle);
 
 				if (!flag_idle) break;
 
@@ -235,7 +427,7 @@ void BranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_t
 
 
 				MPI_Request recv_request;
-				MPI_Irecv(&worker_idle_status, 1, MPI_INT, status_idle.MPI_SOURCE, TAG_IDLE, MPI_COMM_WORLD, &recv_request);
+				MPI_Irecv(&worker_idle_status, 1, MPI_INT, status_idle.MPI_SOURCE, TAG_IDLE, _comm, &recv_request);
 
 				int completed = 0;
 				MPI_Status status_sol_completed;
@@ -248,36 +440,55 @@ void BranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_t
 				if(completed) idle_status[status_idle.MPI_SOURCE] = worker_idle_status;
 			}
 
-			// Check if all workers are idle
-			if (std::all_of(idle_status.begin(), idle_status.end(), [](int status) { return status == 1; })) {
-				solution_found = 1;
+			// Check if all workers of a group are idle
+			int idle_group = idleGroup(idle_status, _group_of_rank);
+			if (idle_group != -1) {
+				solution_found = FOUND_ALL_IDLE;
+				_proof_group = idle_group;
+				// the tree is not exhausted when a branch stopped at the expected chromatic number
+				if (_outcome != SolveOutcome::EXPECTED) _outcome = SolveOutcome::PROVEN;
+				optimum_time = MPI_Wtime() - global_start_time;
+				LOG_EVENT(_log, GROUP_IDLE, 0, idle_group);
+			}
+
+			// Check if the best coloring meets the lower bound
+			if (!solution_found && _best_ub.load() <= std::max(_known_lb, _global_lb.load())) {
+				solution_found = FOUND_BOUND;
+				_outcome = SolveOutcome::PROVEN;
 				optimum_time = MPI_Wtime() - global_start_time;
-				Log_par("[TERMINATION]: All processes idle.", 0);
+				LOG_EVENT(_log, BOUND_MET, 0);
 			}
 
 		}
 		// Worker nodes listen for termination signals (solution or timeout)
-		MPI_Bcast(&solution_found, 1, MPI_INT, 0, MPI_COMM_WORLD);
-		MPI_Bcast(&timeout_signal, 1, MPI_INT, 0, MPI_COMM_WORLD);
+		MPI_Bcast(&solution_found, 1, MPI_INT, 0, _comm);
+		MPI_Bcast(&timeout_signal, 1, MPI_INT, 0, _comm);
 
-		// Exit if solution or timeout is detected
-		if ( timeout_signal ) {
+		// Gather the incumbents when the search stopped without a branch reaching the expected chi
+		if ( timeout_signal || solution_found == FOUND_ALL_IDLE || solution_found == FOUND_BOUND ) {
 			if ( my_rank == 0 ) {
-				bool found = false;
 				Branch best_branch;
+				int best_rank = 0;
+				{
+					std::lock_guard<std::mutex> lock(_best_branch_mutex);
+					best_branch = std::move(_current_best);
+				}
 				for ( int i = 1; i < p; i++ ) {
-					Branch b = recvBranch(i, TAG_TIMEOUT_SOLUTION, MPI_COMM_WORLD);
-
-					if ( (!found || b.ub < best_branch.ub ) && b.ub <= _best_ub.load() ) {
-						_best_ub.store(b.ub);
-						best_branch = b;
+					Branch b = recvBranch(i, TAG_TIMEOUT_SOLUTION, _comm);
+					if ( b.g && (!best_branch.g || b.ub < best_branch.ub) ) {
+						best_branch = std::move(b);
+						best_rank = i;
 					}
 				}
 
-				ColorInitialGraph(graph_to_color, best_branch);
+				if ( best_branch.g ) {
+					_incumbent_rank = best_rank;
+					_best_ub.store(best_branch.ub);
+					ColorInitialGraph(graph_to_color, best_branch);
+				}
 			} else {
     			std::lock_guard<std::mutex> lock(_best_branch_mutex);
-				sendBranch(_current_best, 0, TAG_TIMEOUT_SOLUTION, MPI_COMM_WORLD);
+				sendBranch(_current_best, 0, TAG_TIMEOUT_SOLUTION, _comm);
 			}
 		}
 		if (solution_found || timeout_signal) {
@@ -289,74 +500,276 @@ void BranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_t
 }
 
 
-void BranchNBoundPar::thread_1_solution_gatherer(int p, std::atomic<unsigned short>& best_ub, int sol_gather_period) { 
-    std::vector<unsigned short> all_best_ub(p);
-    auto last_gather_time = MPI_Wtime();
-    MPI_Request request;
-	int request_active = 0;
-	
-    while (!terminate_flag.load(std::memory_order_relaxed)) {
-        auto current_time = MPI_Wtime();
-        auto elapsed_time = current_time - last_gather_time;
+void BranchNBoundPar::LearnNogoods(const std::vector<int>& all)
+{
+	// the nogoods of this rank are already known and skipped
+	int learnt = 0;
+	for ( size_t i = 0; i < all.size(); i += all[i] + 1 ) {
+		learnt += _nogoods->Record(std::vector<int>(all.begin() + i + 1, all.begin() + i + 1 + all[i]));
+	}
+	LOG_EVENT(_log, NOGOODS_LEARNT, 0, learnt);
+}
 
-        if (elapsed_time >= sol_gather_period) {
-            unsigned short local_best_ub = best_ub.load(); // safe read
+/**
+ * @brief Formats an estimated number of nodes: whole while it fits a long, in scientific
+ * notation above, where the random dives of the estimator easily overshoot.
+ *
+ * @param nodes The estimated number of nodes.
+ * @return The formatted number.
+ */
+std::string formatEstimate(double nodes) {
+	if ( nodes < 1e15 ) {
+		return std::to_string((long) nodes);
+	}
+	std::ostringstream text;
+	text << std::setprecision(3) << nodes;
+	return text.str();
+}
 
-			if (terminate_flag.load(std::memory_order_relaxed)) {
-                return;
-            }
+void BranchNBoundPar::GatherProgress(int p, const std::vector<double>& all_fields)
+{
+	int my_rank;
+	MPI_Comm_rank(_comm, &my_rank);
+
+	// the root estimates are averaged, the ranks of this group are listed in the order of 
+	// their group ranks, which follows the ranks in _comm
+	ProgressEstimate progress;
+	std::vector<double> group_remaining;
+	int my_group = _group_of_rank.empty() ? 0 : _group_of_rank[my_rank];
+	int root_estimates = 0;
+	for ( int i = 0; i < p; i++ ) {
+		const double* fields = &all_fields[GATHER_FIELDS*i];
+		progress.explored += fields[GATHER_EXPLORED];
+		if ( fields[GATHER_REMAINING] < 0 || progress.remaining < 0 ) {
+			progress.remaining = -1;
+		} else {
+			progress.remaining += fields[GATHER_REMAINING];
+		}
+		if ( fields[GATHER_ROOT_TREE] > 0 ) {
+			progress.tree_size += fields[GATHER_ROOT_TREE];
+			root_estimates++;
+		}
+		if ( (_group_of_rank.empty() ? 0 : _group_of_rank[i]) == my_group ) {
+			group_remaining.push_back(fields[GATHER_REMAINING]);
+		}
+	}
+	if ( root_estimates > 0 ) {
+		progress.tree_size /= root_estimates;
+	}
+	{
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		_progress = progress;
+		_group_remaining = group_remaining;
+	}
 
-            // Start non-blocking allgather
-            MPI_Iallgather(&local_best_ub, 1, MPI_UNSIGNED_SHORT, all_best_ub.data(), 1, MPI_UNSIGNED_SHORT, MPI_COMM_WORLD, &request);
-			request_active = 1;
-
-            // Wait for completion with timeout handling (or simply test it periodically)
-            MPI_Status status;
-            while (true) {
-                int flag = 0;
-                MPI_Test(&request, &flag, &status);
-                if (flag) break;  // The operation is completed
-
-                // If termination flag is set, cancel the request to avoid deadlock
-                if (terminate_flag.load(std::memory_order_relaxed)) {
-					if (request_active && flag) {
-                        MPI_Cancel(&request);
-                        MPI_Request_free(&request);
-                    }
-                    return;
-                }
+	if ( my_rank == 0 ) {
+		std::cout << "[PROGRESS] " << (int) (MPI_Wtime() - _solve_start_time) << " s: " 
+				  << progress.explored << " nodes explored, ";
+		if ( progress.remaining < 0 ) {
+			std::cout << "no estimate of the nodes left yet";
+		} else {
+			double done = 100.0 * progress.explored / std::max(1.0, progress.explored + progress.remaining);
+			std::cout << "~" << formatEstimate(progress.remaining) << " left below the queued nodes (" 
+					  << (int) done << "% done)";
+		}
+		if ( progress.tree_size > 0 ) {
+			std::cout << ", root probes ~" << formatEstimate(progress.tree_size) << " nodes";
+		}
+		std::cout << std::endl;
+	}
+}
 
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
-			request_active = 0;
+void BranchNBoundPar::GatherStatus(int p, const std::vector<double>& all_fields)
+{
+	int my_rank;
+	MPI_Comm_rank(_comm, &my_rank);
+	if ( my_rank != 0 || _status_server == nullptr ) {
+		return;
+	}
 
-            // Update the best upper bound for other threads in shared memory
-			Log_par("[UPDATE] Gathered best_ub " + std::to_string(best_ub), 0);
-            best_ub.store(*std::min_element(all_best_ub.begin(), all_best_ub.end()));  // safe write
+	StatusSnapshot snapshot;
+	double now = MPI_Wtime();
+	snapshot.running = true;
+	snapshot.elapsed = now - _solve_start_time;
+	snapshot.best_ub = _best_ub.load();
+	snapshot.global_lb = _global_lb.load();
+	long steals = 0;
+	for ( int i = 0; i < p; i++ ) {
+		const double* fields = &all_fields[GATHER_FIELDS*i];
+		snapshot.ranks.push_back(RankStatus{(long) fields[GATHER_EXPLORED], (long) fields[GATHER_QUEUE], 
+											(long) fields[GATHER_STEALS]});
+		snapshot.nodes += (long) fields[GATHER_EXPLORED];
+		steals += (long) fields[GATHER_STEALS];
+	}
+	double interval = now - _last_status_time;
+	if ( interval > 0 ) {
+		snapshot.nodes_per_second = (snapshot.nodes - _last_status_nodes) / interval;
+		snapshot.steals_per_second = (steals - _last_status_steals) / interval;
+	}
+	_last_status_time = now;
+	_last_status_nodes = snapshot.nodes;
+	_last_status_steals = steals;
+	if ( _estimate_progress ) {
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		snapshot.estimated = true;
+		snapshot.progress = _progress;
+	}
+	_status_server->Publish(snapshot);
+}
 
-            // Reset the timer
-            last_gather_time = current_time;
-        }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-	if (request_active) {
-        MPI_Cancel(&request);
-        MPI_Request_free(&request);
-    }
+void BranchNBoundPar::thread_4_estimator(const Graph& root, std::mutex& queue_mutex, BranchQueue& queue)
+{
+	// the probes are not part of the search, nor are their clones, cliques and colorings
+	SolverStats::SetCounted(false);
+	TreeSizeEstimator estimator;
+	Xoshiro256& random = ThreadRandom::Get();
+	bool from_root = true;
+
+	while (!terminate_flag.load(std::memory_order_relaxed)) {
+		auto probe_start = std::chrono::steady_clock::now();
+		unsigned short best_ub = _best_ub.load();
+		if ( from_root ) {
+			double estimate = estimator.Probe(root, best_ub, terminate_flag);
+			std::lock_guard<std::mutex> lock(_estimate_mutex);
+			if ( estimate >= 0 ) {
+				_root_probes.Add(estimate);
+			}
+		} else {
+			GraphPtr node;
+			size_t frontier_size;
+			{
+				std::lock_guard<std::mutex> lock(queue_mutex);
+				frontier_size = queue.size();
+				if ( frontier_size > 0 ) {
+					node = queue.at(random.Below(frontier_size)).g->Clone();
+				}
+			}
+			{
+				std::lock_guard<std::mutex> lock(_estimate_mutex);
+				_frontier_size = frontier_size;
+			}
+			double estimate = node ? estimator.Probe(*node, best_ub, terminate_flag) : -1;
+			std::lock_guard<std::mutex> lock(_estimate_mutex);
+			if ( estimate >= 0 ) {
+				_frontier_probes.Add(estimate);
+			}
+		}
+		from_root = !from_root;
+
+		// only spare cycles: as long idle as busy, in short sleeps not to hold up the termination
+		auto now = std::chrono::steady_clock::now();
+		auto idle_until = now + std::max<std::chrono::steady_clock::duration>(now - probe_start, std::chrono::milliseconds(10));
+		while ( !terminate_flag.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < idle_until ) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+	SolverStats::SetCounted(true);
+}
+
+bool BranchNBoundPar::GatherRound(int p, std::atomic<unsigned short>& best_ub, bool stopped, std::mutex& queue_mutex,
+								  BranchQueue& queue)
+{
+	// flattened as size, vertices, size, vertices...
+	std::vector<int> nogoods;
+	if ( _nogoods && _nogood_share > 0 && !stopped ) {
+		for ( const std::vector<int>& nogood : _nogoods->MostUsed(_nogood_share) ) {
+			nogoods.push_back(nogood.size());
+			nogoods.insert(nogoods.end(), nogood.begin(), nogood.end());
+		}
+	}
+	std::vector<double> local(GATHER_FIELDS, 0);
+	local[GATHER_UB] = best_ub.load();
+	local[GATHER_LB] = _global_lb.load();
+	local[GATHER_STOPPED] = stopped;
+	local[GATHER_NOGOODS] = nogoods.size();
+	local[GATHER_EXPLORED] = _nodes_explored.load();
+	if ( _estimate_progress ) {
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		local[GATHER_ROOT_TREE] = _root_probes.Mean();
+		// unknown (-1) until a queued node was probed, or at least the queue found empty
+		local[GATHER_REMAINING] = _frontier_size == 0 ? 0 : 
+								  _frontier_size < 0 || _frontier_probes.count == 0 ? -1 : 
+								  _frontier_size * _frontier_probes.Mean();
+	}
+	if ( _report_status ) {
+		{
+			std::lock_guard<std::mutex> lock(queue_mutex);
+			local[GATHER_QUEUE] = queue.size();
+		}
+		local[GATHER_STEALS] = _steals_received.load();
+	}
+
+	std::vector<double> all;
+	std::vector<int> all_nogoods;
+	// the terminator settles the final bounds and incumbent, which are left alone
+	if ( !gatherRound(local, nogoods, _nogoods && _nogood_share > 0, all, all_nogoods, _gather_comm) ) {
+		return false;
+	}
+
+	// Update the best upper bound for other threads in shared memory
+	LOG_EVENT(_log, GATHERED_UB, 0, best_ub);
+	unsigned short gathered_ub = USHRT_MAX, gathered_lb = 0;
+	for ( int i = 0; i < p; i++ ) {
+		gathered_ub = std::min(gathered_ub, (unsigned short) all[GATHER_FIELDS*i + GATHER_UB]);
+		gathered_lb = std::max(gathered_lb, (unsigned short) all[GATHER_FIELDS*i + GATHER_LB]);
+	}
+	best_ub.store(gathered_ub);
+	_global_lb.store(std::max(_global_lb.load(), gathered_lb));
+	if ( _nogoods && _nogood_share > 0 ) {
+		LearnNogoods(all_nogoods);
+	}
+	if ( _estimate_progress ) {
+		GatherProgress(p, all);
+	}
+	if ( _report_status ) {
+		GatherStatus(p, all);
+	}
+	return true;
 }
 
+void BranchNBoundPar::thread_1_solution_gatherer(int p, std::atomic<unsigned short>& best_ub, int sol_gather_period,
+												 std::mutex& queue_mutex, BranchQueue& queue) { 
+	auto last_gather_time = MPI_Wtime();
 
-void BranchNBoundPar::thread_2_employer(std::mutex& queue_mutex, BranchQueue& queue) {
+	// once the search terminated on this rank, a last round is started at once, which tells the
+	// others; no rank leaves before every collective it started completed
+	bool running = true;
+	while ( running ) {
+		bool stopped = terminate_flag.load(std::memory_order_relaxed);
+		auto current_time = MPI_Wtime();
+		if ( !stopped && current_time - last_gather_time < sol_gather_period ) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			continue;
+		}
+		running = GatherRound(p, best_ub, stopped, queue_mutex, queue);
+		last_gather_time = current_time;
+	}
+}
+
+
+/**
+ * @brief Answers the work requests of the other workers of the communicator: a node of the
+ * queue is sent when the queue keeps at least one for this worker. Polls every 10 ms until
+ * the search terminates.
+ *
+ * @param queue_mutex Mutex protecting the queue.
+ * @param queue The local work queue.
+ * @param comm The communicator of the group the workers steal in.
+ */
+void serveWorkRequests(std::mutex& queue_mutex, BranchQueue& queue, MPI_Comm comm) {
     MPI_Status status;
     int request_signal = 0;
     MPI_Request request;
 
     while (!terminate_flag.load(std::memory_order_relaxed)) {
-        MPI_Iprobe(MPI_ANY_SOURCE, TAG_WORK_REQUEST, MPI_COMM_WORLD, &request_signal, &status);
+        MPI_Iprobe(MPI_ANY_SOURCE, TAG_WORK_REQUEST, comm, &request_signal, &status);
         if (request_signal) {
             int destination_rank = status.MPI_SOURCE;
             int response = 0;
+            // consume the request, or it is probed (and answered) again at the next iteration
+            MPI_Recv(nullptr, 0, MPI_INT, destination_rank, TAG_WORK_REQUEST, comm, MPI_STATUS_IGNORE);
+            TraceSpan span("steal response");
+            TimelineTrace::MessageReceived(comm, destination_rank, TAG_WORK_REQUEST);
 
             std::lock_guard<std::mutex> lock(queue_mutex);
             if (queue.size() > 1) {
@@ -364,11 +777,15 @@ void BranchNBoundPar::thread_2_employer(std::mutex& queue_mutex, BranchQueue& qu
                 Branch branch = std::move(const_cast<Branch&>(queue.top()));
                 queue.pop();
 
-                MPI_Isend(&response, 1, MPI_INT, destination_rank, TAG_WORK_RESPONSE, MPI_COMM_WORLD, &request);
+                MPI_Isend(&response, 1, MPI_INT, destination_rank, TAG_WORK_RESPONSE, comm, &request);
+
+                TimelineTrace::MessageSent(comm, destination_rank, TAG_WORK_RESPONSE);
                 MPI_Request_free(&request);
-                sendBranch(branch, destination_rank, TAG_WORK_STEALING, MPI_COMM_WORLD);
+                sendBranch(branch, destination_rank, TAG_WORK_STEALING, comm);
+                SolverStats::Count(StatCounter::STEALS_SENT);
             } else {
-                MPI_Isend(&response, 1, MPI_INT, destination_rank, TAG_WORK_RESPONSE, MPI_COMM_WORLD, &request);
+                MPI_Isend(&response, 1, MPI_INT, destination_rank, TAG_WORK_RESPONSE, comm, &request);
+                TimelineTrace::MessageSent(comm, destination_rank, TAG_WORK_RESPONSE);
                 MPI_Request_free(&request);
             }
         }
@@ -376,6 +793,10 @@ void BranchNBoundPar::thread_2_employer(std::mutex& queue_mutex, BranchQueue& qu
     }
 }
 
+void BranchNBoundPar::thread_2_employer(std::mutex& queue_mutex, BranchQueue& queue) {
+    serveWorkRequests(queue_mutex, queue, _group_comm);
+}
+
 /**
  * request_work - Requests work from other worker processes when the local queue is empty.
  *
@@ -390,41 +811,72 @@ void BranchNBoundPar::thread_2_employer(std::mutex& queue_mutex, BranchQueue& qu
  *   queue (BranchQueue&)     : The local work queue containing branches to be processed.
  *   queue_mutex (std::mutex&): Mutex to protect concurrent access to the work queue.
  *   current (Branch&)        : The branch object to store the received work.
+ *   comm (MPI_Comm)          : The communicator of the search.
+ *   remaining (const std::vector<double>&) : Estimated work left on each worker, the worker 
+ *                              asked is drawn with probability proportional to it (uniformly 
+ *                              if it is not known).
  *
  * Returns:
  *   bool : True if work was successfully received and added to the queue, false otherwise.
  */
-bool request_work(int my_rank, int p, BranchQueue& queue, std::mutex& queue_mutex, Branch& current) {
+bool request_work(int my_rank, int p, BranchQueue& queue, std::mutex& queue_mutex, Branch& current, MPI_Comm comm,
+                  const std::vector<double>& remaining) {
+    if (p == 1) return false;   // No other worker to request work from
     int target_worker = my_rank;
-    while (target_worker == my_rank) target_worker = (rand() % p); // Randomly select a worker to request work from
+    double others = 0;
+    if ((int) remaining.size() == p) {
+        for (int i = 0; i < p; i++) if (i != my_rank) others += remaining[i];
+        // a worker not yet estimated (-1) makes the estimates useless
+        if (std::any_of(remaining.begin(), remaining.end(), [](double r) { return r < 0; })) others = 0;
+    }
+    if (others > 0) {
+        // The workers with more work left are more likely to be asked
+        double draw = others * ThreadRandom::Get().Uniform();
+        for (target_worker = 0; target_worker < p - 1; target_worker++) {
+            if (target_worker == my_rank) continue;
+            draw -= remaining[target_worker];
+            if (draw < 0) break;
+        }
+        if (target_worker == my_rank) target_worker = (my_rank + 1) % p;
+    }
+    while (target_worker == my_rank) target_worker = ThreadRandom::Get().Below(p); // Randomly select a worker to request work from
 
     MPI_Status status;
     int response = 0;
     MPI_Request send_request, recv_request;
+    TraceSpan span("steal request");
 
-    MPI_Isend(nullptr, 0, MPI_INT, target_worker, TAG_WORK_REQUEST, MPI_COMM_WORLD, &send_request);
+    MPI_Isend(nullptr, 0, MPI_INT, target_worker, TAG_WORK_REQUEST, comm, &send_request);
     MPI_Request_free(&send_request);
+    TimelineTrace::MessageSent(comm, target_worker, TAG_WORK_REQUEST);
 
-    MPI_Irecv(&response, 1, MPI_INT, target_worker, TAG_WORK_RESPONSE, MPI_COMM_WORLD, &recv_request);
+    MPI_Irecv(&response, 1, MPI_INT, target_worker, TAG_WORK_RESPONSE, comm, &recv_request);
 
     double start_time = MPI_Wtime();
-    while (true) {
-        int flag = 0;
-        MPI_Test(&recv_request, &flag, &status);
-        if (flag) break;  // The operation is completed
-
-        // If termination flag is set, cancel the request to avoid deadlock
-        if (terminate_flag.load(std::memory_order_relaxed)) {
-            MPI_Cancel(&recv_request);
-            MPI_Request_free(&recv_request);
-            return false;
-        }
+    {
+        PhaseTimer timer(StatPhase::MPI);
+        while (true) {
+            int flag = 0;
+            MPI_Test(&recv_request, &flag, &status);
+            if (flag) {  // The operation is completed
+                TimelineTrace::MessageReceived(comm, target_worker, TAG_WORK_RESPONSE);
+                break;
+            }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // If termination flag is set, cancel the request to avoid deadlock
+            if (terminate_flag.load(std::memory_order_relaxed)) {
+                MPI_Cancel(&recv_request);
+                MPI_Request_free(&recv_request);
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
     }
 
     if (response == 1) { // Work is available
-        current = recvBranch(target_worker, TAG_WORK_STEALING, MPI_COMM_WORLD);
+        current = recvBranch(target_worker, TAG_WORK_STEALING, comm);
+        SolverStats::Count(StatCounter::STEALS_RECEIVED);
         std::lock_guard<std::mutex> lock(queue_mutex);
         queue.push(std::move(current));
         return true;
@@ -438,18 +890,59 @@ int BranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds,
 
 	optimum_time  = -1.0;
 	terminate_flag.store(false);
+	_incumbent_rank = -1;
+	_proof_group    = -1;
+	_outcome        = SolveOutcome::TIMEOUT;
+	_global_lb.store(0);
+	_solve_start_time = global_start_time;
+	_nodes_explored.store(0);
+	_steals_received.store(0);
+	_last_status_time = global_start_time;
+	_last_status_nodes = 0;
+	_last_status_steals = 0;
+	{
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		_root_probes = ProbeMean();
+		_frontier_probes = ProbeMean();
+		_frontier_size = -1;
+		_group_remaining.clear();
+		_progress = ProgressEstimate();
+	}
 
-	BranchQueue queue;
+	unsigned short initial_ub = SeedInitialColoring(g);
+	if ( (initial_ub == expected_chi && initial_ub != USHRT_MAX) || initial_ub <= _known_lb ) {
+		// the given coloring already reaches the expected chromatic number or a proven lower bound,
+		// there is nothing to search (USHRT_MAX is no coloring given, which the default 
+		// expected_chi must not match)
+		g.SetFullColoring(_initial_coloring);
+		_outcome = initial_ub <= _known_lb ? SolveOutcome::PROVEN : SolveOutcome::EXPECTED;
+		optimum_time = MPI_Wtime() - global_start_time;
+		return initial_ub;
+	}
+
+	// every Solve gets its own communicator, so messages left from a previous one are never matched
+	MPI_Comm_dup(MPI_COMM_WORLD, &_comm);
+	MPI_Comm_dup(MPI_COMM_WORLD, &_gather_comm);
+	_nogoods = _nogood_capacity > 0 ? std::make_unique<NogoodIndex>(g, _nogood_capacity) : nullptr;
+
+	BranchQueue queue(BranchOrder{_node_selection});
 	int my_rank;
 	int p;
-	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
-	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(_comm, &my_rank);
+	MPI_Comm_size(_comm, &p);
+
+	// the tree is split among the processes of a group, which only steal work from each other
+	MPI_Comm_split(_comm, _group_of_rank.empty() ? 0 : _group_of_rank[my_rank], my_rank, &_group_comm);
+	int group_rank;
+	int group_size;
+	MPI_Comm_rank(_group_comm, &group_rank);
+	MPI_Comm_size(_group_comm, &group_size);
 
 	// Initialize big enough best_ub for all processes.
 	std::atomic<unsigned short> best_ub = USHRT_MAX;
 	unsigned short ub1 = USHRT_MAX;
 	unsigned short ub2 = USHRT_MAX;
-	unsigned short lb1 = 0;
+	int lb1 = 0;
 	unsigned short lb2 = 0;
 
 	MPI_Status status_recv;
@@ -462,31 +955,46 @@ int BranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds,
 	termination and listening for work requests, then the remaining threads are used
 	for the actual computations.
 	*/
-	omp_set_num_threads(4);
+	// the probes of the estimator start from a copy of the root, the worker colors g
+	GraphPtr probe_root = _estimate_progress ? g.Clone() : nullptr;
+	omp_set_num_threads(_estimate_progress ? 5 : 4);
 	#pragma omp parallel default(shared)
 	{
 		int tid = omp_get_thread_num();
 
 		if (tid == 0) { // Checks if solution has been found or timeout. 
+			TimelineTrace::NameThread("terminator");
 			thread_0_terminator(my_rank, p, global_start_time, timeout_seconds, optimum_time, g);
 		}else if (tid == 1) { // Updates (gathers) best_ub from time to time.
-			thread_1_solution_gatherer(p, _best_ub, sol_gather_period);
+			TimelineTrace::NameThread("gatherer");
+			thread_1_solution_gatherer(p, _best_ub, sol_gather_period, queue_mutex, queue);
 		}else if (tid == 2) { // Employer thread employs workers by answering their work requests
+			TimelineTrace::NameThread("employer");
 			thread_2_employer(queue_mutex, queue);
+		}else if (tid == 4) { // Estimator thread probes the tree on spare cycles
+			TimelineTrace::NameThread("estimator");
+			thread_4_estimator(*probe_root, queue_mutex, queue);
 		}else if (tid == 3) { // TODO: Let more threads do these computations in parallel
+			TimelineTrace::NameThread("worker");
 			
 			Branch current;
 
 			// Initialize bounds
 			int lb = _clique_strat.FindClique(g);
 			unsigned short ub;
+			// the clique of the root bounds the whole graph, for every group
+			if ( lb > _global_lb.load() ) {
+				_global_lb.store(lb);
+			}
 			_color_strat.Color(g, ub);
-			_best_ub.store(ub);
-			UpdateCurrentBest(0, lb, ub, std::move(g.Clone()));
+			// keep the initial coloring, if any, unless the heuristic already beats it
+			if ( ub < _best_ub.load() ) {
+				_best_ub.store(ub);
+				UpdateCurrentBest(0, lb, ub, std::move(g.Clone()));
+			}
 	
 			// Log initial bounds
-			Log_par("[INITIALIZATION] Initial bounds: lb = " + std::to_string(lb) +
-				", ub = " + std::to_string(ub), 0);
+			LOG_EVENT(_log, INIT_BOUNDS, 0, lb, ub);
 
 			std::unique_lock<std::mutex> lock(queue_mutex, std::defer_lock);
 			queue.push(Branch(g.Clone(), lb, ub, 1));	// Initial branch with depth 1
@@ -508,54 +1016,62 @@ int BranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds,
 				
 				// If no work, request work.
 				if (!has_work) {
+					TraceSpan idle_span("idle");
 					// Notify the root process that this worker is idle
 					int idle_status = 1;
-					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, MPI_COMM_WORLD);
+					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, _comm);
 					// Start requesting work.
-					Log_par("[REQUEST] Requesting work...", current.depth);
-					while (!terminate_flag.load() && !request_work(my_rank, p, queue, queue_mutex, current)) {
+					LOG_EVENT(_log, REQUEST_WORK, current.depth);
+					std::vector<double> steal_weights;
+					{
+						std::lock_guard<std::mutex> lock(_estimate_mutex);
+						steal_weights = _group_remaining;
+					}
+					while (!terminate_flag.load() && !request_work(group_rank, group_size, queue, queue_mutex, current, _group_comm, steal_weights)) {
 						std::this_thread::sleep_for(std::chrono::milliseconds(10));
 					}
 					// Work received. Notify the root process that this worker is not idle anymore.
 					if(terminate_flag.load()) break;
+					_steals_received.fetch_add(1, std::memory_order_relaxed);
 					idle_status = 0;
-					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, MPI_COMM_WORLD);
-					Log_par("[REQUEST] Work received.", current.depth);				
+					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, _comm);
+					LOG_EVENT(_log, WORK_RECEIVED, current.depth);				
 					continue;
 				}
 
+				_nodes_explored.fetch_add(1, std::memory_order_relaxed);
+				SolverStats::Count(StatCounter::NODES_PROCESSED);
+				TraceSpan node_span("evaluate node");
 				auto current_G = std::move(current.g);
 				int current_lb = current.lb;
 				unsigned short current_ub = current.ub;
 
-				Log_par("[BRANCH] Processing node: lb = " + std::to_string(current_lb) +
-						", ub = " + std::to_string(current_ub), current.depth);
+				LOG_EVENT(_log, PROCESS_NODE, current.depth, current_lb, current_ub);
 
-				if ( current_ub == expected_chi ) {
+				if ( current_ub == expected_chi || current_ub <= _known_lb ) {
+					SolverStats::Count(StatCounter::PRUNED_EXPECTED);
 					_best_ub.store(current_ub);
-					MPI_Send(&current_ub, 1, MPI_UNSIGNED_SHORT, 0, TAG_SOLUTION_FOUND, MPI_COMM_WORLD);  // check if it is correct
+					MPI_Send(&current_ub, 1, MPI_UNSIGNED_SHORT, 0, TAG_SOLUTION_FOUND, _comm);  // check if it is correct
 
 					current.g = std::move(current_G);
-					sendBranch(current, 0, TAG_SOLUTION_FOUND, MPI_COMM_WORLD);
+					sendBranch(current, 0, TAG_SOLUTION_FOUND, _comm);
 
-					Log_par(
-					"[FOUND] Chromatic number "
-					"found: " + std::to_string(current_ub),current.depth);
-					Log_par("========== END ==========", 0);
+					LOG_EVENT(_log, FOUND, current.depth, current_ub);
+					LOG_EVENT(_log, END, 0);
 					break;
 				}
 
 				if (current_lb == current_ub) {
 					// If at root (original graph, first iteration), solution found.
 					if(first_iteration){
-						Log_par(
-							"[FOUND] Chromatic number "
-							"found (very first computation at root): " + std::to_string(current_lb), current.depth);
+						LOG_EVENT(_log, FOUND_AT_ROOT, current.depth, current_lb);
 						_best_ub.store(current_ub);
 
 						UpdateCurrentBest(current.depth, current.lb, current.ub, std::move(current_G->Clone()));
 
-						MPI_Send(&current_ub, 1, MPI_UNSIGNED_SHORT, 0, TAG_SOLUTION_FOUND, MPI_COMM_WORLD);
+						MPI_Send(&current_ub, 1, MPI_UNSIGNED_SHORT, 0, TAG_SOLUTION_FOUND, _comm);
+						current.g = std::move(current_G);
+						sendBranch(current, 0, TAG_SOLUTION_FOUND, _comm);
 						break;
 					}
 					// If not at root (original graph, first iteration), prune .
@@ -565,34 +1081,81 @@ int BranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds,
 						UpdateCurrentBest(current.depth, current.lb, current.ub, std::move(current_G->Clone()));
 					}
 
-					Log_par(
-						"[PRUNE] Branch pruned at "
-						"depth " + std::to_string(current.depth) +
-						": lb = " + std::to_string(current_lb) +
-						" == ub = " + std::to_string(current_ub),
-						current.depth);
+					SolverStats::Count(StatCounter::PRUNED_BOUNDS);
+					LOG_EVENT(_log, PRUNE_EQUAL, current.depth, current.depth, current_lb, current_ub);
 					continue;
 				}
 
 				// Prune
 				if (current_lb >= _best_ub.load()) {
-					Log_par(
-						"[PRUNE] Branch pruned at "
-						"depth " + std::to_string(current.depth) +
-						": lb = " + std::to_string(current_lb) +
-						" >= best_ub = " + std::to_string(_best_ub.load()),
-						current.depth);
+					SolverStats::Count(StatCounter::PRUNED_BEST);
+					LOG_EVENT(_log, PRUNE_BEST, current.depth, current.depth, current_lb, _best_ub.load());
 					continue;
 				}
 
+				// In decision mode only the core is branched on. The target may have dropped
+				// since the node was bounded, so it is peeled again
+				GraphPtr core;
+				std::vector<int> peeled;
+				if ( _decision_mode ) {
+					unsigned short target_ub;
+					core = PeelToTarget(*current_G, peeled, target_ub);
+					if ( core->GetNumVertices() == 0 ) {
+						if ( target_ub < _best_ub.load() ) {
+							_best_ub.store(target_ub);
+
+							UpdateCurrentBest(current.depth, current.lb, target_ub, std::move(current_G->Clone()));
+							LOG_EVENT(_log, UPDATE_UB, current.depth, _best_ub.load());
+						}
+						// the node goes back to the queue, to be asked with the lower target
+						current.g  = std::move(current_G);
+						current.ub = target_ub;
+						std::lock_guard<std::mutex> lock(queue_mutex);
+						queue.push(std::move(current));
+						continue;
+					}
+					if ( peeled.empty() ) {
+						core.reset();	// same as the node, which keeps the order of its vertices
+					}
+				}
+
+				// Small nodes, or close to the incumbent, are decided by the SAT backend
+				if ( UseSat(core ? *core : *current_G, current_lb) ) {
+					Graph& residual = core ? *core : *current_G;
+					int target = _best_ub.load() - 1;
+					CDCLSolver::Result result = SatColor(residual, target, _clique_strat.FindCliqueVertices(residual), _sat_conflicts);
+					if ( result == CDCLSolver::Result::UNSAT ) {
+						LOG_EVENT(_log, SAT_UNSAT, current.depth, target);
+						continue;
+					}
+					if ( result == CDCLSolver::Result::SAT ) {
+						unsigned short sat_ub = ColorFromCore(*current_G, residual, peeled);
+						if ( sat_ub < _best_ub.load() ) {
+							_best_ub.store(sat_ub);
+
+							UpdateCurrentBest(current.depth, current.lb, sat_ub, std::move(current_G->Clone()));
+							LOG_EVENT(_log, SAT_UB, current.depth, _best_ub.load());
+						}
+						// the node goes back to the queue, to be asked with the lower target
+						current.g  = std::move(current_G);
+						current.ub = sat_ub;
+						std::lock_guard<std::mutex> lock(queue_mutex);
+						queue.push(std::move(current));
+						continue;
+					}
+				}
+
 				// Start branching 
                 //std::unique_lock<std::mutex> lock_branching(branching_mutex);
                 int u, v;
-                std::tie(u, v) = _branching_strat.ChooseVertices(*current_G);
+                std::tie(u, v) = chooseVertices(_branching_strat, core ? *core : *current_G);
                 //lock_branching.unlock();
-                Log_par("[BRANCH] Branching on vertices: u = " + std::to_string(u) +
-                        ", v = " + std::to_string(v),
-                        current.depth);
+                LOG_EVENT(_log, BRANCH_VERTICES, current.depth, u, v);
+
+                if ( core && (u == -1 || v == -1) ) {
+					// the core is a clique with at least best_ub vertices
+					continue;
+				}
 
                 if (u == -1 || v == -1) {
 					if ( current_G->GetNumVertices() < _best_ub.load() ) {
@@ -605,47 +1168,49 @@ int BranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds,
 
                 //std::unique_lock<std::mutex> lock_task(task_mutex);
 				
-                if (current.depth < my_rank+1) {
-					// Keep adding edges for the first `my_rank` levels
+                if (current.depth < group_rank+1) {
+					// Keep adding edges for the first `group_rank` levels
 					auto G_new = current_G->Clone();
 					G_new->AddEdge(u, v);
-					int lb2 = _clique_strat.FindClique(*G_new);
-					_color_strat.Color(*G_new, ub2);
+					if ( current.depth <= _symmetry_depth ) {
+						int added = AddSymmetricEdges(*current_G, *G_new, u, v);
+						LOG_EVENT(_log, SYMMETRY, current.depth, added);
+					}
+					int lb2;
+					if ( BoundChild(*G_new, u, v, lb2, ub2) ) {
+						LOG_EVENT(_log, ADD_EDGE, current.depth, current.depth, lb2, ub2);
 					
-					Log_par("[Add Edge] depth " + std::to_string(current.depth) + 
-							", lb = " + std::to_string(lb2) + 
-							", ub = " + std::to_string(ub2), current.depth);
-				
-					{
 						std::lock_guard<std::mutex> lock(queue_mutex);
 						queue.push(Branch(std::move(G_new), lb2, ub2, current.depth + 1));
+					} else {
+						LOG_EVENT(_log, NOGOOD_ADD_EDGE, current.depth);
 					}
-				} else if (current.depth == my_rank+1) {
-					// Merge vertices once when `current.depth == my_rank`
+				} else if (current.depth == group_rank+1) {
+					// Merge vertices once when `current.depth == group_rank`
 					auto G_merge = current_G->Clone();
 					G_merge->MergeVertices(u, v);
-					lb1 = _clique_strat.FindClique(*G_merge);
-					_color_strat.Color(*G_merge, ub1);
-				
-					Log_par("[Merge] depth " + std::to_string(current.depth) + 
-							", lb = " + std::to_string(lb1) + 
-							", ub = " + std::to_string(ub2), current.depth);
-				
-					{
+					if ( BoundChild(*G_merge, u, v, lb1, ub1) ) {
+						LOG_EVENT(_log, MERGE, current.depth, current.depth, lb1, ub2);
+					
 						std::lock_guard<std::mutex> lock(queue_mutex);
 						queue.push(Branch(std::move(G_merge), lb1, ub1, current.depth + 1));
+					} else {
+						LOG_EVENT(_log, NOGOOD_MERGE, current.depth);
 					}
 				} else {
 					// After merging, branch in both directions
 					auto G1 = current_G->Clone();
 					G1->MergeVertices(u, v);
-					lb1 = _clique_strat.FindClique(*G1);
-					_color_strat.Color(*G1, ub1);
+					bool keep1 = BoundChild(*G1, u, v, lb1, ub1);
 				
 					auto G2 = current_G->Clone();
 					G2->AddEdge(u, v);
-					int lb2 = _clique_strat.FindClique(*G2);
-					_color_strat.Color(*G2, ub2);
+					if ( current.depth <= _symmetry_depth ) {
+						int added = AddSymmetricEdges(*current_G, *G2, u, v);
+						LOG_EVENT(_log, SYMMETRY, current.depth, added);
+					}
+					int lb2;
+					bool keep2 = BoundChild(*G2, u, v, lb2, ub2);
 
 					// Update local sbest_ub
 					unsigned short previous_best_ub = _best_ub.load();
@@ -653,20 +1218,20 @@ int BranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds,
 						_best_ub.store(ub1);
 
 						UpdateCurrentBest(current.depth, lb1, ub1, std::move(G1->Clone()));
-						Log_par("[UPDATE] Updated best_ub: " + std::to_string(_best_ub.load()), current.depth);
+						LOG_EVENT(_log, UPDATE_UB, current.depth, _best_ub.load());
 					} else if ( ub2 < previous_best_ub ) {
 						_best_ub.store(ub2);
 
 						UpdateCurrentBest(current.depth, lb2, ub2, std::move(G2->Clone()));
-						Log_par("[UPDATE] Updated best_ub: " + std::to_string(_best_ub.load()), current.depth);
+						LOG_EVENT(_log, UPDATE_UB, current.depth, _best_ub.load());
 					}
 
-					// pushing new branches in the queue
-					{
+					// pushing new branches in the queue, unless a nogood pruned them
+					if ( keep1 ) {
 						std::lock_guard<std::mutex> lock(queue_mutex);
 						queue.push(Branch(std::move(G1), lb1, ub1, current.depth + 1));
 					}
-					{
+					if ( keep2 ) {
 						std::lock_guard<std::mutex> lock(queue_mutex);
 						queue.push(Branch(std::move(G2), lb2, ub2, current.depth + 1));
 					}
@@ -679,8 +1244,23 @@ int BranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds,
 			}
 		}
 		}
-		Log_par("[TERMINATION] Finalizing... ", 0);
-		MPI_Barrier(MPI_COMM_WORLD);
+		if ( _nogoods ) {
+			LOG_EVENT(_log, NOGOODS_KEPT, 0, _nogoods->GetNumNogoods(), _nogoods->GetNumHits());
+		}
+		LOG_EVENT(_log, FINALIZING, 0);
+		_log.Flush();
+		MPI_Barrier(_comm);
+		if ( _status_server ) {
+			// the last snapshot stays served, as finished
+			StatusSnapshot snapshot = _status_server->Snapshot();
+			snapshot.running = false;
+			snapshot.best_ub = _best_ub.load();
+			snapshot.global_lb = _global_lb.load();
+			_status_server->Publish(snapshot);
+		}
+		MPI_Comm_free(&_group_comm);
+		MPI_Comm_free(&_gather_comm);
+		MPI_Comm_free(&_comm);
 		// End execution
 		return _best_ub;
 	}
@@ -694,7 +1274,9 @@ void BalancedBranchNBoundPar::ColorInitialGraph(Graph &graph_to_color, const Bra
 {
 	std::vector<int> vertices 						  = optimal_branch.g->GetVertices();
 	std::vector<unsigned short> optimal_full_coloring = optimal_branch.g->GetFullColoring();
-	std::vector<unsigned short> full_coloring(graph_to_color.GetNumVertices()+1);
+	// vertices are labels, which may exceed the number of vertices (e.g. after removals)
+	std::vector<unsigned short> full_coloring(std::max<size_t>(graph_to_color.GetHighestVertex()+1, 
+															   optimal_full_coloring.size()));
 	for ( int vertex : vertices ) {
 		// coloring the vertex...
 		full_coloring[vertex] = optimal_full_coloring[vertex];
@@ -708,6 +1290,72 @@ void BalancedBranchNBoundPar::ColorInitialGraph(Graph &graph_to_color, const Bra
 	graph_to_color.SetFullColoring(full_coloring);
 }
 
+GraphPtr BalancedBranchNBoundPar::PeelToTarget(Graph &g, std::vector<int> &peeled, unsigned short &ub)
+{
+	GraphPtr core = g.Clone();
+	peeled = PeelKCore(*core, _best_ub.load() - 1);
+	if ( core->GetNumVertices() == 0 ) {
+		std::vector<unsigned short> full_coloring(g.GetHighestVertex() + 1, 0);
+		ub = ExtendCoreColoring(g, peeled, full_coloring);
+		g.SetFullColoring(full_coloring);
+	}
+	return core;
+}
+
+void BalancedBranchNBoundPar::BoundNode(Graph &g, int &lb, unsigned short &ub)
+{
+	std::vector<int> peeled;
+	GraphPtr core = _decision_mode ? PeelToTarget(g, peeled, ub) : nullptr;
+	if ( peeled.empty() ) {
+		lb = _clique_strat.FindClique(g);
+		_color_strat.Color(g, ub);
+		return;
+	}
+	if ( core->GetNumVertices() == 0 ) {
+		lb = 1;	// no clique reaches the target, the node is only kept for lower ones
+		return;
+	}
+
+	// a clique with best_ub vertices, the only one that prunes, is never peeled
+	lb = _clique_strat.FindClique(*core);
+	_color_strat.Color(*core, ub);
+	ub = ColorFromCore(g, *core, peeled);
+}
+
+unsigned short BalancedBranchNBoundPar::ColorFromCore(Graph &g, const Graph &core, const std::vector<int> &peeled)
+{
+	// the coloring of the core only covers its own labels
+	std::vector<unsigned short> core_coloring = core.GetFullColoring();
+	std::vector<unsigned short> full_coloring(g.GetHighestVertex() + 1, 0);
+	for ( int vertex : core.GetVertices() ) {
+		full_coloring[vertex] = core_coloring[vertex];
+	}
+	unsigned short num_colors = ExtendCoreColoring(g, peeled, full_coloring);
+	g.SetFullColoring(full_coloring);
+	return num_colors;
+}
+
+bool BalancedBranchNBoundPar::UseSat(const Graph &residual, int lb) const
+{
+	return ( _sat_max_vertices > 0 && residual.GetNumVertices() <= (size_t)_sat_max_vertices ) ||
+		   ( _sat_max_gap > 0 && _best_ub.load() - lb <= _sat_max_gap );
+}
+
+bool BalancedBranchNBoundPar::BoundChild(Graph &child, int u, int v, int &lb, unsigned short &ub)
+{
+	if ( _nogoods && _nogoods->Prunes(child, u, v, _best_ub.load()) ) {
+		lb = _best_ub.load();
+		ub = USHRT_MAX;
+		return false;
+	}
+	BoundNode(child, lb, ub);
+	// lb > 1: a clique was searched, the node was not emptied by peeling
+	if ( _nogoods && lb > 1 && lb >= _best_ub.load() ) {
+		_nogoods->Record(_clique_strat.GetClique());
+	}
+	return true;
+}
+
 void BalancedBranchNBoundPar::UpdateCurrentBest(int depth, int lb, unsigned short ub, GraphPtr graph)
 {
     std::lock_guard<std::mutex> lock(_best_branch_mutex);
@@ -717,6 +1365,7 @@ void BalancedBranchNBoundPar::UpdateCurrentBest(int depth, int lb, unsigned shor
 	best.ub = ub;
 	best.g = std::move(graph);
 	_current_best = std::move(best);
+	_incumbent_time = MPI_Wtime() - _solve_start_time;
 }
 
 
@@ -733,29 +1382,34 @@ bool BalancedBranchNBoundPar::CheckTimeout(
 }
 
 
-void BalancedBranchNBoundPar::Log_par(const std::string& message, int depth) {
-	if ( !_logging_flag ) return;
-    std::lock_guard<std::mutex> lock(log_mutex);
-    if (_log_file.is_open()) {
-        // Get the current MPI walltime
-        double timestamp = MPI_Wtime();
+unsigned short BalancedBranchNBoundPar::SeedInitialColoring(const Graph& g)
+{
+	_best_ub.store(USHRT_MAX);
+	{
+		std::lock_guard<std::mutex> lock(_best_branch_mutex);
+		_current_best = Branch();
+		_incumbent_time = -1;
+	}
+	if ( _initial_coloring.empty() ) {
+		return USHRT_MAX;
+	}
 
-        // Indentation based on depth
-        std::string indentation(depth * 2, ' ');
+	unsigned short ub = 0;
+	for ( int vertex : g.GetVertices() ) {
+		ub = std::max(ub, _initial_coloring[vertex]);
+	}
 
-        int rank;
-        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-        int thread_id = omp_get_thread_num();
+	auto colored = g.Clone();
+	colored->SetFullColoring(_initial_coloring);
+	_best_ub.store(ub);
+	UpdateCurrentBest(0, 0, ub, std::move(colored));
+	LOG_EVENT(_log, INIT_COLORING, 0, ub);
 
-        // Log the message with the timestamp
-        _log_file << indentation << "[Rank " << rank
-                      << " | Thread " << thread_id << "] "
-                      << "[Time " << timestamp << "] " << message << std::endl;
-    }
+	return ub;
 }
 
 
-void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global_start_time, 
+void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, double global_start_time, 
 	int timeout_seconds, double &optimum_time,
 	Graph& graph_to_color) {
 	int solution_found = 0;
@@ -773,16 +1427,16 @@ void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global
 			// Check if timeout is reached, broadcast timeout signal
 			if (MPI_Wtime() - global_start_time >= timeout_seconds) {
 				timeout_signal = 1;
-				Log_par("[TERMINATION]: Timeout reached.", 0);
+				LOG_EVENT(_log, TIMEOUT, 0);
 			}
 
-			MPI_Iprobe(MPI_ANY_SOURCE, TAG_SOLUTION_FOUND, MPI_COMM_WORLD, &flag_solution, &status_solution);
+			MPI_Iprobe(MPI_ANY_SOURCE, TAG_SOLUTION_FOUND, _comm, &flag_solution, &status_solution);
 			// Check if a solution is being communicated
 			if (flag_solution) {
 				unsigned short solution = 0;
 				MPI_Request recv_request;
 				MPI_Status recv_status;
-				MPI_Irecv(&solution, 1, MPI_UNSIGNED_SHORT, status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, MPI_COMM_WORLD, &recv_request);
+				MPI_Irecv(&solution, 1, MPI_UNSIGNED_SHORT, status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, _comm, &recv_request);
 				_best_ub.store(solution);
 
 				int completed = 0;
@@ -794,14 +1448,20 @@ void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global
 				}
 
 				//Branch optimal_branch = Branch::deserialize(buffer);
-				Branch optimal_branch = recvBranch(status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, MPI_COMM_WORLD);
+				Branch optimal_branch = recvBranch(status_solution.MPI_SOURCE, TAG_SOLUTION_FOUND, _comm);
 
 				ColorInitialGraph(graph_to_color, optimal_branch);
 
 				_best_ub.store(optimal_branch.ub);
-
-				solution_found = 1;
-				Log_par("[TERMINATION]: Solution found communicated.", 0);
+				_incumbent_rank = status_solution.MPI_SOURCE;
+				// the worker also stops at a coloring which meets a lower bound, which is a proof:
+				// only reaching the expected chromatic number is not
+				bool bound_met = optimal_branch.ub <= std::max(_known_lb, _global_lb.load()) || 
+								 (optimal_branch.depth == 0 && optimal_branch.lb >= optimal_branch.ub);
+				_outcome = bound_met ? SolveOutcome::PROVEN : SolveOutcome::EXPECTED;
+
+				solution_found = FOUND_EXPECTED;
+				LOG_EVENT(_log, SOLUTION_COMMUNICATED, 0);
 				optimum_time = MPI_Wtime() - global_start_time;
 
 			}
@@ -809,7 +1469,7 @@ void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global
 			// Listen for idle status updates from workers
 			while (true) {
 			int flag_idle = 0;
-			MPI_Iprobe(MPI_ANY_SOURCE, TAG_IDLE, MPI_COMM_WORLD, &flag_idle, &status_idle);
+			MPI_Iprobe(MPI_ANY_SOURCE, TAG_IDLE, _comm, &flag_idle, &status_idle);
 
 			if (!flag_idle) break;
 
@@ -819,7 +1479,7 @@ void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global
 
 
 			MPI_Request recv_request;
-			MPI_Irecv(&worker_idle_status, 1, MPI_INT, status_idle.MPI_SOURCE, TAG_IDLE, MPI_COMM_WORLD, &recv_request);
+			MPI_Irecv(&worker_idle_status, 1, MPI_INT, status_idle.MPI_SOURCE, TAG_IDLE, _comm, &recv_request);
 
 			int completed = 0;
 			MPI_Status status_sol_completed;
@@ -832,35 +1492,55 @@ void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global
 			if(completed) idle_status[status_idle.MPI_SOURCE] = worker_idle_status;
 			}
 
-			// Check if all workers are idle
-			if (std::all_of(idle_status.begin(), idle_status.end(), [](int status) { return status == 1; })) {
-			solution_found = 1;
+			// Check if all workers of a group are idle
+			int idle_group = idleGroup(idle_status, _group_of_rank);
+			if (idle_group != -1) {
+			solution_found = FOUND_ALL_IDLE;
+			_proof_group = idle_group;
+			// the tree is not exhausted when a branch stopped at the expected chromatic number
+			if (_outcome != SolveOutcome::EXPECTED) _outcome = SolveOutcome::PROVEN;
+			optimum_time = MPI_Wtime() - global_start_time;
+			LOG_EVENT(_log, GROUP_IDLE, 0, idle_group);
+			}
+
+			// Check if the best coloring meets the lower bound
+			if (!solution_found && _best_ub.load() <= std::max(_known_lb, _global_lb.load())) {
+			solution_found = FOUND_BOUND;
+			_outcome = SolveOutcome::PROVEN;
 			optimum_time = MPI_Wtime() - global_start_time;
-			Log_par("[TERMINATION]: All processes idle.", 0);
+			LOG_EVENT(_log, BOUND_MET, 0);
 			}
 
 		}
 		// Worker nodes listen for termination signals (solution or timeout)
-		MPI_Bcast(&solution_found, 1, MPI_INT, 0, MPI_COMM_WORLD);
-		MPI_Bcast(&timeout_signal, 1, MPI_INT, 0, MPI_COMM_WORLD);
+		MPI_Bcast(&solution_found, 1, MPI_INT, 0, _comm);
+		MPI_Bcast(&timeout_signal, 1, MPI_INT, 0, _comm);
 
-		// Exit if solution or timeout is detected
-		if ( timeout_signal ) {
+		// Gather the incumbents when the search stopped without a branch reaching the expected chi
+		if ( timeout_signal || solution_found == FOUND_ALL_IDLE || solution_found == FOUND_BOUND ) {
 			if ( my_rank == 0 ) {
-				bool found = false;
 				Branch best_branch;
+				int best_rank = 0;
+				{
+					std::lock_guard<std::mutex> lock(_best_branch_mutex);
+					best_branch = std::move(_current_best);
+				}
 				for ( int i = 1; i < p; i++ ) {
-					Branch b = recvBranch(i, TAG_TIMEOUT_SOLUTION, MPI_COMM_WORLD);
-					if ( (!found || b.ub < best_branch.ub ) && b.ub <= _best_ub.load() ) {
-						_best_ub.store(b.ub);
-						best_branch = b;
+					Branch b = recvBranch(i, TAG_TIMEOUT_SOLUTION, _comm);
+					if ( b.g && (!best_branch.g || b.ub < best_branch.ub) ) {
+						best_branch = std::move(b);
+						best_rank = i;
 					}
 				}
-				
-				ColorInitialGraph(graph_to_color, best_branch);
+
+				if ( best_branch.g ) {
+					_incumbent_rank = best_rank;
+					_best_ub.store(best_branch.ub);
+					ColorInitialGraph(graph_to_color, best_branch);
+				}
 			} else {
     			std::lock_guard<std::mutex> lock(_best_branch_mutex);
-				sendBranch(_current_best, 0, TAG_TIMEOUT_SOLUTION, MPI_COMM_WORLD);
+				sendBranch(_current_best, 0, TAG_TIMEOUT_SOLUTION, _comm);
 			}
 		}
 
@@ -873,6 +1553,16 @@ void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global
 	}
 }
 
+void BalancedBranchNBoundPar::LearnNogoods(const std::vector<int>& all)
+{
+	// the nogoods of this rank are already known and skipped
+	int learnt = 0;
+	for ( size_t i = 0; i < all.size(); i += all[i] + 1 ) {
+		learnt += _nogoods->Record(std::vector<int>(all.begin() + i + 1, all.begin() + i + 1 + all[i]));
+	}
+	LOG_EVENT(_log, NOGOODS_LEARNT, 0, learnt);
+}
+
 /**
 * thread_1_solution_gatherer - Periodically gathers the best upper bound
 * (best_ub) from all worker processes and updates the global best_ub. This
@@ -888,94 +1578,231 @@ void BalancedBranchNBoundPar::thread_0_terminator(int my_rank, int p, int global
 *   p (int)           : The number of processes in the MPI communicator.
 *   best_ub (int*)    : Pointer to the variable holding the best upper bound.
 */
-void BalancedBranchNBoundPar::thread_1_solution_gatherer(int p, int sol_gather_period) { 
-	std::vector<unsigned short> all_best_ub(p);
-	auto last_gather_time = MPI_Wtime();
-	MPI_Request request;
-	int request_active = 0;
+void BalancedBranchNBoundPar::GatherProgress(int p, const std::vector<double>& all_fields)
+{
+	int my_rank;
+	MPI_Comm_rank(_comm, &my_rank);
+
+	// the root estimates are averaged, the ranks of this group are listed in the order of 
+	// their group ranks, which follows the ranks in _comm
+	ProgressEstimate progress;
+	std::vector<double> group_remaining;
+	int my_group = _group_of_rank.empty() ? 0 : _group_of_rank[my_rank];
+	int root_estimates = 0;
+	for ( int i = 0; i < p; i++ ) {
+		const double* fields = &all_fields[GATHER_FIELDS*i];
+		progress.explored += fields[GATHER_EXPLORED];
+		if ( fields[GATHER_REMAINING] < 0 || progress.remaining < 0 ) {
+			progress.remaining = -1;
+		} else {
+			progress.remaining += fields[GATHER_REMAINING];
+		}
+		if ( fields[GATHER_ROOT_TREE] > 0 ) {
+			progress.tree_size += fields[GATHER_ROOT_TREE];
+			root_estimates++;
+		}
+		if ( (_group_of_rank.empty() ? 0 : _group_of_rank[i]) == my_group ) {
+			group_remaining.push_back(fields[GATHER_REMAINING]);
+		}
+	}
+	if ( root_estimates > 0 ) {
+		progress.tree_size /= root_estimates;
+	}
+	{
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		_progress = progress;
+		_group_remaining = group_remaining;
+	}
 
-	while (!terminate_flag.load(std::memory_order_relaxed)) {
-		auto current_time = MPI_Wtime();
-		auto elapsed_time = current_time - last_gather_time;
+	if ( my_rank == 0 ) {
+		std::cout << "[PROGRESS] " << (int) (MPI_Wtime() - _solve_start_time) << " s: " 
+				  << progress.explored << " nodes explored, ";
+		if ( progress.remaining < 0 ) {
+			std::cout << "no estimate of the nodes left yet";
+		} else {
+			double done = 100.0 * progress.explored / std::max(1.0, progress.explored + progress.remaining);
+			std::cout << "~" << formatEstimate(progress.remaining) << " left below the queued nodes (" 
+					  << (int) done << "% done)";
+		}
+		if ( progress.tree_size > 0 ) {
+			std::cout << ", root probes ~" << formatEstimate(progress.tree_size) << " nodes";
+		}
+		std::cout << std::endl;
+	}
+}
 
-		if (elapsed_time >= sol_gather_period) {
-			unsigned short local_best_ub = _best_ub.load(); // safe read
+void BalancedBranchNBoundPar::GatherStatus(int p, const std::vector<double>& all_fields)
+{
+	int my_rank;
+	MPI_Comm_rank(_comm, &my_rank);
+	if ( my_rank != 0 || _status_server == nullptr ) {
+		return;
+	}
 
-		if (terminate_flag.load(std::memory_order_relaxed)) {
-			return;
+	StatusSnapshot snapshot;
+	double now = MPI_Wtime();
+	snapshot.running = true;
+	snapshot.elapsed = now - _solve_start_time;
+	snapshot.best_ub = _best_ub.load();
+	snapshot.global_lb = _global_lb.load();
+	long steals = 0;
+	for ( int i = 0; i < p; i++ ) {
+		const double* fields = &all_fields[GATHER_FIELDS*i];
+		snapshot.ranks.push_back(RankStatus{(long) fields[GATHER_EXPLORED], (long) fields[GATHER_QUEUE], 
+											(long) fields[GATHER_STEALS]});
+		snapshot.nodes += (long) fields[GATHER_EXPLORED];
+		steals += (long) fields[GATHER_STEALS];
+	}
+	double interval = now - _last_status_time;
+	if ( interval > 0 ) {
+		snapshot.nodes_per_second = (snapshot.nodes - _last_status_nodes) / interval;
+		snapshot.steals_per_second = (steals - _last_status_steals) / interval;
 	}
+	_last_status_time = now;
+	_last_status_nodes = snapshot.nodes;
+	_last_status_steals = steals;
+	if ( _estimate_progress ) {
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		snapshot.estimated = true;
+		snapshot.progress = _progress;
+	}
+	_status_server->Publish(snapshot);
+}
 
-	// Start non-blocking allgather
-	MPI_Iallgather(&local_best_ub, 1, MPI_UNSIGNED_SHORT, all_best_ub.data(), 1, MPI_UNSIGNED_SHORT, MPI_COMM_WORLD, &request);
-	request_active = 1;
+void BalancedBranchNBoundPar::thread_4_estimator(const Graph& root, std::mutex& queue_mutex, BranchQueue& queue)
+{
+	// the probes are not part of the search, nor are their clones, cliques and colorings
+	SolverStats::SetCounted(false);
+	TreeSizeEstimator estimator;
+	Xoshiro256& random = ThreadRandom::Get();
+	bool from_root = true;
 
-	// Wait for completion with timeout handling (or simply test it periodically)
-	MPI_Status status;
-	while (true) {
-	int flag = 0;
-	MPI_Test(&request, &flag, &status);
-	if (flag) break;  // The operation is completed
+	while (!terminate_flag.load(std::memory_order_relaxed)) {
+		auto probe_start = std::chrono::steady_clock::now();
+		unsigned short best_ub = _best_ub.load();
+		if ( from_root ) {
+			double estimate = estimator.Probe(root, best_ub, terminate_flag);
+			std::lock_guard<std::mutex> lock(_estimate_mutex);
+			if ( estimate >= 0 ) {
+				_root_probes.Add(estimate);
+			}
+		} else {
+			GraphPtr node;
+			size_t frontier_size;
+			{
+				std::lock_guard<std::mutex> lock(queue_mutex);
+				frontier_size = queue.size();
+				if ( frontier_size > 0 ) {
+					node = queue.at(random.Below(frontier_size)).g->Clone();
+				}
+			}
+			{
+				std::lock_guard<std::mutex> lock(_estimate_mutex);
+				_frontier_size = frontier_size;
+			}
+			double estimate = node ? estimator.Probe(*node, best_ub, terminate_flag) : -1;
+			std::lock_guard<std::mutex> lock(_estimate_mutex);
+			if ( estimate >= 0 ) {
+				_frontier_probes.Add(estimate);
+			}
+		}
+		from_root = !from_root;
 
-	// If termination flag is set, cancel the request to avoid deadlock
-	if (terminate_flag.load(std::memory_order_relaxed)) {
-	if (request_active && flag) {
-	MPI_Cancel(&request);
-	MPI_Request_free(&request);
+		// only spare cycles: as long idle as busy, in short sleeps not to hold up the termination
+		auto now = std::chrono::steady_clock::now();
+		auto idle_until = now + std::max<std::chrono::steady_clock::duration>(now - probe_start, std::chrono::milliseconds(10));
+		while ( !terminate_flag.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < idle_until ) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
 	}
-	return;
+	SolverStats::SetCounted(true);
+}
+
+bool BalancedBranchNBoundPar::GatherRound(int p, bool stopped, std::mutex& queue_mutex, BranchQueue& queue)
+{
+	// flattened as size, vertices, size, vertices...
+	std::vector<int> nogoods;
+	if ( _nogoods && _nogood_share > 0 && !stopped ) {
+		for ( const std::vector<int>& nogood : _nogoods->MostUsed(_nogood_share) ) {
+			nogoods.push_back(nogood.size());
+			nogoods.insert(nogoods.end(), nogood.begin(), nogood.end());
+		}
+	}
+	std::vector<double> local(GATHER_FIELDS, 0);
+	local[GATHER_UB] = _best_ub.load();
+	local[GATHER_LB] = _global_lb.load();
+	local[GATHER_STOPPED] = stopped;
+	local[GATHER_NOGOODS] = nogoods.size();
+	local[GATHER_EXPLORED] = _nodes_explored.load();
+	if ( _estimate_progress ) {
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		local[GATHER_ROOT_TREE] = _root_probes.Mean();
+		// unknown (-1) until a queued node was probed, or at least the queue found empty
+		local[GATHER_REMAINING] = _frontier_size == 0 ? 0 : 
+								  _frontier_size < 0 || _frontier_probes.count == 0 ? -1 : 
+								  _frontier_size * _frontier_probes.Mean();
+	}
+	if ( _report_status ) {
+		{
+			std::lock_guard<std::mutex> lock(queue_mutex);
+			local[GATHER_QUEUE] = queue.size();
+		}
+		local[GATHER_STEALS] = _steals_received.load();
 	}
 
-	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	std::vector<double> all;
+	std::vector<int> all_nogoods;
+	// the terminator settles the final bounds and incumbent, which are left alone
+	if ( !gatherRound(local, nogoods, _nogoods && _nogood_share > 0, all, all_nogoods, _gather_comm) ) {
+		return false;
 	}
-	request_active = 0;
 
 	// Update the best upper bound for other threads in shared memory
-	Log_par("[UPDATE] Gathered best_ub " + std::to_string(_best_ub), 0);
-	_best_ub.store(*std::min_element(all_best_ub.begin(), all_best_ub.end()));  // safe write
-
-	// Reset the timer
-	last_gather_time = current_time;
+	LOG_EVENT(_log, GATHERED_UB, 0, _best_ub);
+	unsigned short gathered_ub = USHRT_MAX, gathered_lb = 0;
+	for ( int i = 0; i < p; i++ ) {
+		gathered_ub = std::min(gathered_ub, (unsigned short) all[GATHER_FIELDS*i + GATHER_UB]);
+		gathered_lb = std::max(gathered_lb, (unsigned short) all[GATHER_FIELDS*i + GATHER_LB]);
 	}
-
-	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	_best_ub.store(gathered_ub);
+	_global_lb.store(std::max(_global_lb.load(), gathered_lb));
+	if ( _nogoods && _nogood_share > 0 ) {
+		LearnNogoods(all_nogoods);
+	}
+	if ( _estimate_progress ) {
+		GatherProgress(p, all);
 	}
-	if (request_active) {
-		MPI_Cancel(&request);
-		MPI_Request_free(&request);
+	if ( _report_status ) {
+		GatherStatus(p, all);
 	}
+	return true;
 }
 
+void BalancedBranchNBoundPar::thread_1_solution_gatherer(int p, int sol_gather_period, std::mutex& queue_mutex,
+														 BranchQueue& queue) { 
+	auto last_gather_time = MPI_Wtime();
 
-void BalancedBranchNBoundPar::thread_2_employer(std::mutex& queue_mutex, BranchQueue& queue) {
-	MPI_Status status;
-	int request_signal = 0;
-	MPI_Request request;
-
-	while (!terminate_flag.load(std::memory_order_relaxed)) {
-		MPI_Iprobe(MPI_ANY_SOURCE, TAG_WORK_REQUEST, MPI_COMM_WORLD, &request_signal, &status);
-		if (request_signal) {
-			int destination_rank = status.MPI_SOURCE;
-			int response = 0;
-
-			std::lock_guard<std::mutex> lock(queue_mutex);
-			if (queue.size() > 1) {
-				response = 1;
-				Branch branch = std::move(const_cast<Branch&>(queue.top()));
-				queue.pop();
-
-				MPI_Isend(&response, 1, MPI_INT, destination_rank, TAG_WORK_RESPONSE, MPI_COMM_WORLD, &request);
-				MPI_Request_free(&request);
-				sendBranch(branch, destination_rank, TAG_WORK_STEALING, MPI_COMM_WORLD);
-			} else {
-				MPI_Isend(&response, 1, MPI_INT, destination_rank, TAG_WORK_RESPONSE, MPI_COMM_WORLD, &request);
-				MPI_Request_free(&request);
-			}
+	// once the search terminated on this rank, a last round is started at once, which tells the
+	// others; no rank leaves before every collective it started completed
+	bool running = true;
+	while ( running ) {
+		bool stopped = terminate_flag.load(std::memory_order_relaxed);
+		auto current_time = MPI_Wtime();
+		if ( !stopped && current_time - last_gather_time < sol_gather_period ) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			continue;
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		running = GatherRound(p, stopped, queue_mutex, queue);
+		last_gather_time = current_time;
 	}
 }
 
 
+void BalancedBranchNBoundPar::thread_2_employer(std::mutex& queue_mutex, BranchQueue& queue) {
+	serveWorkRequests(queue_mutex, queue, _group_comm);
+}
+
+
 
 int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_seconds, int sol_gather_period, 
 								   unsigned short expected_chi) {
@@ -984,12 +1811,53 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 
 	optimum_time  = -1.0;
 	terminate_flag.store(false);
+	_incumbent_rank = -1;
+	_proof_group    = -1;
+	_outcome        = SolveOutcome::TIMEOUT;
+	_global_lb.store(0);
+	_solve_start_time = global_start_time;
+	_nodes_explored.store(0);
+	_steals_received.store(0);
+	_last_status_time = global_start_time;
+	_last_status_nodes = 0;
+	_last_status_steals = 0;
+	{
+		std::lock_guard<std::mutex> lock(_estimate_mutex);
+		_root_probes = ProbeMean();
+		_frontier_probes = ProbeMean();
+		_frontier_size = -1;
+		_group_remaining.clear();
+		_progress = ProgressEstimate();
+	}
+
+	unsigned short initial_ub = SeedInitialColoring(g);
+	if ( (initial_ub == expected_chi && initial_ub != USHRT_MAX) || initial_ub <= _known_lb ) {
+		// the given coloring already reaches the expected chromatic number or a proven lower bound,
+		// there is nothing to search (USHRT_MAX is no coloring given, which the default 
+		// expected_chi must not match)
+		g.SetFullColoring(_initial_coloring);
+		_outcome = initial_ub <= _known_lb ? SolveOutcome::PROVEN : SolveOutcome::EXPECTED;
+		optimum_time = MPI_Wtime() - global_start_time;
+		return initial_ub;
+	}
 
-	BranchQueue queue;
+	// every Solve gets its own communicator, so messages left from a previous one are never matched
+	MPI_Comm_dup(MPI_COMM_WORLD, &_comm);
+	MPI_Comm_dup(MPI_COMM_WORLD, &_gather_comm);
+	_nogoods = _nogood_capacity > 0 ? std::make_unique<NogoodIndex>(g, _nogood_capacity) : nullptr;
+
+	BranchQueue queue(BranchOrder{_node_selection});
 	int my_rank;
 	int p;
-	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
-	MPI_Comm_size(MPI_COMM_WORLD, &p);
+	MPI_Comm_rank(_comm, &my_rank);
+	MPI_Comm_size(_comm, &p);
+
+	// the tree is split among the processes of a group, which only steal work from each other
+	MPI_Comm_split(_comm, _group_of_rank.empty() ? 0 : _group_of_rank[my_rank], my_rank, &_group_comm);
+	int group_rank;
+	int group_size;
+	MPI_Comm_rank(_group_comm, &group_rank);
+	MPI_Comm_size(_group_comm, &group_size);
 
 	// Initialize big enough best_ub for all processes.
 
@@ -997,22 +1865,33 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 	Branch branch_recv;
 	Branch initial_branch;
 
+	// the clique of the root bounds the whole graph, for every group
+	_global_lb.store(_clique_strat.FindClique(g));
+
 	// WORKLOAD BALANCEMENT
 	// binary searching the node assigned to this processor
-	int a=0, b=p-1;
+	int a=0, b=group_size-1;
 	int delta;
 	std::pair<int, int> vertices;
 	initial_branch.g = g.Clone();
 	int depth = 1;
 	while (a != b) {
 		depth++;
-		vertices = _branching_strat.ChooseVertices(*initial_branch.g);
+		vertices = chooseVertices(_branching_strat, *initial_branch.g);
+		if ( vertices.first == -1 || vertices.second == -1 ) {
+			break;	// complete graph, nothing left to split: ranks share this node
+		}
 		delta = (b+1 - a) / 2;	// half size of the interval [a, b]
-		if ( my_rank >= a + delta ) {
+		if ( group_rank >= a + delta ) {
 			initial_branch.g->MergeVertices(vertices.first, vertices.second);
 			a += delta;
 		} else {
+			// the node being split is at depth - 1
+			GraphPtr parent = ( depth - 1 <= _symmetry_depth ) ? initial_branch.g->Clone() : nullptr;
 			initial_branch.g->AddEdge(vertices.first, vertices.second);
+			if ( parent ) {
+				AddSymmetricEdges(*parent, *initial_branch.g, vertices.first, vertices.second);
+			}
 			b -= delta;
 		}
 	}
@@ -1020,8 +1899,11 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 	initial_branch.depth = depth;
 	initial_branch.lb = _clique_strat.FindClique(*initial_branch.g);
 	_color_strat.Color(*initial_branch.g, initial_branch.ub);
-	UpdateCurrentBest(depth, initial_branch.lb, initial_branch.ub, 
-					  std::move(initial_branch.g->Clone()));
+	if ( initial_branch.ub < _best_ub.load() ) {
+		_best_ub.store(initial_branch.ub);
+		UpdateCurrentBest(depth, initial_branch.lb, initial_branch.ub, 
+						  std::move(initial_branch.g->Clone()));
+	}
 
 	queue.push(std::move(initial_branch));
 
@@ -1034,18 +1916,27 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 	omp_tasks(method create_task) and add new branches to the queue -others
 	to compute the omp_tasks
 	*/
-	omp_set_num_threads(4);
+	// the probes of the estimator start from a copy of the root, the worker colors g
+	GraphPtr probe_root = _estimate_progress ? g.Clone() : nullptr;
+	omp_set_num_threads(_estimate_progress ? 5 : 4);
 	#pragma omp parallel default(shared)
 	{
 		int tid = omp_get_thread_num();
 
 		if (tid == 0) { // Checks if solution has been found or timeout. 
+			TimelineTrace::NameThread("terminator");
 			thread_0_terminator(my_rank, p, global_start_time, timeout_seconds, optimum_time, g);
 		}else if (tid == 1) { // Updates (gathers) best_ub from time to time.
-			thread_1_solution_gatherer(p, sol_gather_period);
+			TimelineTrace::NameThread("gatherer");
+			thread_1_solution_gatherer(p, sol_gather_period, queue_mutex, queue);
 		}else if (tid == 2) { // Employer thread employs workers by answering their work requests
+			TimelineTrace::NameThread("employer");
 			thread_2_employer(queue_mutex, queue);
+		}else if (tid == 4) { // Estimator thread probes the tree on spare cycles
+			TimelineTrace::NameThread("estimator");
+			thread_4_estimator(*probe_root, queue_mutex, queue);
 		}else if (tid == 3) { // TODO: Let more threads do these computations in parallel
+			TimelineTrace::NameThread("worker");
 			Branch current;
 
 			while (!terminate_flag.load()) {
@@ -1063,45 +1954,53 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 				// If no work and already passed the initial distributing phase, request work.
 				//if (!has_work && distributed_work) {
 				if (!has_work) {
+					TraceSpan idle_span("idle");
 					//#pragma omp single // Only a single thread asks for work.
 					//{
 					// Notify the root process that this worker is idle
 					int idle_status = 1;
-					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, MPI_COMM_WORLD);
+					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, _comm);
 					// Start requesting work.
 					//std::cout << "Rank: " << my_rank << " requesting work..." << std::endl;
-					Log_par("[REQUEST] Requesting work...", current.depth);
+					LOG_EVENT(_log, REQUEST_WORK, current.depth);
 					//printMessage("Rank: " + std::to_string(my_rank) + " requesting work...");
-					while (!terminate_flag.load() && !request_work(my_rank, p, queue, queue_mutex, current)) {
+					std::vector<double> steal_weights;
+					{
+						std::lock_guard<std::mutex> lock(_estimate_mutex);
+						steal_weights = _group_remaining;
+					}
+					while (!terminate_flag.load() && !request_work(group_rank, group_size, queue, queue_mutex, current, _group_comm, steal_weights)) {
 						std::this_thread::sleep_for(std::chrono::milliseconds(10));
 					}
 					// Work received. Notify the root process that this worker is not idle anymore.
 					if(terminate_flag.load()) break;
+					_steals_received.fetch_add(1, std::memory_order_relaxed);
 					idle_status = 0;
-					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, MPI_COMM_WORLD);
-					Log_par("[REQUEST] Work received.", current.depth);				
+					MPI_Send(&idle_status, 1, MPI_INT, 0, TAG_IDLE, _comm);
+					LOG_EVENT(_log, WORK_RECEIVED, current.depth);				
 					//}
 					continue;
 				}
 
+				_nodes_explored.fetch_add(1, std::memory_order_relaxed);
+				SolverStats::Count(StatCounter::NODES_PROCESSED);
+				TraceSpan node_span("evaluate node");
 				auto current_G = std::move(current.g);
 				int current_lb = current.lb;
 				unsigned short current_ub = current.ub;
 
-				Log_par("[BRANCH] Processing node: lb = " + std::to_string(current_lb) +
-				", ub = " + std::to_string(current_ub), current.depth);
+				LOG_EVENT(_log, PROCESS_NODE, current.depth, current_lb, current_ub);
 
-				if ( current_ub == expected_chi ) {
+				if ( current_ub == expected_chi || current_ub <= _known_lb ) {
+					SolverStats::Count(StatCounter::PRUNED_EXPECTED);
 					_best_ub.store(current_ub);
-					MPI_Send(&current_ub, 1, MPI_UNSIGNED_SHORT, 0, TAG_SOLUTION_FOUND, MPI_COMM_WORLD);  // check if it is correct
+					MPI_Send(&current_ub, 1, MPI_UNSIGNED_SHORT, 0, TAG_SOLUTION_FOUND, _comm);  // check if it is correct
 
 					current.g = std::move(current_G);
-					sendBranch(current, 0, TAG_SOLUTION_FOUND, MPI_COMM_WORLD);
+					sendBranch(current, 0, TAG_SOLUTION_FOUND, _comm);
 
-					Log_par(
-					"[FOUND] Chromatic number "
-					"found: " + std::to_string(current_ub),current.depth);
-					Log_par("========== END ==========", 0);
+					LOG_EVENT(_log, FOUND, current.depth, current_ub);
+					LOG_EVENT(_log, END, 0);
 					continue;
 				}
 
@@ -1111,33 +2010,80 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 
 						UpdateCurrentBest(current.depth, current.lb, current.ub, std::move(current_G->Clone()));
 					}
-					Log_par(
-					"[PRUNE] Branch pruned at "
-					"depth " + std::to_string(current.depth) +
-					": lb = " + std::to_string(current_lb) +
-					" == ub = " + std::to_string(current_ub),
-					current.depth);
+					SolverStats::Count(StatCounter::PRUNED_BOUNDS);
+					LOG_EVENT(_log, PRUNE_EQUAL, current.depth, current.depth, current_lb, current_ub);
 					continue;
 				}
 
 				// Prune
 				if (current_lb >= _best_ub.load()) {
-					Log_par(
-					"[PRUNE] Branch pruned at "
-					"depth " + std::to_string(current.depth) +
-					": lb = " + std::to_string(current_lb) +
-					" >= best_ub = " + std::to_string(_best_ub.load()),
-					current.depth);
+					SolverStats::Count(StatCounter::PRUNED_BEST);
+					LOG_EVENT(_log, PRUNE_BEST, current.depth, current.depth, current_lb, _best_ub.load());
 					continue;
 				}
 
+				// In decision mode only the core is branched on. The target may have dropped
+				// since the node was bounded, so it is peeled again
+				GraphPtr core;
+				std::vector<int> peeled;
+				if ( _decision_mode ) {
+					unsigned short target_ub;
+					core = PeelToTarget(*current_G, peeled, target_ub);
+					if ( core->GetNumVertices() == 0 ) {
+						if ( target_ub < _best_ub.load() ) {
+							_best_ub.store(target_ub);
+
+							UpdateCurrentBest(current.depth, current.lb, target_ub, std::move(current_G->Clone()));
+							LOG_EVENT(_log, UPDATE_UB, current.depth, _best_ub.load());
+						}
+						// the node goes back to the queue, to be asked with the lower target
+						current.g  = std::move(current_G);
+						current.ub = target_ub;
+						std::lock_guard<std::mutex> lock(queue_mutex);
+						queue.push(std::move(current));
+						continue;
+					}
+					if ( peeled.empty() ) {
+						core.reset();	// same as the node, which keeps the order of its vertices
+					}
+				}
+
+				// Small nodes, or close to the incumbent, are decided by the SAT backend
+				if ( UseSat(core ? *core : *current_G, current_lb) ) {
+					Graph& residual = core ? *core : *current_G;
+					int target = _best_ub.load() - 1;
+					CDCLSolver::Result result = SatColor(residual, target, _clique_strat.FindCliqueVertices(residual), _sat_conflicts);
+					if ( result == CDCLSolver::Result::UNSAT ) {
+						LOG_EVENT(_log, SAT_UNSAT, current.depth, target);
+						continue;
+					}
+					if ( result == CDCLSolver::Result::SAT ) {
+						unsigned short sat_ub = ColorFromCore(*current_G, residual, peeled);
+						if ( sat_ub < _best_ub.load() ) {
+							_best_ub.store(sat_ub);
+
+							UpdateCurrentBest(current.depth, current.lb, sat_ub, std::move(current_G->Clone()));
+							LOG_EVENT(_log, SAT_UB, current.depth, _best_ub.load());
+						}
+						// the node goes back to the queue, to be asked with the lower target
+						current.g  = std::move(current_G);
+						current.ub = sat_ub;
+						std::lock_guard<std::mutex> lock(queue_mutex);
+						queue.push(std::move(current));
+						continue;
+					}
+				}
+
 				// Start branching 
 				std::unique_lock<std::mutex> lock_branching(branching_mutex);
-				auto [u, v] = _branching_strat.ChooseVertices(*current_G);
+				auto [u, v] = chooseVertices(_branching_strat, core ? *core : *current_G);
 				lock_branching.unlock();
-				Log_par("[BRANCH] Branching on vertices: u = " + std::to_string(u) +
-						", v = " + std::to_string(v),
-				current.depth);
+				LOG_EVENT(_log, BRANCH_VERTICES, current.depth, u, v);
+
+				if ( core && (u == -1 || v == -1) ) {
+					// the core is a clique with at least best_ub vertices
+					continue;
+				}
 
 				if (u == -1 || v == -1) {
 					if ( current_G->GetNumVertices() < _best_ub.load() ) {
@@ -1152,24 +2098,22 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 				std::unique_lock<std::mutex> lock_task(task_mutex);
 				auto G1 = current_G->Clone();
 				G1->MergeVertices(u, v);
-				int lb1 = _clique_strat.FindClique(*G1);
+				int lb1;
 				unsigned short ub1;
-				_color_strat.Color(*G1, ub1);
-				Log_par("[Branch 1] (Merge u, v) "
-						"lb = " + std::to_string(lb1) +
-						", ub = " + std::to_string(ub1),
-						current.depth);
+				bool keep1 = BoundChild(*G1, u, v, lb1, ub1);
+				LOG_EVENT(_log, BRANCH_MERGE, current.depth, lb1, ub1);
 
 				// AddEdge
 				auto G2 = current_G->Clone();
 				G2->AddEdge(u, v);
-				int lb2 = _clique_strat.FindClique(*G2);
+				if ( current.depth <= _symmetry_depth ) {
+					int added = AddSymmetricEdges(*current_G, *G2, u, v);
+					LOG_EVENT(_log, SYMMETRY, current.depth, added);
+				}
+				int lb2;
 				unsigned short ub2;
-				_color_strat.Color(*G2, ub2);
-				Log_par("[Branch 2] (Add edge u-v) "
-				"lb = " + std::to_string(lb2) +
-				", ub = " + std::to_string(ub2),
-				current.depth);
+				bool keep2 = BoundChild(*G2, u, v, lb2, ub2);
+				LOG_EVENT(_log, BRANCH_ADD_EDGE, current.depth, lb2, ub2);
 
 
 				// Update local sbest_ub
@@ -1178,19 +2122,20 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 					_best_ub.store(ub1);
 
 					UpdateCurrentBest(current.depth, lb1, ub1, std::move(G1->Clone()));
-					Log_par("[UPDATE] Updated best_ub: " + std::to_string(_best_ub.load()), current.depth);
+					LOG_EVENT(_log, UPDATE_UB, current.depth, _best_ub.load());
 				} else if ( ub2 < previous_best_ub ) {
 					_best_ub.store(ub2);
 
 					UpdateCurrentBest(current.depth, lb2, ub2, std::move(G2->Clone()));
-					Log_par("[UPDATE] Updated best_ub: " + std::to_string(_best_ub.load()), current.depth);
+					LOG_EVENT(_log, UPDATE_UB, current.depth, _best_ub.load());
 				}
-				Log_par("[UPDATE] Updated best_ub: " + std::to_string(_best_ub.load()), current.depth);
-				{
+				LOG_EVENT(_log, UPDATE_UB, current.depth, _best_ub.load());
+				// unless a nogood pruned them
+				if ( keep1 ) {
 					std::lock_guard<std::mutex> lock(queue_mutex);
 					queue.push(Branch(std::move(G1), lb1, ub1, current.depth + 1));
 				}
-				{
+				if ( keep2 ) {
 					std::lock_guard<std::mutex> lock(queue_mutex);
 					queue.push(Branch(std::move(G2), lb2, ub2, current.depth + 1));
 				}
@@ -1199,8 +2144,23 @@ int BalancedBranchNBoundPar::Solve(Graph& g, double &optimum_time, int timeout_s
 		}
 	}
 	//printMessage("Rank: " + std::to_string(my_rank) + " Finalizing.");
-	Log_par("[TERMINATION] Finalizing... ", 0);
-	MPI_Barrier(MPI_COMM_WORLD);
+	if ( _nogoods ) {
+		LOG_EVENT(_log, NOGOODS_KEPT, 0, _nogoods->GetNumNogoods(), _nogoods->GetNumHits());
+	}
+	LOG_EVENT(_log, FINALIZING, 0);
+	_log.Flush();
+	MPI_Barrier(_comm);
+	if ( _status_server ) {
+		// the last snapshot stays served, as finished
+		StatusSnapshot snapshot = _status_server->Snapshot();
+		snapshot.running = false;
+		snapshot.best_ub = _best_ub.load();
+		snapshot.global_lb = _global_lb.load();
+		_status_server->Publish(snapshot);
+	}
+	MPI_Comm_free(&_group_comm);
+	MPI_Comm_free(&_gather_comm);
+	MPI_Comm_free(&_comm);
 	// End execution
 	return _best_ub;
 }
\ No newline at end of file
@@ -10,9 +10,12 @@
 #include <chrono>
 #include <climits>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <sstream>
 #include <utility>
 #include <vector>
 #include <thread>
@@ -23,23 +26,218 @@
 #include "color.hpp"
 #include "common.hpp"
 #include "graph.hpp"
+#include "symmetry_breaking.hpp"
+#include "k_core.hpp"
+#include "sat_coloring.hpp"
+#include "nogood_index.hpp"
+#include "tree_estimator.hpp"
+#include "solver_stats.hpp"
+#include "event_log.hpp"
+#include "timeline_trace.hpp"
+#include "fast_random.hpp"
+#include "status_server.hpp"
 
-using BranchQueue = std::priority_queue<Branch, std::vector<Branch>>;
+/**
+ * @brief priority queue of branches whose elements can also be read in heap order, 
+ *        to sample the frontier of the search
+ */
+class BranchQueue : public std::priority_queue<Branch, std::vector<Branch>, BranchOrder> {
+	public:
+		using std::priority_queue<Branch, std::vector<Branch>, BranchOrder>::priority_queue;
+
+		const Branch& at(size_t i) const { return c[i]; }
+};
+
+// Communication layer of both solvers, defined in branch_n_bound_par.cpp and also driven in 
+// isolation by comm_bench. Every wait gives up once terminate_flag is set, but the rounds of the
+// gatherer, which complete.
+extern std::atomic<bool> terminate_flag;
+
+void sendBranch(const Branch& b, int dest, int tag, MPI_Comm comm);
+Branch recvBranch(int source, int tag, MPI_Comm comm);
+bool request_work(int my_rank, int p, BranchQueue& queue, std::mutex& queue_mutex, Branch& current, MPI_Comm comm,
+                  const std::vector<double>& remaining);
+/**
+ * @brief answers the work requests of request_work (the employer thread) until terminate_flag is set
+ */
+void serveWorkRequests(std::mutex& queue_mutex, BranchQueue& queue, MPI_Comm comm);
+int idleGroup(const std::vector<int>& idle_status, const std::vector<int>& group_of_rank);
+
+// fields of the block every rank contributes to a round of the gatherer
+enum GatherField {
+	GATHER_UB,			// best upper bound of the rank
+	GATHER_LB,			// lower bound of the rank
+	GATHER_STOPPED,		// 1 once the search terminated on the rank: the last round
+	GATHER_NOGOODS,		// length of the flattened nogoods the rank shares
+	GATHER_EXPLORED,	// nodes explored by the rank
+	GATHER_ROOT_TREE,	// mean of the root probes of the rank, 0 if none
+	GATHER_REMAINING,	// estimated nodes left below the queue of the rank, -1 if unknown
+	GATHER_QUEUE,		// size of the queue of the rank, with status reporting
+	GATHER_STEALS,		// nodes the rank received from the others, with status reporting
+	GATHER_FIELDS
+};
+
+/**
+ * @brief one round of the solution gatherer (collective on comm): the blocks of all ranks, then
+ *        their nogoods if shared, unless a rank reported it stopped (then returns false)
+ */
+bool gatherRound(const std::vector<double>& local, const std::vector<int>& nogoods, bool share_nogoods,
+                 std::vector<double>& all_fields, std::vector<int>& all_nogoods, MPI_Comm comm);
+
+/**
+ * @brief why Solve returned
+ */
+enum class SolveOutcome {
+	TIMEOUT,	// the time ran out, the coloring is the best found
+	EXPECTED,	// a coloring reached the expected chromatic number, which proves nothing
+	PROVEN		// a group exhausted its tree, or the coloring meets a proven lower bound
+};
 
 class BranchNBoundPar {
 	private:
 		BranchingStrategy& _branching_strat;
 		CliqueStrategy& _clique_strat;
 		ColorStrategy& _color_strat;
-		std::ofstream _log_file;
+		// events of this rank, written in binary (see decode_log)
+		EventLog _log;
 
 		std::atomic<unsigned short> _best_ub = USHRT_MAX;
 		std::mutex _best_branch_mutex;
 		Branch _current_best;
-		bool _logging_flag;
+		std::vector<unsigned short> _initial_coloring;
+		unsigned short _known_lb = 0;
+		// add-edge children of nodes up to this depth get the edges implied by symmetries
+		int _symmetry_depth = 0;
+		bool _decision_mode = false;
+		// nodes with at most _sat_max_vertices vertices, or with best_ub - lb <= _sat_max_gap,
+		// are decided by the SAT backend within _sat_conflicts conflicts (0 disables each test)
+		int _sat_max_vertices = 0;
+		int _sat_max_gap = 0;
+		long _sat_conflicts = 10000;
+		// at most _nogood_capacity nogoods are learnt from the pruned children, and the 
+		// _nogood_share most used are sent to the other ranks at each gather (0 disables each)
+		size_t _nogood_capacity = 0;
+		int _nogood_share = 0;
+		std::unique_ptr<NogoodIndex> _nogoods;
+		// portfolio: group of each rank (empty for a single group). Every group searches the
+		// whole tree on its own, the groups only share bounds and nogoods
+		std::vector<int> _group_of_rank;
+		NodeSelection _node_selection = NodeSelection::DEPTH;
+		// best lower bound on the chromatic number of the graph found by any rank
+		std::atomic<unsigned short> _global_lb = 0;
+		// set on rank 0 by Solve: rank whose coloring was returned, group which exhausted its tree,
+		// why it returned
+		int _incumbent_rank = -1;
+		int _proof_group = -1;
+		SolveOutcome _outcome = SolveOutcome::TIMEOUT;
+		// communicator of the running Solve, a duplicate of MPI_COMM_WORLD
+		MPI_Comm _comm = MPI_COMM_NULL;
+		// duplicate of MPI_COMM_WORLD for the rounds of the gatherer, kept apart from the 
+		// collectives of the terminator on _comm
+		MPI_Comm _gather_comm = MPI_COMM_NULL;
+		// communicator of the group of this rank, within which work is stolen
+		MPI_Comm _group_comm = MPI_COMM_NULL;
+		// progress estimation: a thread probes the root and the queued nodes with random dives
+		bool _estimate_progress = false;
+		double _solve_start_time = 0;
+		// seconds from the start of Solve to the coloring held in _current_best, -1 if none
+		double _incumbent_time = -1;
+		std::atomic<long> _nodes_explored = 0;
+		std::mutex _estimate_mutex;
+		ProbeMean _root_probes;
+		ProbeMean _frontier_probes;
+		long _frontier_size = -1;  // -1 until the queue was sampled
+		// estimated nodes left on each rank of the group, by group rank, to choose whom to steal from
+		std::vector<double> _group_remaining;
+		ProgressEstimate _progress;
+		// live status: the ranks send their state at every gather, rank 0 publishes it on
+		// _status_server. The counts of the previous gather give the rates
+		bool _report_status = false;
+		StatusServer* _status_server = nullptr;
+		std::atomic<long> _steals_received = 0;
+		double _last_status_time = 0;
+		long _last_status_nodes = 0;
+		long _last_status_steals = 0;
 
 		void ColorInitialGraph(Graph& initial_graph, const Branch& optimal_branch);
 
+		/**
+		 * @brief decision mode: peels from a copy of g the vertices with fewer than 
+		 *        best_ub - 1 neighbours, since they can always be colored last with 
+		 *        best_ub - 1 colors. If nothing is left, g gets such a coloring
+		 * 
+		 * @param peeled removed vertices, in removal order
+		 * @param ub number of colors of g, set only if the core is empty
+		 * @return the core of g
+		 */
+		GraphPtr PeelToTarget(Graph& g, std::vector<int>& peeled, unsigned short& ub);
+
+		/**
+		 * @brief computes the bounds of a new node and colors it: on the whole graph or,
+		 *        in decision mode, on its core, the peeled vertices being colored greedily
+		 */
+		void BoundNode(Graph& g, int& lb, unsigned short& ub);
+
+		/**
+		 * @brief colors g with the colors of core (a copy of g without the peeled vertices,
+		 *        or g itself), the peeled vertices greedily
+		 * 
+		 * @return number of colors of g
+		 */
+		unsigned short ColorFromCore(Graph& g, const Graph& core, const std::vector<int>& peeled);
+
+		/**
+		 * @brief whether the node, reduced to residual, is small enough, or close enough to
+		 *        best_ub, to be handed to the SAT backend
+		 */
+		bool UseSat(const Graph& residual, int lb) const;
+
+		/**
+		 * @brief bounds a child of the branching on (u, v), unless a learnt nogood already 
+		 *        prunes it. The clique of a child which cannot beat best_ub is learnt
+		 * 
+		 * @return false if the child is pruned by a nogood (lb and ub are then meaningless)
+		 */
+		bool BoundChild(Graph& child, int u, int v, int& lb, unsigned short& ub);
+
+		/**
+		 * @brief learns the nogoods shared by the ranks in a round of the gatherer
+		 * @param all nogoods of all ranks, flattened as size, vertices...
+		 */
+		void LearnNogoods(const std::vector<int>& all);
+
+		/**
+		 * @brief one round of the gatherer: exchanges the bounds of all ranks (collective on 
+		 *        _gather_comm), then shares the nogoods, progress and status
+		 * @param stopped whether the search terminated on this rank, which makes it the last round
+		 * @return false once a rank stopped, when the gatherer returns
+		 */
+		bool GatherRound(int p, std::atomic<unsigned short>& best_ub, bool stopped, std::mutex& queue_mutex, 
+						 BranchQueue& queue);
+
+		/**
+		 * @brief sums up the explored nodes and the estimates of all ranks gathered in a round,
+		 *        printing the progress on rank 0 (called by the gatherer)
+		 * @param all_fields blocks gathered in the round
+		 */
+		void GatherProgress(int p, const std::vector<double>& all_fields);
+
+		/**
+		 * @brief on rank 0, publishes the nodes, queue size and steals of all ranks gathered 
+		 *        in a round with the bounds and estimates (called by the gatherer)
+		 * @param all_fields blocks gathered in the round
+		 */
+		void GatherStatus(int p, const std::vector<double>& all_fields);
+
+		/**
+		 * @brief resets _best_ub and _current_best and, if an initial coloring was given,
+		 *        makes it the incumbent
+		 * 
+		 * @param g graph being solved
+		 * @return number of colors of the initial coloring, USHRT_MAX if there is none
+		 */
+		unsigned short SeedInitialColoring(const Graph& g);
+
 		/**
 		 * @brief updates the _current_best branch to store the best graph with the best coloring
 		 * 
@@ -50,12 +248,6 @@ class BranchNBoundPar {
 		 */
 		void UpdateCurrentBest(int depth, int lb, unsigned short ub, GraphPtr graph);
 
-		/**
-		 * @brief Logs a message to the log file in a MPI environment and OpenMP parallel section.
-		 *
-		 * @param message The message to log.
-		 */
-		void Log_par(const std::string& message, int depth);
 	
 		/**
 		 * @brief Checks if the solver has exceeded the timeout.
@@ -77,7 +269,7 @@ class BranchNBoundPar {
          * @param timeout_seconds The timeout duration (in seconds) after which the timeout signal is sent.
          * @param optimum_time The time at which the optimum solution was found.
          */
-		void thread_0_terminator(int my_rank, int p, int global_start_time, int timeout_seconds, 
+		void thread_0_terminator(int my_rank, int p, double global_start_time, int timeout_seconds, 
 								 double &optimum_time, Graph& graph_to_color);
 	
 		/**
@@ -87,8 +279,11 @@ class BranchNBoundPar {
          * @param best_ub The best upper bound found so far.
          * @param my_rank The rank of the current process.
          * @param sol_gather_period The period (in seconds) at which the best upper bound is gathered.
+         * @param queue_mutex Mutex protecting the queue.
+         * @param queue The local work queue, whose size is reported with the status.
          */
-		void thread_1_solution_gatherer(int p, std::atomic<unsigned short> &best_ub, int sol_gather_period);
+		void thread_1_solution_gatherer(int p, std::atomic<unsigned short> &best_ub, int sol_gather_period,
+										std::mutex& queue_mutex, BranchQueue& queue);
 	
 		/**
          * @brief Employer thread employs workers by answering their work requests.
@@ -97,6 +292,16 @@ class BranchNBoundPar {
          * @param queue The local work queue containing branches to be processed.
          */
 		void thread_2_employer(std::mutex& queue_mutex, BranchQueue& queue);
+
+		/**
+         * @brief Estimates the size of the tree with random dives, alternately from the root 
+         *        and from a random queued node, idling as long as it probes.
+         *
+         * @param root A copy of the graph being solved.
+         * @param queue_mutex Mutex to protect concurrent access to the work queue.
+         * @param queue The local work queue containing branches to be processed.
+         */
+		void thread_4_estimator(const Graph& root, std::mutex& queue_mutex, BranchQueue& queue);
 	
 	public:
 		/**
@@ -105,7 +310,8 @@ class BranchNBoundPar {
          * @param branching_strat The branching strategy to use.
          * @param clique_strat The clique strategy to use.
          * @param color_strat The color strategy to use.
-         * @param log_file_path The path to the log file.
+         * @param log_file_path The path to the binary event log (see decode_log).
+         * @param logging_flag Whether events are logged.
          */
 		 BranchNBoundPar(BranchingStrategy& branching_strat,
 			CliqueStrategy& clique_strat,
@@ -115,12 +321,135 @@ class BranchNBoundPar {
 			: _branching_strat(branching_strat),
 			_clique_strat(clique_strat),
 			_color_strat(color_strat),
-			_logging_flag{logging_flag}{
-				_log_file.open(log_file_path);
-				if (!_log_file.is_open()) {
-					throw std::runtime_error("Failed to open log file: " + log_file_path);
-				}
-			}
+			_log{log_file_path, logging_flag} {}
+
+		/**
+		 * @brief sets a valid coloring of the graph given to the next Solve, used as the
+		 *        first incumbent so that pruning starts from the root
+		 * 
+		 * @param full_coloring coloring such that full_coloring[vertex] is the color of vertex
+		 */
+		void SetInitialColoring(const std::vector<unsigned short>& full_coloring) {
+			_initial_coloring = full_coloring;
+		}
+
+		/**
+		 * @brief sets a proven lower bound on the chromatic number of the graph given to 
+		 *        the next Solve: a coloring with that many colors ends the search, 
+		 *        as if it was the expected chromatic number
+		 */
+		void SetKnownLowerBound(unsigned short lb) { _known_lb = lb; }
+
+		/**
+		 * @brief enables symmetry breaking in the first levels of the search tree: when
+		 *        branching on (u, v) at depth <= levels, the add-edge child also gets u-w
+		 *        for every w in the orbit of v under the automorphisms fixing u (see
+		 *        AddSymmetricEdges). 0 disables it
+		 */
+		void SetSymmetryDepth(int levels) { _symmetry_depth = levels; }
+
+		/**
+		 * @brief enables decision mode: every node is asked whether it is colorable with 
+		 *        best_ub - 1 colors, so its vertices of lower degree are dropped before 
+		 *        bounding and branching (see PeelKCore). When such a coloring is found the
+		 *        node goes back to the queue and is asked again with the lower target
+		 */
+		void SetDecisionMode(bool decision_mode) { _decision_mode = decision_mode; }
+
+		/**
+		 * @brief enables the SAT backend: a node with at most max_vertices vertices (after 
+		 *        peeling, in decision mode) or with best_ub - lb <= max_gap is asked to a CDCL
+		 *        solver whether it has a coloring with best_ub - 1 colors. If not, it is pruned;
+		 *        if so, the coloring becomes the incumbent and the node is asked again with the
+		 *        lower target; after conflict_budget conflicts the node is branched as usual
+		 * 
+		 * @param max_vertices 0 disables the size test
+		 * @param max_gap 0 disables the gap test
+		 */
+		void SetSatBackend(int max_vertices, int max_gap, long conflict_budget) {
+			_sat_max_vertices = max_vertices;
+			_sat_max_gap      = max_gap;
+			_sat_conflicts    = conflict_budget;
+		}
+
+		/**
+		 * @brief enables nogood learning: the cliques of the children which cannot beat the
+		 *        incumbent are kept (see NogoodIndex), and every new child satisfying one of 
+		 *        them is dropped before being bounded
+		 * 
+		 * @param capacity maximum number of nogoods kept by each rank, 0 disables learning
+		 * @param shared number of nogoods, the most used, sent to the other ranks at each 
+		 *        gather of best_ub. 0 disables sharing
+		 */
+		void SetNogoodLearning(size_t capacity, int shared) {
+			_nogood_capacity = capacity;
+			_nogood_share    = shared;
+		}
+
+		/**
+		 * @brief splits the ranks in groups which race on the same graph: each group searches
+		 *        the whole tree, with the strategies given to its ranks, and work is only 
+		 *        stolen within a group. The incumbent, the lower bound and the nogoods are 
+		 *        shared by all ranks, and the search ends as soon as a group exhausts its tree
+		 * 
+		 * @param group_of_rank group of each rank of MPI_COMM_WORLD, empty for a single group
+		 */
+		void SetPortfolio(const std::vector<int>& group_of_rank) { _group_of_rank = group_of_rank; }
+
+		/**
+		 * @brief sets the order in which the nodes of the local queue are processed
+		 */
+		void SetNodeSelection(NodeSelection selection) { _node_selection = selection; }
+
+		/**
+		 * @brief rank whose coloring was returned by the last Solve, -1 if it was the initial 
+		 *        coloring. Only meaningful on rank 0
+		 */
+		int GetIncumbentRank() const { return _incumbent_rank; }
+
+		/**
+		 * @brief group which exhausted its tree in the last Solve, proving the optimality,
+		 *        -1 if the optimality came from a lower bound or was not proven.
+		 *        Only meaningful on rank 0
+		 */
+		int GetProofGroup() const { return _proof_group; }
+
+		/**
+		 * @brief why the last Solve returned: only PROVEN makes its result the chromatic number.
+		 *        Only meaningful on rank 0
+		 */
+		SolveOutcome GetOutcome() const { return _outcome; }
+
+		/**
+		 * @brief seconds from the start of the last Solve to the moment this rank found its
+		 *        best coloring (0 for the initial coloring), -1 if it found none. With
+		 *        GetIncumbentRank, the time to the best upper bound
+		 */
+		double GetIncumbentTime() const { return _incumbent_time; }
+
+		/**
+		 * @brief estimates the size of the tree during Solve, on a spare thread, to print the
+		 *        progress at each gather and to steal work from the ranks with the most left
+		 */
+		void SetProgressEstimation(bool enabled) { _estimate_progress = enabled; }
+
+		/**
+		 * @brief gathers the state of every rank at each gather of Solve, for rank 0 to 
+		 *        publish it on server. To be enabled on every rank (the gather is collective),
+		 *        the server is only used on rank 0
+		 */
+		void SetStatusReporting(bool enabled, StatusServer* server = nullptr) {
+			_report_status = enabled;
+			_status_server = server;
+		}
+
+		/**
+		 * @brief progress at the last gather of the last Solve, all zeros if not estimated
+		 */
+		ProgressEstimate GetProgressEstimate() {
+			std::lock_guard<std::mutex> lock(_estimate_mutex);
+			return _progress;
+		}
 
 		/**
          * @brief Solves the graph coloring problem using the branch and bound method.
@@ -144,15 +473,145 @@ class BalancedBranchNBoundPar {
 		BranchingStrategy& _branching_strat;
 		CliqueStrategy& _clique_strat;
 		ColorStrategy& _color_strat;
-		std::ofstream _log_file;
+		// events of this rank, written in binary (see decode_log)
+		EventLog _log;
 
 		std::atomic<unsigned short> _best_ub = USHRT_MAX;
 		std::mutex _best_branch_mutex;
 		Branch _current_best;
-		bool _logging_flag;
+		std::vector<unsigned short> _initial_coloring;
+		unsigned short _known_lb = 0;
+		// add-edge children of nodes up to this depth get the edges implied by symmetries
+		int _symmetry_depth = 0;
+		bool _decision_mode = false;
+		// nodes with at most _sat_max_vertices vertices, or with best_ub - lb <= _sat_max_gap,
+		// are decided by the SAT backend within _sat_conflicts conflicts (0 disables each test)
+		int _sat_max_vertices = 0;
+		int _sat_max_gap = 0;
+		long _sat_conflicts = 10000;
+		// at most _nogood_capacity nogoods are learnt from the pruned children, and the 
+		// _nogood_share most used are sent to the other ranks at each gather (0 disables each)
+		size_t _nogood_capacity = 0;
+		int _nogood_share = 0;
+		std::unique_ptr<NogoodIndex> _nogoods;
+		// portfolio: group of each rank (empty for a single group). Every group searches the
+		// whole tree on its own, the groups only share bounds and nogoods
+		std::vector<int> _group_of_rank;
+		NodeSelection _node_selection = NodeSelection::DEPTH;
+		// best lower bound on the chromatic number of the graph found by any rank
+		std::atomic<unsigned short> _global_lb = 0;
+		// set on rank 0 by Solve: rank whose coloring was returned, group which exhausted its tree,
+		// why it returned
+		int _incumbent_rank = -1;
+		int _proof_group = -1;
+		SolveOutcome _outcome = SolveOutcome::TIMEOUT;
+		// communicator of the running Solve, a duplicate of MPI_COMM_WORLD
+		MPI_Comm _comm = MPI_COMM_NULL;
+		// duplicate of MPI_COMM_WORLD for the rounds of the gatherer, kept apart from the 
+		// collectives of the terminator on _comm
+		MPI_Comm _gather_comm = MPI_COMM_NULL;
+		// communicator of the group of this rank, within which work is stolen
+		MPI_Comm _group_comm = MPI_COMM_NULL;
+		// progress estimation: a thread probes the root and the queued nodes with random dives
+		bool _estimate_progress = false;
+		double _solve_start_time = 0;
+		// seconds from the start of Solve to the coloring held in _current_best, -1 if none
+		double _incumbent_time = -1;
+		std::atomic<long> _nodes_explored = 0;
+		std::mutex _estimate_mutex;
+		ProbeMean _root_probes;
+		ProbeMean _frontier_probes;
+		long _frontier_size = -1;  // -1 until the queue was sampled
+		// estimated nodes left on each rank of the group, by group rank, to choose whom to steal from
+		std::vector<double> _group_remaining;
+		ProgressEstimate _progress;
+		// live status: the ranks send their state at every gather, rank 0 publishes it on
+		// _status_server. The counts of the previous gather give the rates
+		bool _report_status = false;
+		StatusServer* _status_server = nullptr;
+		std::atomic<long> _steals_received = 0;
+		double _last_status_time = 0;
+		long _last_status_nodes = 0;
+		long _last_status_steals = 0;
 
 		void ColorInitialGraph(Graph& initial_graph, const Branch& optimal_branch);
 
+		/**
+		 * @brief decision mode: peels from a copy of g the vertices with fewer than 
+		 *        best_ub - 1 neighbours, since they can always be colored last with 
+		 *        best_ub - 1 colors. If nothing is left, g gets such a coloring
+		 * 
+		 * @param peeled removed vertices, in removal order
+		 * @param ub number of colors of g, set only if the core is empty
+		 * @return the core of g
+		 */
+		GraphPtr PeelToTarget(Graph& g, std::vector<int>& peeled, unsigned short& ub);
+
+		/**
+		 * @brief computes the bounds of a new node and colors it: on the whole graph or,
+		 *        in decision mode, on its core, the peeled vertices being colored greedily
+		 */
+		void BoundNode(Graph& g, int& lb, unsigned short& ub);
+
+		/**
+		 * @brief colors g with the colors of core (a copy of g without the peeled vertices,
+		 *        or g itself), the peeled vertices greedily
+		 * 
+		 * @return number of colors of g
+		 */
+		unsigned short ColorFromCore(Graph& g, const Graph& core, const std::vector<int>& peeled);
+
+		/**
+		 * @brief whether the node, reduced to residual, is small enough, or close enough to
+		 *        best_ub, to be handed to the SAT backend
+		 */
+		bool UseSat(const Graph& residual, int lb) const;
+
+		/**
+		 * @brief bounds a child of the branching on (u, v), unless a learnt nogood already 
+		 *        prunes it. The clique of a child which cannot beat best_ub is learnt
+		 * 
+		 * @return false if the child is pruned by a nogood (lb and ub are then meaningless)
+		 */
+		bool BoundChild(Graph& child, int u, int v, int& lb, unsigned short& ub);
+
+		/**
+		 * @brief learns the nogoods shared by the ranks in a round of the gatherer
+		 * @param all nogoods of all ranks, flattened as size, vertices...
+		 */
+		void LearnNogoods(const std::vector<int>& all);
+
+		/**
+		 * @brief one round of the gatherer: exchanges the bounds of all ranks (collective on 
+		 *        _gather_comm), then shares the nogoods, progress and status
+		 * @param stopped whether the search terminated on this rank, which makes it the last round
+		 * @return false once a rank stopped, when the gatherer returns
+		 */
+		bool GatherRound(int p, bool stopped, std::mutex& queue_mutex, BranchQueue& queue);
+
+		/**
+		 * @brief sums up the explored nodes and the estimates of all ranks gathered in a round,
+		 *        printing the progress on rank 0 (called by the gatherer)
+		 * @param all_fields blocks gathered in the round
+		 */
+		void GatherProgress(int p, const std::vector<double>& all_fields);
+
+		/**
+		 * @brief on rank 0, publishes the nodes, queue size and steals of all ranks gathered 
+		 *        in a round with the bounds and estimates (called by the gatherer)
+		 * @param all_fields blocks gathered in the round
+		 */
+		void GatherStatus(int p, const std::vector<double>& all_fields);
+
+		/**
+		 * @brief resets _best_ub and _current_best and, if an initial coloring was given,
+		 *        makes it the incumbent
+		 * 
+		 * @param g graph being solved
+		 * @return number of colors of the initial coloring, USHRT_MAX if there is none
+		 */
+		unsigned short SeedInitialColoring(const Graph& g);
+
 		/**
 		 * @brief updates the _current_best branch to store the best graph with the best coloring
 		 * 
@@ -163,12 +622,6 @@ class BalancedBranchNBoundPar {
 		 */
 		void UpdateCurrentBest(int depth, int lb, unsigned short ub, GraphPtr graph);
 	
-		/**
-		 * @brief Logs a message to the log file in a openmp parallel section.
-		 *
-		 * @param message The message to log.
-		 */
-		void Log_par(const std::string& message, int depth);
 	
 		/**
 		 * @brief Checks if the solver has exceeded the timeout.
@@ -191,7 +644,7 @@ class BalancedBranchNBoundPar {
 		 * @param optimum_time The time at which the optimum solution was found.
 		 * @param graph_to_color The graph to color.
 		 */
-		void thread_0_terminator(int my_rank, int p, int global_start_time, 
+		void thread_0_terminator(int my_rank, int p, double global_start_time, 
 									int timeout_seconds, double &optimum_time,
 									Graph& graph_to_color);
 	
@@ -200,8 +653,10 @@ class BalancedBranchNBoundPar {
 		 *
 		 * @param p The total number of processes in the MPI communicator.
 		 * @param sol_gather_period The period in seconds when all processes gather solutions.
+		 * @param queue_mutex Mutex protecting the queue.
+		 * @param queue The local work queue, whose size is reported with the status.
 		 */
-		void thread_1_solution_gatherer(int p, int sol_gather_period);
+		void thread_1_solution_gatherer(int p, int sol_gather_period, std::mutex& queue_mutex, BranchQueue& queue);
 	
 		/**
 		 * @brief Employer thread employs workers by answering their work requests.
@@ -210,6 +665,16 @@ class BalancedBranchNBoundPar {
 		 * @param queue The local work queue containing branches to be processed.
 		 */
 		void thread_2_employer(std::mutex& queue_mutex, BranchQueue& queue);
+
+		/**
+         * @brief Estimates the size of the tree with random dives, alternately from the root 
+         *        and from a random queued node, idling as long as it probes.
+         *
+         * @param root A copy of the graph being solved.
+         * @param queue_mutex Mutex to protect concurrent access to the work queue.
+         * @param queue The local work queue containing branches to be processed.
+         */
+		void thread_4_estimator(const Graph& root, std::mutex& queue_mutex, BranchQueue& queue);
 	
 	public:
 		/**
@@ -228,14 +693,136 @@ class BalancedBranchNBoundPar {
 			: _branching_strat(branching_strat),
 			_clique_strat(clique_strat),
 			_color_strat(color_strat),
-			_logging_flag{logging_flag}
-			{
-				_log_file.open(log_file_path);
-				if (!_log_file.is_open()) {
-					throw std::runtime_error("Failed to open log file: " + log_file_path);
-				}
-			}
+			_log{log_file_path, logging_flag} {}
 	
+		/**
+		 * @brief sets a valid coloring of the graph given to the next Solve, used as the
+		 *        first incumbent so that pruning starts from the root
+		 * 
+		 * @param full_coloring coloring such that full_coloring[vertex] is the color of vertex
+		 */
+		void SetInitialColoring(const std::vector<unsigned short>& full_coloring) {
+			_initial_coloring = full_coloring;
+		}
+
+		/**
+		 * @brief sets a proven lower bound on the chromatic number of the graph given to 
+		 *        the next Solve: a coloring with that many colors ends the search, 
+		 *        as if it was the expected chromatic number
+		 */
+		void SetKnownLowerBound(unsigned short lb) { _known_lb = lb; }
+
+		/**
+		 * @brief enables symmetry breaking in the first levels of the search tree: when
+		 *        branching on (u, v) at depth <= levels, the add-edge child also gets u-w
+		 *        for every w in the orbit of v under the automorphisms fixing u (see
+		 *        AddSymmetricEdges). 0 disables it
+		 */
+		void SetSymmetryDepth(int levels) { _symmetry_depth = levels; }
+
+		/**
+		 * @brief enables decision mode: every node is asked whether it is colorable with 
+		 *        best_ub - 1 colors, so its vertices of lower degree are dropped before 
+		 *        bounding and branching (see PeelKCore). When such a coloring is found the
+		 *        node goes back to the queue and is asked again with the lower target
+		 */
+		void SetDecisionMode(bool decision_mode) { _decision_mode = decision_mode; }
+
+		/**
+		 * @brief enables the SAT backend: a node with at most max_vertices vertices (after 
+		 *        peeling, in decision mode) or with best_ub - lb <= max_gap is asked to a CDCL
+		 *        solver whether it has a coloring with best_ub - 1 colors. If not, it is pruned;
+		 *        if so, the coloring becomes the incumbent and the node is asked again with the
+		 *        lower target; after conflict_budget conflicts the node is branched as usual
+		 * 
+		 * @param max_vertices 0 disables the size test
+		 * @param max_gap 0 disables the gap test
+		 */
+		void SetSatBackend(int max_vertices, int max_gap, long conflict_budget) {
+			_sat_max_vertices = max_vertices;
+			_sat_max_gap      = max_gap;
+			_sat_conflicts    = conflict_budget;
+		}
+
+		/**
+		 * @brief enables nogood learning: the cliques of the children which cannot beat the
+		 *        incumbent are kept (see NogoodIndex), and every new child satisfying one of 
+		 *        them is dropped before being bounded
+		 * 
+		 * @param capacity maximum number of nogoods kept by each rank, 0 disables learning
+		 * @param shared number of nogoods, the most used, sent to the other ranks at each 
+		 *        gather of best_ub. 0 disables sharing
+		 */
+		void SetNogoodLearning(size_t capacity, int shared) {
+			_nogood_capacity = capacity;
+			_nogood_share    = shared;
+		}
+
+		/**
+		 * @brief splits the ranks in groups which race on the same graph: each group searches
+		 *        the whole tree, with the strategies given to its ranks, and work is only 
+		 *        stolen within a group. The incumbent, the lower bound and the nogoods are 
+		 *        shared by all ranks, and the search ends as soon as a group exhausts its tree
+		 * 
+		 * @param group_of_rank group of each rank of MPI_COMM_WORLD, empty for a single group
+		 */
+		void SetPortfolio(const std::vector<int>& group_of_rank) { _group_of_rank = group_of_rank; }
+
+		/**
+		 * @brief sets the order in which the nodes of the local queue are processed
+		 */
+		void SetNodeSelection(NodeSelection selection) { _node_selection = selection; }
+
+		/**
+		 * @brief rank whose coloring was returned by the last Solve, -1 if it was the initial 
+		 *        coloring. Only meaningful on rank 0
+		 */
+		int GetIncumbentRank() const { return _incumbent_rank; }
+
+		/**
+		 * @brief group which exhausted its tree in the last Solve, proving the optimality,
+		 *        -1 if the optimality came from a lower bound or was not proven.
+		 *        Only meaningful on rank 0
+		 */
+		int GetProofGroup() const { return _proof_group; }
+
+		/**
+		 * @brief why the last Solve returned: only PROVEN makes its result the chromatic number.
+		 *        Only meaningful on rank 0
+		 */
+		SolveOutcome GetOutcome() const { return _outcome; }
+
+		/**
+		 * @brief seconds from the start of the last Solve to the moment this rank found its
+		 *        best coloring (0 for the initial coloring), -1 if it found none. With
+		 *        GetIncumbentRank, the time to the best upper bound
+		 */
+		double GetIncumbentTime() const { return _incumbent_time; }
+
+		/**
+		 * @brief estimates the size of the tree during Solve, on a spare thread, to print the
+		 *        progress at each gather and to steal work from the ranks with the most left
+		 */
+		void SetProgressEstimation(bool enabled) { _estimate_progress = enabled; }
+
+		/**
+		 * @brief gathers the state of every rank at each gather of Solve, for rank 0 to 
+		 *        publish it on server. To be enabled on every rank (the gather is collective),
+		 *        the server is only used on rank 0
+		 */
+		void SetStatusReporting(bool enabled, StatusServer* server = nullptr) {
+			_report_status = enabled;
+			_status_server = server;
+		}
+
+		/**
+		 * @brief progress at the last gather of the last Solve, all zeros if not estimated
+		 */
+		ProgressEstimate GetProgressEstimate() {
+			std::lock_guard<std::mutex> lock(_estimate_mutex);
+			return _progress;
+		}
+
 		int Solve(Graph& g, double &optimum_time, int timeout_seconds = 60, 
 					int sol_gather_period = 10, 
 					unsigned short expected_chi = -1);
@@ -6,8 +6,12 @@
 RandomBranchingStrategy::RandomBranchingStrategy() 
 : BranchingStrategy()
 {
-    std::random_device dev;
-    _random_generator = std::make_unique<std::mt19937>(dev());
+}
+
+RandomBranchingStrategy::RandomBranchingStrategy(unsigned int seed) 
+: BranchingStrategy()
+{
+    _random_generator.emplace(seed);
 }
 
 
@@ -18,11 +22,11 @@ RandomBranchingStrategy::ChooseVertices(Graph &graph) {
     if(graph.GetNumEdges() == n*(n-1)/2) {
         return std::make_pair(-1, -1);
     }
+    Xoshiro256& random = _random_generator ? *_random_generator : ThreadRandom::Get();
     do 
     {
-        std::uniform_int_distribution<int> u(0, n-1);
-        _vertex_pair.first   = graph.GetVertices()[u(*_random_generator)];
-        _vertex_pair.second  = graph.GetVertices()[u(*_random_generator)];
+        _vertex_pair.first   = graph.GetVertices()[random.Below(n)];
+        _vertex_pair.second  = graph.GetVertices()[random.Below(n)];
 
     } while ( 
         /*
@@ -3,9 +3,10 @@
 
 #include "common.hpp"
 #include "graph.hpp"
+#include "fast_random.hpp"
 
-#include <random>
 #include <memory>
+#include <optional>
 
 /**
  * @brief abstact strategy with which, at each step of the branch and bound, a new 
@@ -26,14 +27,21 @@ class BranchingStrategy {
 
 class RandomBranchingStrategy : public BranchingStrategy {
     public:
+        /**
+         * @brief draws from the random stream of the calling thread (see ThreadRandom)
+         */
         RandomBranchingStrategy();
+        /**
+         * @brief draws from its own generator, seeded with seed
+         */
+        explicit RandomBranchingStrategy(unsigned int seed);
 
         virtual std::pair<int, int> 
         ChooseVertices(Graph& graph) override;
 
     protected:
         std::pair<unsigned int, unsigned int> _vertex_pair;
-        std::unique_ptr<std::mt19937> _random_generator;
+        std::optional<Xoshiro256> _random_generator;
 
     private:
 };
@@ -22,6 +22,14 @@ class CliqueStrategy {
          * @returns the last computed maximal clique
          */
         virtual std::vector<int> GetClique() const = 0;
+        /**
+         * @brief finds a feasible clique in the graph and returns it, without keeping it in
+         *        the strategy: safe while other threads use the same strategy
+         * 
+         * @param graph the graph of which the clique has to be found
+         * @returns the vertices of the feasible clique
+         */
+        virtual std::vector<int> FindCliqueVertices(const Graph &graph) const = 0;
 };
 
 /**
@@ -32,6 +40,7 @@ class StubCliqueStrategy : public CliqueStrategy {
     public:
         virtual int FindClique(const Graph &graph) const override;
         virtual std::vector<int> GetClique() const override { return {}; }
+        virtual std::vector<int> FindCliqueVertices(const Graph &) const override { return {}; }
     
 };
 
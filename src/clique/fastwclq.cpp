@@ -1,4 +1,6 @@
 #include "fastwclq.hpp"
+#include "solver_stats.hpp"
+#include "fast_random.hpp"
 #include <algorithm>
 #include <iterator>
 #include <random>
@@ -11,6 +13,7 @@
 
 int FastCliqueStrategy::FindClique(const Graph &graph) const
 {
+    PhaseTimer timer(StatPhase::CLIQUE);
 
     _solver = std::make_unique<FastWClq>(graph, _k);
     
@@ -22,6 +25,14 @@ std::vector<int> FastCliqueStrategy::GetClique() const
     return _solver->GetMaxClique();
 }
 
+std::vector<int> FastCliqueStrategy::FindCliqueVertices(const Graph &graph) const
+{
+    PhaseTimer timer(StatPhase::CLIQUE);
+
+    FastWClq solver(graph, _k);
+    return solver.FindMaxWeightClique();
+}
+
 // Constructor initializes the graph reference and sets the max weight to zero
 FastWClq::FastWClq(const Graph& graph, int k) : graph_(graph), max_weight_(0), k_{k} {}
 
@@ -145,7 +156,7 @@ int FastWClq::ChooseVertex(const std::vector<int>& CandSet) {
 
     // Use random sampling - BMS heuristic - to pick a subset of k candidates
     std::vector<int> samples;
-    std::sample(CandSet.begin(), CandSet.end(), std::back_inserter(samples), k_, std::mt19937{std::random_device{}()});
+    std::sample(CandSet.begin(), CandSet.end(), std::back_inserter(samples), k_, ThreadRandom::Get());
 
     // Return the best among the sampled candidates based on benefit estimate
     
@@ -20,6 +20,7 @@ class FastCliqueStrategy : public CliqueStrategy {
          */
         virtual int FindClique(const Graph &graph) const override;
         virtual std::vector<int> GetClique() const override;
+        virtual std::vector<int> FindCliqueVertices(const Graph &graph) const override;
     private:
         mutable std::unique_ptr<FastWClq> _solver;
         const int _k;
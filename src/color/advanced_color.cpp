@@ -1,5 +1,7 @@
 #include "advanced_color.hpp"
 
+#include <algorithm>
+
 // void InterleavedColorStrategy::Color(Graph &graph, unsigned short &k_max) const
 // {
 //     _curr_length++;
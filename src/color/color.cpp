@@ -1,4 +1,5 @@
 #include "color.hpp"
+#include "solver_stats.hpp"
 
 #include <cstring>
 #include <iostream>
@@ -44,6 +45,7 @@ unsigned short GreedyFindColor(const Graph& graph,
 void GreedyColorStrategy::Color(Graph& graph,
                                 unsigned short& max_k) const
 { 
+    PhaseTimer timer(StatPhase::COLOR);
     // used for accessing neighbours colors
     std::vector<unsigned short> coloring(graph.GetHighestVertex() + 1, 0);
 
@@ -1,7 +1,11 @@
 #include "dsatur_color.hpp"
+#include "solver_stats.hpp"
+
+#include <algorithm>
 
 void DSaturColorStrategy::Color(Graph &graph, unsigned short &max_k) const
 {
+    PhaseTimer timer(StatPhase::COLOR);
     std::vector<unsigned short> coloring(graph.GetHighestVertex() + 1);
 
     DSaturList list(graph);
@@ -1,7 +1,9 @@
 #include "recolor.hpp"
+#include "solver_stats.hpp"
 
 unsigned int GreedySwapRecolorStrategy::Recolor(Graph& graph) const 
 {
+    PhaseTimer timer(StatPhase::RECOLOR);
     std::vector<unsigned short> coloring = graph.GetFullColoring();
     SwapRecolorStructure data(graph, coloring, 50);
     data.FillWithData();
@@ -15,8 +17,6 @@ VertexRecolorData::VertexRecolorData()
     : _old_color{NOT_ASSIGNED},
       _vertex{NOT_ASSIGNED}
 {
-    std::random_device dev;
-    _random_generator = std::make_unique<std::mt19937>(dev());
 }
 
 VertexRecolorData::VertexRecolorData(int vertex,
@@ -25,8 +25,6 @@ VertexRecolorData::VertexRecolorData(int vertex,
     : _vertex{vertex}, _old_color{NOT_ASSIGNED},
       _coloring{coloring}, _max_color{max_color}
 {
-    std::random_device dev;
-    _random_generator = std::make_unique<std::mt19937>(dev());
 }
 
 inline void VertexRecolorData::AssignColor(unsigned short color)
@@ -3,7 +3,7 @@
 
 #include "graph.hpp"
 #include "color.hpp"
-#include <random>
+#include "fast_random.hpp"
 
 
 /**
@@ -164,8 +164,7 @@ class VertexRecolorData {
             }
 
             // randomly choosing a new color which is not forbidden
-            std::uniform_int_distribution<int> u(0, available_colors.size()-1);
-            (*_coloring)[_vertex] = available_colors[u(*_random_generator)];
+            (*_coloring)[_vertex] = available_colors[ThreadRandom::Get().Below(available_colors.size())];
 
             return true;
         }
@@ -184,7 +183,6 @@ class VertexRecolorData {
         unsigned short _max_color;
         std::vector<unsigned short>* _coloring;
         std::vector<int> _neighbours;
-        std::unique_ptr<std::mt19937> _random_generator;
 };
 
 class SwapRecolorStructure {
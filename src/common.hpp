@@ -133,4 +133,30 @@ struct Branch {
 	}
 };
 
+/**
+ * @brief order in which the branches of a queue are processed
+ */
+enum class NodeSelection {
+	DEPTH,	// deepest first (depth first search)
+	LB,		// lowest lb first (best first search), deepest first on ties
+	GAP		// lowest ub - lb first, deepest first on ties
+};
+
+/**
+ * @brief comparator of a priority queue of branches: true if a is processed after b
+ */
+struct BranchOrder {
+	NodeSelection selection = NodeSelection::DEPTH;
+
+	bool operator()(const Branch& a, const Branch& b) const {
+		if ( selection == NodeSelection::LB && a.lb != b.lb ) {
+			return a.lb > b.lb;
+		}
+		if ( selection == NodeSelection::GAP && a.ub - a.lb != b.ub - b.lb ) {
+			return a.ub - a.lb > b.ub - b.lb;
+		}
+		return a < b;
+	}
+};
+
 #endif	// COMMON_HPP
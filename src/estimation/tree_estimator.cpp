@@ -0,0 +1,71 @@
+#include "tree_estimator.hpp"
+
+#include <vector>
+
+TreeSizeEstimator::TreeSizeEstimator()
+: _random{ThreadRandom::Get()()}
+{
+}
+
+TreeSizeEstimator::TreeSizeEstimator(uint64_t seed)
+: _random{seed}
+{
+}
+
+bool TreeSizeEstimator::Leaf(Graph& graph, unsigned short best_ub, int& lb, unsigned short& ub)
+{
+    lb = _clique_strat.FindClique(graph);
+    if ( lb >= best_ub ) {
+        return true;
+    }
+    _color_strat.Color(graph, ub);
+    return lb == ub;
+}
+
+double TreeSizeEstimator::Probe(const Graph& node, unsigned short best_ub, const std::atomic<bool>& stop, 
+                                int max_depth)
+{
+    GraphPtr current = node.Clone();
+    int lb;
+    unsigned short ub;
+    // weight: number of nodes the current one stands for
+    double estimate = 1;
+    double weight = 1;
+    if ( Leaf(*current, best_ub, lb, ub) ) {
+        return estimate;
+    }
+
+    for ( int depth = 0; depth < max_depth; depth++ ) {
+        if ( stop.load(std::memory_order_relaxed) ) {
+            return -1;
+        }
+        int u, v;
+        std::tie(u, v) = _branching_strat.ChooseVertices(*current);
+        if ( u == -1 || v == -1 ) {
+            break;
+        }
+
+        GraphPtr merge = current->Clone();
+        merge->MergeVertices(u, v);
+        GraphPtr add_edge = current->Clone();
+        add_edge->AddEdge(u, v);
+
+        // the leaves are counted as they are, the dive goes on in one of the others
+        std::vector<GraphPtr> inner;
+        for ( GraphPtr* child : {&merge, &add_edge} ) {
+            if ( Leaf(**child, best_ub, lb, ub) ) {
+                estimate += weight;
+            } else {
+                inner.push_back(std::move(*child));
+            }
+        }
+        if ( inner.empty() ) {
+            break;
+        }
+
+        weight *= inner.size();
+        estimate += weight;
+        current = std::move(inner[_random.Below(inner.size())]);
+    }
+    return estimate;
+}
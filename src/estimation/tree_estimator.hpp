@@ -0,0 +1,84 @@
+#ifndef TREE_ESTIMATOR_HPP
+#define TREE_ESTIMATOR_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "graph.hpp"
+#include "branching_strategy.hpp"
+#include "color.hpp"
+#include "fastwclq.hpp"
+#include "fast_random.hpp"
+
+/**
+ * @brief estimates the size of the subtree of a node with random dives (Knuth's estimator,
+ *        with Purdom's partial backtracking)
+ *
+ * @details a dive goes from the node down to a leaf, bounding both children of each node
+ *          it meets. The children that are leaves (lb >= best_ub, or lb == ub) are counted
+ *          exactly, and the dive continues into one of the others, picked uniformly, whose
+ *          estimate is multiplied by their number. The mean of many dives is an unbiased
+ *          estimate of the number of nodes of the subtree, for the given best_ub. <br>
+ *          The dives use their own strategies (heuristic clique, greedy coloring, neighbours
+ *          branching), so that they can run beside the search, which makes their estimate
+ *          approximate whenever the search uses other ones.
+ */
+class TreeSizeEstimator {
+    public:
+        /**
+         * @brief dives seeded from the random stream of the calling thread (see ThreadRandom)
+         */
+        TreeSizeEstimator();
+        explicit TreeSizeEstimator(uint64_t seed);
+
+        /**
+         * @brief a single dive from node
+         *
+         * @param node root of the subtree, it is not modified
+         * @param best_ub best coloring known, which prunes the nodes with lb >= best_ub
+         * @param stop checked at each level, the dive is abandoned as soon as it is set
+         * @param max_depth length of the dive after which it stops, so that a probe has a bounded cost
+         * @return estimate of the number of nodes of the subtree, -1 if stopped
+         */
+        double Probe(const Graph& node, unsigned short best_ub, const std::atomic<bool>& stop, 
+                     int max_depth = 10000);
+
+    private:
+        FastCliqueStrategy _clique_strat;
+        GreedyColorStrategy _color_strat;
+        NeighboursBranchingStrategy _branching_strat;
+        Xoshiro256 _random;
+
+        /**
+         * @return whether graph is a leaf of the search, its bounds in lb and ub
+         */
+        bool Leaf(Graph& graph, unsigned short best_ub, int& lb, unsigned short& ub);
+};
+
+/**
+ * @brief mean of the probes of a set of nodes, older probes fading out: the tree shrinks
+ *        as best_ub improves, so the recent probes are the relevant ones
+ */
+struct ProbeMean {
+    double sum = 0;
+    double count = 0;
+
+    void Add(double estimate) {
+        const double decay = 0.95;  // about the last 20 probes count
+        sum = sum * decay + estimate;
+        count = count * decay + 1;
+    }
+    double Mean() const { return count == 0 ? 0 : sum / count; }
+};
+
+/**
+ * @brief progress of a search, summed over all ranks
+ */
+struct ProgressEstimate {
+    long explored = 0;          // nodes processed
+    double tree_size = 0;       // estimated nodes of the whole tree, from the root probes
+    double remaining = 0;       // estimated nodes below the queued ones, from the frontier probes,
+                                // -1 while some rank has queued nodes but no probe yet
+};
+
+#endif // TREE_ESTIMATOR_HPP
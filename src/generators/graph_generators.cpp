@@ -0,0 +1,326 @@
+#include "graph_generators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+
+std::unique_ptr<CSRGraph> GeneratedGraph::ToCSRGraph() const {
+    return std::unique_ptr<CSRGraph>(CSRGraph::FromEdges(num_vertices, edges));
+}
+
+bool GeneratedGraph::WriteDimacs(const std::string& file_name) const {
+    std::ofstream out(file_name);
+    if ( !out ) {
+        return false;
+    }
+    out << "c " << name << "\n";
+    if ( chromatic_number > 0 ) {
+        out << "c chromatic number " << chromatic_number << "\n";
+    }
+    out << "p edge " << num_vertices << " " << edges.size() << "\n";
+    for ( const auto& [v, w] : edges ) {
+        out << "e " << v << " " << w << "\n";
+    }
+    return (bool) out;
+}
+
+/**
+ * @brief calls `visit(v, w)`, 0 <= w < v < n, for every pair drawn with probability p, jumping
+ *        over the pairs not drawn with a geometric distribution (Batagelj and Brandes)
+ */
+template <typename Visit>
+static void ForEachRandomPair(int n, double p, std::mt19937_64& random, Visit visit) {
+    if ( p <= 0 ) {
+        return;
+    }
+    if ( p >= 1 ) {
+        for ( int v = 1; v < n; v++ ) {
+            for ( int w = 0; w < v; w++ ) {
+                visit(v, w);
+            }
+        }
+        return;
+    }
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double log_q = std::log(1.0 - p);
+    long v = 1, w = -1;
+    while ( v < n ) {
+        w += 1 + (long) std::floor(std::log(1.0 - uniform(random)) / log_q);
+        while ( w >= v && v < n ) {
+            w -= v;
+            v++;
+        }
+        if ( v < n ) {
+            visit((int) v, (int) w);
+        }
+    }
+}
+
+/**
+ * @brief vertices 1..n shuffled and dealt into k classes whose sizes differ by at most one
+ */
+static std::vector<std::vector<int>> RandomClasses(int n, int k, std::mt19937_64& random) {
+    std::vector<int> vertices(n);
+    std::iota(vertices.begin(), vertices.end(), 1);
+    std::shuffle(vertices.begin(), vertices.end(), random);
+    std::vector<std::vector<int>> classes(k);
+    for ( int i = 0; i < n; i++ ) {
+        classes[i % k].push_back(vertices[i]);
+    }
+    return classes;
+}
+
+static std::pair<int, int> Ordered(int v, int w) {
+    return {std::min(v, w), std::max(v, w)};
+}
+
+GeneratedGraph GraphGenerator::Random(int n, double p, unsigned long seed) {
+    GeneratedGraph graph;
+    graph.num_vertices = n;
+    std::mt19937_64 random(seed);
+    ForEachRandomPair(n, p, random, [&graph](int v, int w) { graph.edges.emplace_back(w + 1, v + 1); });
+    return graph;
+}
+
+GeneratedGraph GraphGenerator::Leighton(int n, int k, long m, unsigned long seed) {
+    GeneratedGraph graph;
+    graph.num_vertices = n;
+    graph.chromatic_number = k;
+    std::mt19937_64 random(seed);
+    std::vector<std::vector<int>> classes = RandomClasses(n, k, random);
+
+    // a complete k-partite graph is the densest one the hidden coloring allows
+    long max_edges = (long) n * (n - 1) / 2;
+    for ( const std::vector<int>& color_class : classes ) {
+        max_edges -= (long) color_class.size() * (color_class.size() - 1) / 2;
+    }
+    m = std::min(m, max_edges);
+
+    std::set<std::pair<int, int>> added;
+    auto add_clique = [&graph, &added](const std::vector<int>& clique) {
+        for ( size_t i = 0; i < clique.size(); i++ ) {
+            for ( size_t j = i + 1; j < clique.size(); j++ ) {
+                if ( added.insert(Ordered(clique[i], clique[j])).second ) {
+                    graph.edges.push_back(Ordered(clique[i], clique[j]));
+                }
+            }
+        }
+    };
+
+    std::vector<int> colors(k);
+    std::iota(colors.begin(), colors.end(), 0);
+    std::vector<int> clique;
+    auto random_clique = [&](int size) {
+        std::shuffle(colors.begin(), colors.end(), random);
+        clique.clear();
+        for ( int i = 0; i < size; i++ ) {
+            const std::vector<int>& color_class = classes[colors[i]];
+            clique.push_back(color_class[std::uniform_int_distribution<size_t>(0, color_class.size() - 1)(random)]);
+        }
+    };
+
+    // the planted k-clique makes k colors necessary
+    random_clique(k);
+    add_clique(clique);
+    std::uniform_int_distribution<int> clique_size(2, std::max(2, k));
+    while ( k >= 2 && (long) graph.edges.size() < m ) {
+        random_clique(clique_size(random));
+        add_clique(clique);
+    }
+    return graph;
+}
+
+GeneratedGraph GraphGenerator::Queen(int n) {
+    GeneratedGraph graph;
+    graph.num_vertices = n * n;
+    graph.chromatic_number = n % 2 != 0 && n % 3 != 0 ? n : 0;
+    for ( int v = 0; v < n * n; v++ ) {
+        for ( int w = v + 1; w < n * n; w++ ) {
+            int row_v = v / n, column_v = v % n, row_w = w / n, column_w = w % n;
+            if ( row_v == row_w || column_v == column_w ||
+                 std::abs(row_v - row_w) == std::abs(column_v - column_w) ) {
+                graph.edges.emplace_back(v + 1, w + 1);
+            }
+        }
+    }
+    return graph;
+}
+
+GeneratedGraph GraphGenerator::Mycielski(int k) {
+    GeneratedGraph graph;
+    graph.num_vertices = 2;
+    graph.chromatic_number = k;
+    graph.edges.emplace_back(1, 2);
+    for ( int step = 2; step < k; step++ ) {
+        // a shadow n + v of every vertex v, adjacent to its neighbours, and a vertex adjacent to the shadows
+        int n = graph.num_vertices;
+        size_t original_edges = graph.edges.size();
+        for ( size_t i = 0; i < original_edges; i++ ) {
+            auto [v, w] = graph.edges[i];
+            graph.edges.emplace_back(v, n + w);
+            graph.edges.emplace_back(w, n + v);
+        }
+        for ( int v = 1; v <= n; v++ ) {
+            graph.edges.emplace_back(n + v, 2 * n + 1);
+        }
+        graph.num_vertices = 2 * n + 1;
+    }
+    return graph;
+}
+
+GeneratedGraph GraphGenerator::Planted(int n, int k, double p, bool flat, unsigned long seed) {
+    GeneratedGraph graph;
+    graph.num_vertices = n;
+    std::mt19937_64 random(seed);
+    std::vector<std::vector<int>> classes = RandomClasses(n, k, random);
+
+    if ( !flat ) {
+        std::vector<int> color(n + 1);
+        for ( int c = 0; c < k; c++ ) {
+            for ( int v : classes[c] ) {
+                color[v] = c;
+            }
+        }
+        ForEachRandomPair(n, p, random, [&graph, &color](int v, int w) {
+            if ( color[v + 1] != color[w + 1] ) {
+                graph.edges.emplace_back(w + 1, v + 1);
+            }
+        });
+        return graph;
+    }
+
+    for ( int c = 0; c < k; c++ ) {
+        for ( int d = c + 1; d < k; d++ ) {
+            const std::vector<int>& a = classes[c].size() <= classes[d].size() ? classes[c] : classes[d];
+            const std::vector<int>& b = classes[c].size() <= classes[d].size() ? classes[d] : classes[c];
+            long pairs = (long) a.size() * b.size();
+            long m = std::min(pairs, std::lround(p * pairs));
+            // diagonal d pairs a[i] with b[(i + d) % |b|]: every diagonal touches each vertex of a
+            // once and distinct vertices of b, so taking whole diagonals first keeps the degrees flat
+            for ( long e = 0; e < m; e++ ) {
+                size_t i = e % a.size(), diagonal = e / a.size();
+                graph.edges.push_back(Ordered(a[i], b[(i + diagonal) % b.size()]));
+            }
+        }
+    }
+    return graph;
+}
+
+GeneratedGraph GraphGenerator::Interference(int n, double degree, unsigned long seed) {
+    GeneratedGraph graph;
+    graph.num_vertices = n;
+    std::mt19937_64 random(seed);
+    std::uniform_real_distribution<double> start(0.0, n);
+    std::exponential_distribution<double> length(2.0 / std::max(degree, 1e-9));
+
+    // live range of vertex v + 1: [begin[v], end[v])
+    std::vector<double> begin(n), end(n);
+    for ( int v = 0; v < n; v++ ) {
+        begin[v] = start(random);
+        end[v] = begin[v] + length(random);
+    }
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&begin](int v, int w) { return begin[v] < begin[w]; });
+
+    std::vector<int> live;
+    size_t most_live = 0;
+    for ( int v : order ) {
+        live.erase(std::remove_if(live.begin(), live.end(), [&](int w) { return end[w] <= begin[v]; }), live.end());
+        for ( int w : live ) {
+            graph.edges.push_back(Ordered(v + 1, w + 1));
+        }
+        live.push_back(v);
+        most_live = std::max(most_live, live.size());
+    }
+    graph.chromatic_number = most_live;
+    return graph;
+}
+
+bool GraphGenerator::FromSpec(const std::string& spec, GeneratedGraph& result, std::string& error) {
+    static const std::map<std::string, std::vector<std::string>> families = {
+        {"gnp", {"n", "p", "seed"}},
+        {"leighton", {"n", "k", "m", "seed"}},
+        {"queen", {"n"}},
+        {"mycielski", {"k"}},
+        {"planted", {"n", "k", "p", "flat", "seed"}},
+        {"interference", {"n", "degree", "seed"}},
+    };
+
+    size_t colon = spec.find(':');
+    std::string family = spec.substr(0, colon);
+    auto keys = families.find(family);
+    if ( keys == families.end() ) {
+        error = "unknown graph family '" + family + "'";
+        return false;
+    }
+
+    std::map<std::string, std::string> values;
+    std::string name = family;
+    if ( colon != std::string::npos ) {
+        std::stringstream parameters(spec.substr(colon + 1));
+        std::string parameter;
+        while ( std::getline(parameters, parameter, ',') ) {
+            size_t equal = parameter.find('=');
+            std::string key = parameter.substr(0, equal);
+            if ( equal == std::string::npos ||
+                 std::find(keys->second.begin(), keys->second.end(), key) == keys->second.end() ) {
+                error = "invalid parameter '" + parameter + "' for " + family;
+                return false;
+            }
+            values[key] = parameter.substr(equal + 1);
+            name += "_" + key + values[key];
+        }
+    }
+
+    for ( const std::string& key : keys->second ) {
+        if ( key != "seed" && key != "flat" && key != "degree" && !values.count(key) ) {
+            error = "missing parameter " + key + " for " + family;
+            return false;
+        }
+    }
+
+    try {
+        auto integer = [&values](const std::string& key, long fallback) {
+            return values.count(key) ? std::stol(values[key]) : fallback;
+        };
+        auto real = [&values](const std::string& key, double fallback) {
+            return values.count(key) ? std::stod(values[key]) : fallback;
+        };
+        long n = integer("n", 1), k = integer("k", 1);
+        double p = real("p", 0);
+        unsigned long seed = integer("seed", 1);
+        if ( n < 1 || k < 1 || (values.count("k") && values.count("n") && k > n) || p < 0 || p > 1 ) {
+            error = "parameters out of range in " + spec;
+            return false;
+        }
+
+        if ( family == "gnp" ) {
+            result = Random(n, p, seed);
+        } else if ( family == "leighton" ) {
+            result = Leighton(n, k, integer("m", 0), seed);
+        } else if ( family == "queen" ) {
+            result = Queen(n);
+        } else if ( family == "mycielski" ) {
+            if ( k < 2 ) {
+                error = "mycielski needs k >= 2";
+                return false;
+            }
+            result = Mycielski(k);
+        } else if ( family == "planted" ) {
+            result = Planted(n, k, p, integer("flat", 0) != 0, seed);
+        } else {
+            result = Interference(n, real("degree", 8), seed);
+        }
+    } catch ( const std::exception& e ) {
+        error = "invalid value in " + spec;
+        return false;
+    }
+    result.name = name;
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef GRAPH_GENERATORS_HPP
+#define GRAPH_GENERATORS_HPP
+
+#include "csr_graph.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief graph built by a GraphGenerator: vertices 1..num_vertices, as in a DIMACS file
+ */
+struct GeneratedGraph {
+    std::string name;
+    int num_vertices = 0;
+    /**
+     * @brief edges (v, w) with v < w, each one listed once
+     */
+    std::vector<std::pair<int, int>> edges;
+    /**
+     * @brief chromatic number when the construction fixes it, 0 when unknown
+     */
+    int chromatic_number = 0;
+
+    /**
+     * @brief the graph, built without going through a file
+     */
+    std::unique_ptr<CSRGraph> ToCSRGraph() const;
+    /**
+     * @brief writes the graph as a DIMACS .col file, readable by CSRGraph::LoadFromDimacs
+     * @return false if the file cannot be written
+     */
+    bool WriteDimacs(const std::string& file_name) const;
+};
+
+/**
+ * @brief synthetic graphs for scaling and stress runs. Every generator is deterministic
+ *        given its seed, so that a spec names the same graph on every rank and every run
+ */
+class GraphGenerator {
+    public:
+        /**
+         * @brief Erdős–Rényi G(n, p): every pair is an edge with probability p. Pairs are
+         *        skipped geometrically, so sparse graphs cost O(n + m) and not O(n^2)
+         */
+        static GeneratedGraph Random(int n, double p, unsigned long seed);
+
+        /**
+         * @brief Leighton graph: a hidden k-coloring, a k-clique on it and random cliques of
+         *        2..k vertices of distinct colors until about m edges. The chromatic number is k
+         *        (the DIMACS le450_* graphs are built this way)
+         */
+        static GeneratedGraph Leighton(int n, int k, long m, unsigned long seed);
+
+        /**
+         * @brief n x n queen graph: squares are adjacent when a queen moves from one to the
+         *        other. The chromatic number is known to be n when n is coprime with 6
+         */
+        static GeneratedGraph Queen(int n);
+
+        /**
+         * @brief triangle free graph of chromatic number k >= 2, from K2 by k - 2 Mycielski
+         *        steps (the DIMACS mycielN.col is Mycielski(N + 1))
+         */
+        static GeneratedGraph Mycielski(int k);
+
+        /**
+         * @brief random graph with a planted k-coloring: n vertices in k classes of equal size,
+         *        pairs of different classes are edges with probability p. When flat, every pair
+         *        of classes gets round(p |A| |B|) edges spread so that, towards another class,
+         *        the degrees of its vertices differ by at most one (two when k does not divide n),
+         *        as in Culberson's flat graphs: degree based heuristics get no hint of the
+         *        coloring. At most k colors are needed
+         */
+        static GeneratedGraph Planted(int n, int k, double p, bool flat, unsigned long seed);
+
+        /**
+         * @brief large sparse graph shaped like the interference graph of a register allocator:
+         *        n live ranges over a program of n points, with random starts and exponential
+         *        lengths of mean degree / 2, interfering when they overlap. Being an interval
+         *        graph, its chromatic number is the highest number of live ranges at one point
+         */
+        static GeneratedGraph Interference(int n, double degree, unsigned long seed);
+
+        /**
+         * @brief builds the graph of a spec `<family>:<key>=<value>,...`, e.g. gnp:n=200,p=0.1,seed=3
+         *
+         * @details families and keys (defaults in brackets):
+         *          gnp: n, p, seed [1] <br>
+         *          leighton: n, k, m, seed [1] <br>
+         *          queen: n <br>
+         *          mycielski: k <br>
+         *          planted: n, k, p, flat [0], seed [1] <br>
+         *          interference: n, degree [8], seed [1]
+         * @param error set when the spec is invalid
+         * @return false if the spec is invalid
+         */
+        static bool FromSpec(const std::string& spec, GeneratedGraph& result, std::string& error);
+};
+
+#endif // GRAPH_GENERATORS_HPP
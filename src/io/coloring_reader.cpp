@@ -0,0 +1,66 @@
+#include "coloring_reader.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+/**
+ * @brief parses a non-negative integer starting at `*cursor`, skipping leading blanks
+ * @return false if no digit is found
+ */
+bool ParseUnsigned(const char*& cursor, unsigned long& value) {
+    while ( *cursor == ' ' || *cursor == '\t' ) cursor++;
+    if ( *cursor < '0' || *cursor > '9' ) {
+        return false;
+    }
+    char* end;
+    value = std::strtoul(cursor, &end, 10);
+    cursor = end;
+    return true;
+}
+
+}
+
+bool ReadColoring(const std::string& file_name, std::vector<unsigned short>& full_coloring,
+                  std::string& error)
+{
+    std::ifstream in(file_name);
+    if ( !in.is_open() ) {
+        error = "Could not open coloring file " + file_name;
+        return false;
+    }
+
+    full_coloring.assign(1, 0);
+    size_t num_colored = 0;
+    std::string line;
+    while ( std::getline(in, line) ) {
+        const char* cursor = line.c_str();
+        unsigned long vertex, color;
+        if ( !ParseUnsigned(cursor, vertex) || !ParseUnsigned(cursor, color) ) {
+            continue;
+        }
+        // anything after the two numbers (apart from blanks) means it is not a coloring line
+        while ( *cursor == ' ' || *cursor == '\t' || *cursor == '\r' ) cursor++;
+        if ( *cursor != '\0' ) {
+            continue;
+        }
+        if ( vertex > INT_MAX || color > USHRT_MAX ) {
+            error = "Value out of range in coloring file: " + line;
+            return false;
+        }
+
+        if ( vertex >= full_coloring.size() ) {
+            full_coloring.resize(vertex + 1, 0);
+        }
+        full_coloring[vertex] = color;
+        num_colored++;
+    }
+
+    if ( num_colored == 0 ) {
+        error = "No `vertex color` line found in " + file_name;
+        return false;
+    }
+    return true;
+}
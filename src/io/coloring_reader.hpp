@@ -0,0 +1,21 @@
+#ifndef COLORING_READER_HPP
+#define COLORING_READER_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief reads a coloring written either in the format of results/<name>.txt or as plain
+ *        `vertex color` lines. Lines which do not start with two integers (e.g. the
+ *        header of the results files) are skipped
+ * 
+ * @param file_name file to read
+ * @param full_coloring filled such that full_coloring[vertex] is the color of vertex,
+ *                      vertices not listed in the file are left with color 0
+ * @param error set to a description of the problem when false is returned
+ * @return false if the file could not be opened or contains no coloring
+ */
+bool ReadColoring(const std::string& file_name, std::vector<unsigned short>& full_coloring,
+                  std::string& error);
+
+#endif // COLORING_READER_HPP
@@ -0,0 +1,44 @@
+#include "graph_fingerprint.hpp"
+
+#include <cstdio>
+
+namespace {
+
+// splitmix64 finalizer, spreads every input bit over the whole word
+uint64_t Mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+}
+
+uint64_t GraphFingerprint(const CSRGraph& graph)
+{
+    uint64_t edges_hash = 0;
+    uint64_t num_edges = 0;
+    for ( int vertex : graph.GetVertices() ) {
+        for ( int neighbour : graph.GetAdjacency(vertex) ) {
+            // each undirected edge is stored in both rows, only (min, max) is counted
+            if ( neighbour < vertex ) {
+                continue;
+            }
+            edges_hash += Mix((static_cast<uint64_t>(vertex) << 32) | static_cast<uint32_t>(neighbour));
+            num_edges++;
+        }
+    }
+
+    uint64_t fingerprint = Mix(edges_hash);
+    fingerprint = Mix(fingerprint ^ graph.GetNumVertices());
+    fingerprint = Mix(fingerprint ^ static_cast<uint64_t>(graph.GetHighestVertex()));
+    fingerprint = Mix(fingerprint ^ num_edges);
+    return fingerprint;
+}
+
+std::string FingerprintToString(uint64_t fingerprint)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(fingerprint));
+    return buffer;
+}
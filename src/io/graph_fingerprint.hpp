@@ -0,0 +1,28 @@
+#ifndef GRAPH_FINGERPRINT_HPP
+#define GRAPH_FINGERPRINT_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief computes a 64-bit hash of the edge set of the graph
+ * 
+ * @details every edge is canonicalized as (min, max) and hashed on its own; the hashes 
+ *          are then summed, so the result does not depend on the order of the
+ *          neighbour lists or of the edges in the DIMACS file. The number of vertices 
+ *          and the highest vertex label are mixed in, to tell apart graphs which only 
+ *          differ by isolated vertices
+ * 
+ * @param graph graph to hash
+ * @return fingerprint of the graph
+ */
+uint64_t GraphFingerprint(const CSRGraph& graph);
+
+/**
+ * @brief formats a fingerprint as 16 hexadecimal digits
+ */
+std::string FingerprintToString(uint64_t fingerprint);
+
+#endif // GRAPH_FINGERPRINT_HPP
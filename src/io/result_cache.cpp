@@ -0,0 +1,125 @@
+#include "result_cache.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "graph_fingerprint.hpp"
+
+ResultCache::ResultCache(const std::string& directory)
+: _directory{directory}
+{
+}
+
+std::string ResultCache::EntryPath(uint64_t fingerprint) const
+{
+    return (std::filesystem::path(_directory) / (FingerprintToString(fingerprint) + ".txt")).string();
+}
+
+bool ResultCache::Lookup(uint64_t fingerprint, CacheEntry& entry) const
+{
+    std::ifstream in(EntryPath(fingerprint));
+    if ( !in.is_open() ) {
+        return false;
+    }
+
+    entry = CacheEntry();
+    std::string line;
+    while ( std::getline(in, line) ) {
+        std::istringstream iss(line);
+        std::string key;
+        if ( !(iss >> key) ) {
+            continue;
+        }
+
+        if ( key == "lower_bound" ) {
+            iss >> entry.lower_bound;
+        } else if ( key == "upper_bound" ) {
+            iss >> entry.upper_bound;
+        } else if ( key == "optimal" ) {
+            iss >> entry.optimal;
+        } else if ( key[0] >= '0' && key[0] <= '9' ) {
+            // a corrupt entry is a miss, the next Store rewrites it
+            char* end;
+            errno = 0;
+            unsigned long vertex = std::strtoul(key.c_str(), &end, 10);
+            if ( errno == ERANGE || *end != '\0' || vertex > INT_MAX ) {
+                entry = CacheEntry();
+                return false;
+            }
+            unsigned short color;
+            if ( !(iss >> color) ) {
+                continue;
+            }
+            if ( vertex >= entry.coloring.size() ) {
+                entry.coloring.resize(vertex + 1, 0);
+            }
+            entry.coloring[vertex] = color;
+        }
+    }
+
+    return true;
+}
+
+bool ResultCache::Store(uint64_t fingerprint, const std::string& instance_name, const CacheEntry& entry) const
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    if ( error ) {
+        return false;
+    }
+
+    CacheEntry merged = entry;
+    CacheEntry cached;
+    if ( Lookup(fingerprint, cached) ) {
+        merged.lower_bound = std::max(merged.lower_bound, cached.lower_bound);
+        if ( cached.upper_bound < merged.upper_bound && !cached.coloring.empty() ) {
+            merged.upper_bound = cached.upper_bound;
+            merged.coloring = std::move(cached.coloring);
+        }
+        merged.optimal = merged.optimal || cached.optimal;
+    }
+    if ( merged.lower_bound >= merged.upper_bound ) {
+        merged.lower_bound = merged.upper_bound;
+        merged.optimal = true;
+    }
+    if ( merged.optimal ) {
+        merged.lower_bound = merged.upper_bound;
+    }
+
+    std::string out;
+    out.reserve(128 + merged.coloring.size() * 10);
+    out.append("instance ").append(instance_name).append("\n");
+    out.append("lower_bound ").append(std::to_string(merged.lower_bound)).append("\n");
+    out.append("upper_bound ").append(std::to_string(merged.upper_bound)).append("\n");
+    out.append("optimal ").append(merged.optimal ? "1" : "0").append("\n");
+    for ( size_t vertex = 0; vertex < merged.coloring.size(); vertex++ ) {
+        if ( merged.coloring[vertex] == 0 ) {
+            continue;
+        }
+        out.append(std::to_string(vertex)).append(" ")
+           .append(std::to_string(merged.coloring[vertex])).append("\n");
+    }
+
+    // write to a private file and rename it, so readers never see a partial entry
+    std::string path = EntryPath(fingerprint);
+    std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(tmp_path, std::ios::binary);
+        if ( !file.is_open() ) {
+            return false;
+        }
+        file.write(out.data(), out.size());
+        if ( !file ) {
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp_path, path, error);
+    return !error;
+}
@@ -0,0 +1,59 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief what is known about the chromatic number of a graph
+ */
+struct CacheEntry {
+    unsigned short lower_bound = 0;
+    unsigned short upper_bound = USHRT_MAX;
+    // true if upper_bound is the chromatic number
+    bool optimal = false;
+    // coloring with upper_bound colors, full_coloring[vertex] is the color of vertex
+    std::vector<unsigned short> coloring;
+};
+
+/**
+ * @brief on-disk cache of solved instances, one file per graph fingerprint 
+ *        (see GraphFingerprint) inside the cache directory
+ * 
+ * @details each file holds `key value` lines for the bounds followed by the best 
+ *          known coloring as `vertex color` lines. Files are replaced atomically,
+ *          so several jobs can share the same directory
+ */
+class ResultCache {
+    public:
+        ResultCache(const std::string& directory);
+
+        /**
+         * @brief looks for the entry of a graph
+         * 
+         * @param fingerprint fingerprint of the graph
+         * @param entry filled with the cached bounds and coloring
+         * @return true if the graph is in the cache, false also for an entry which cannot be read
+         */
+        bool Lookup(uint64_t fingerprint, CacheEntry& entry) const;
+
+        /**
+         * @brief merges `entry` with the cached one (the highest lower bound and the 
+         *        lowest upper bound are kept) and writes the result
+         * 
+         * @param fingerprint fingerprint of the graph
+         * @param instance_name name of the instance, only stored for readability
+         * @param entry bounds and coloring found by the last run
+         * @return false if the entry could not be written
+         */
+        bool Store(uint64_t fingerprint, const std::string& instance_name, const CacheEntry& entry) const;
+
+    private:
+        std::string _directory;
+
+        std::string EntryPath(uint64_t fingerprint) const;
+};
+
+#endif // RESULT_CACHE_HPP
@@ -0,0 +1,282 @@
+#include "result_writer.hpp"
+
+#include <omp.h>
+
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+void Append(std::string& out, long long value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void Append(std::string& out, double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    out.append(buffer, length);
+}
+
+// counters are written in full, %g would round them to 6 digits
+void AppendStatistic(std::string& out, double value) {
+    if ( value > -1e18 && value < 1e18 && value == (long long) value ) {
+        Append(out, (long long) value);
+    } else {
+        Append(out, value);
+    }
+}
+
+void AppendJsonString(std::string& out, const std::string& value) {
+    out.push_back('"');
+    for ( char c : value ) {
+        switch ( c ) {
+            case '"':  out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n");  break;
+            case '\t': out.append("\\t");  break;
+            default:
+                if ( static_cast<unsigned char>(c) < 0x20 ) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out.append(buffer);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+bool WriteBuffer(const std::string& file_name, const std::string& buffer) {
+    std::ofstream out(file_name, std::ios::binary);
+    if ( !out.is_open() ) {
+        return false;
+    }
+    out.write(buffer.data(), buffer.size());
+    return static_cast<bool>(out);
+}
+
+}
+
+ResultWriter::ResultWriter(const std::string& instance_name)
+: _instance_name{instance_name}, _num_vertices{0}, _num_edges{0}, _time_limit_sec{0},
+  _num_processes{1}, _num_cores_per_process{1}, _wall_time_sec{-1.0}, _number_of_colors{0}
+{
+}
+
+void ResultWriter::SetGraphSize(size_t num_vertices, size_t num_edges)
+{
+    _num_vertices = num_vertices;
+    _num_edges = num_edges;
+}
+
+void ResultWriter::SetResources(int num_processes, int num_cores_per_process)
+{
+    _num_processes = num_processes;
+    _num_cores_per_process = num_cores_per_process;
+}
+
+void ResultWriter::SetColoring(const std::vector<int>& vertices, 
+                               const std::vector<unsigned short>& full_coloring)
+{
+    _vertices = vertices;
+    _full_coloring = full_coloring;
+
+    _number_of_colors = 0;
+    for ( unsigned short color : _full_coloring ) {
+        if ( color > _number_of_colors ) {
+            _number_of_colors = color;
+        }
+    }
+}
+
+void ResultWriter::AddTiming(const std::string& name, double seconds)
+{
+    _timings.emplace_back(name, seconds);
+}
+
+void ResultWriter::AddCounter(const std::string& name, long long value)
+{
+    _counters.emplace_back(name, value);
+}
+
+void ResultWriter::AddFeature(const std::string& name, double value)
+{
+    _features.emplace_back(name, value);
+}
+
+void ResultWriter::AddStatistic(const std::string& name, double value)
+{
+    _statistics.emplace_back(name, value);
+}
+
+void ResultWriter::SetTuning(int color_strategy, int balanced, int sol_gather_period, 
+                             const std::string& rule, const std::string& rationale)
+{
+    _tuned = true;
+    _tuned_settings[0] = color_strategy;
+    _tuned_settings[1] = balanced;
+    _tuned_settings[2] = sol_gather_period;
+    _tuning_rule = rule;
+    _tuning_rationale = rationale;
+}
+
+bool ResultWriter::WriteText(const std::string& file_name) const
+{
+    std::string out;
+    // header + ~10 characters for each "vertex color" line
+    out.reserve(512 + _vertices.size() * 10);
+
+    out.append("problem_instance_file_name ").append(_instance_name).append("\n");
+    out.append("cmd line ").append(_command_line).append("\n");
+    out.append("solver version ").append(_solver_version).append("\n");
+    if ( _tuned ) {
+        out.append("tuned color_strategy ");    Append(out, (long long) _tuned_settings[0]);
+        out.append(" balanced ");               Append(out, (long long) _tuned_settings[1]);
+        out.append(" sol_gather_period ");      Append(out, (long long) _tuned_settings[2]);   out.push_back('\n');
+        out.append("tuning_rationale ").append(_tuning_rationale).append("\n");
+    }
+    out.append("number_of_vertices ");          Append(out, (long long) _num_vertices);          out.push_back('\n');
+    out.append("number_of_edges: ");            Append(out, (long long) _num_edges);             out.push_back('\n');
+    out.append("time_limit_sec ");              Append(out, (long long) _time_limit_sec);        out.push_back('\n');
+    out.append("number_of_worker_processes ");  Append(out, (long long) _num_processes);         out.push_back('\n');
+    out.append("number_of_cores_per_worker ");  Append(out, (long long) _num_cores_per_process); out.push_back('\n');
+    if ( _wall_time_sec == -1 ) {
+        out.append("wall_time_sec > 10000\n");
+        out.append("is_within_time_limit 0\n");
+    } else {
+        out.append("wall_time_sec ");           Append(out, _wall_time_sec);                     out.push_back('\n');
+        out.append("is_within_time_limit 1\n");
+    }
+    for ( const auto& [name, value] : _statistics ) {
+        out.append("stat ").append(name).push_back(' ');
+        AppendStatistic(out, value);
+        out.push_back('\n');
+    }
+    out.append("number_of_colors ");            Append(out, (long long) _number_of_colors);      out.push_back('\n');
+
+    for ( int vertex : _vertices ) {
+        Append(out, (long long) vertex);
+        out.push_back(' ');
+        Append(out, (long long) _full_coloring[vertex]);
+        out.push_back('\n');
+    }
+
+    return WriteBuffer(file_name, out);
+}
+
+bool ResultWriter::WriteJson(const std::string& file_name) const
+{
+    std::string out;
+    out.reserve(1024 + _vertices.size() * 16);
+
+    out.append("{\n  \"problem_instance_file_name\": ");  AppendJsonString(out, _instance_name);
+    out.append(",\n  \"cmd_line\": ");                     AppendJsonString(out, _command_line);
+    out.append(",\n  \"solver_version\": ");               AppendJsonString(out, _solver_version);
+    out.append(",\n  \"number_of_vertices\": ");           Append(out, (long long) _num_vertices);
+    out.append(",\n  \"number_of_edges\": ");              Append(out, (long long) _num_edges);
+    out.append(",\n  \"time_limit_sec\": ");               Append(out, (long long) _time_limit_sec);
+    out.append(",\n  \"number_of_worker_processes\": ");   Append(out, (long long) _num_processes);
+    out.append(",\n  \"number_of_cores_per_worker\": ");   Append(out, (long long) _num_cores_per_process);
+    out.append(",\n  \"wall_time_sec\": ");
+    if ( _wall_time_sec == -1 ) {
+        out.append("null");
+    } else {
+        Append(out, _wall_time_sec);
+    }
+    out.append(",\n  \"is_within_time_limit\": ").append(_wall_time_sec == -1 ? "false" : "true");
+    out.append(",\n  \"number_of_colors\": ");             Append(out, (long long) _number_of_colors);
+
+    out.append(",\n  \"timings\": {");
+    for ( size_t i = 0; i < _timings.size(); i++ ) {
+        out.append(i == 0 ? "\n    " : ",\n    ");
+        AppendJsonString(out, _timings[i].first);
+        out.append(": ");
+        Append(out, _timings[i].second);
+    }
+    out.append(_timings.empty() ? "}" : "\n  }");
+
+    out.append(",\n  \"counters\": {");
+    for ( size_t i = 0; i < _counters.size(); i++ ) {
+        out.append(i == 0 ? "\n    " : ",\n    ");
+        AppendJsonString(out, _counters[i].first);
+        out.append(": ");
+        Append(out, _counters[i].second);
+    }
+    out.append(_counters.empty() ? "}" : "\n  }");
+
+    out.append(",\n  \"features\": {");
+    for ( size_t i = 0; i < _features.size(); i++ ) {
+        out.append(i == 0 ? "\n    " : ",\n    ");
+        AppendJsonString(out, _features[i].first);
+        out.append(": ");
+        Append(out, _features[i].second);
+    }
+    out.append(_features.empty() ? "}" : "\n  }");
+
+    out.append(",\n  \"statistics\": {");
+    for ( size_t i = 0; i < _statistics.size(); i++ ) {
+        out.append(i == 0 ? "\n    " : ",\n    ");
+        AppendJsonString(out, _statistics[i].first);
+        out.append(": ");
+        AppendStatistic(out, _statistics[i].second);
+    }
+    out.append(_statistics.empty() ? "}" : "\n  }");
+
+    if ( _tuned ) {
+        out.append(",\n  \"tuning\": {\n    \"color_strategy\": ");  Append(out, (long long) _tuned_settings[0]);
+        out.append(",\n    \"balanced\": ");                         Append(out, (long long) _tuned_settings[1]);
+        out.append(",\n    \"sol_gather_period\": ");                Append(out, (long long) _tuned_settings[2]);
+        out.append(",\n    \"rule\": ");                             AppendJsonString(out, _tuning_rule);
+        out.append(",\n    \"rationale\": ");                        AppendJsonString(out, _tuning_rationale);
+        out.append("\n  }");
+    }
+
+    // [vertex, color] pairs
+    out.append(",\n  \"coloring\": [");
+    for ( size_t i = 0; i < _vertices.size(); i++ ) {
+        out.append(i == 0 ? "[" : ", [");
+        Append(out, (long long) _vertices[i]);
+        out.append(", ");
+        Append(out, (long long) _full_coloring[_vertices[i]]);
+        out.push_back(']');
+    }
+    out.append("]\n}\n");
+
+    return WriteBuffer(file_name, out);
+}
+
+bool VerifyColoring(const CSRGraph& graph, const std::vector<unsigned short>& full_coloring)
+{
+    const std::vector<int>& vertices = graph.GetVertices();
+    const long num_vertices = vertices.size();
+    std::atomic<bool> valid = true;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for ( long i = 0; i < num_vertices; i++ ) {
+        // no early exit from an omp loop, remaining iterations just skip the work
+        if ( !valid.load(std::memory_order_relaxed) ) {
+            continue;
+        }
+
+        const int vertex = vertices[i];
+        if ( vertex >= (int) full_coloring.size() || full_coloring[vertex] == 0 ) {
+            valid.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        const unsigned short color = full_coloring[vertex];
+        for ( int neighbour : graph.GetAdjacency(vertex) ) {
+            if ( neighbour >= (int) full_coloring.size() || full_coloring[neighbour] == color ) {
+                valid.store(false, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+    return valid.load();
+}
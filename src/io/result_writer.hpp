@@ -0,0 +1,112 @@
+#ifndef RESULT_WRITER_HPP
+#define RESULT_WRITER_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief collects the outcome of a run and writes it either in the text format of
+ *        results/<name>.txt or as JSON, which additionally carries timings and counters
+ * 
+ * @details the whole file is built in memory and written with a single call, instead
+ *          of flushing one line per vertex
+ */
+class ResultWriter {
+    public:
+        ResultWriter(const std::string& instance_name);
+
+        void SetCommandLine(const std::string& command_line) { _command_line = command_line; }
+        void SetSolverVersion(const std::string& version)    { _solver_version = version; }
+        void SetGraphSize(size_t num_vertices, size_t num_edges);
+        void SetTimeLimit(int time_limit_sec)                { _time_limit_sec = time_limit_sec; }
+        void SetResources(int num_processes, int num_cores_per_process);
+        /**
+         * @brief sets the time at which the solver finished
+         * @param wall_time_sec time needed, -1 if the time limit was reached
+         */
+        void SetWallTime(double wall_time_sec)               { _wall_time_sec = wall_time_sec; }
+        /**
+         * @brief sets the coloring to write
+         * 
+         * @param vertices vertices to write, in the order they are written
+         * @param full_coloring coloring such that full_coloring[vertex] is the color of vertex
+         */
+        void SetColoring(const std::vector<int>& vertices, 
+                         const std::vector<unsigned short>& full_coloring);
+
+        /**
+         * @brief adds a named timing (in seconds), only written in the JSON variant
+         */
+        void AddTiming(const std::string& name, double seconds);
+        /**
+         * @brief adds a named counter, only written in the JSON variant
+         */
+        void AddCounter(const std::string& name, long long value);
+        /**
+         * @brief adds a named feature of the instance, only written in the JSON variant
+         */
+        void AddFeature(const std::string& name, double value);
+        /**
+         * @brief adds a named statistic of the search (counters and phase times of the solver),
+         *        written in both variants
+         */
+        void AddStatistic(const std::string& name, double value);
+        /**
+         * @brief records the settings picked by the tuner and the reason, written in both variants
+         */
+        void SetTuning(int color_strategy, int balanced, int sol_gather_period, 
+                       const std::string& rule, const std::string& rationale);
+
+        unsigned short GetNumberOfColors() const { return _number_of_colors; }
+
+        /**
+         * @brief writes the result with the same format of the files in results/
+         * @return false if the file could not be written
+         */
+        bool WriteText(const std::string& file_name) const;
+        /**
+         * @brief writes the result, timings and counters as a JSON object
+         * @return false if the file could not be written
+         */
+        bool WriteJson(const std::string& file_name) const;
+
+    private:
+        std::string _instance_name;
+        std::string _command_line;
+        std::string _solver_version;
+        size_t _num_vertices;
+        size_t _num_edges;
+        int _time_limit_sec;
+        int _num_processes;
+        int _num_cores_per_process;
+        double _wall_time_sec;
+        unsigned short _number_of_colors;
+
+        std::vector<int> _vertices;
+        std::vector<unsigned short> _full_coloring;
+        std::vector<std::pair<std::string, double>> _timings;
+        std::vector<std::pair<std::string, long long>> _counters;
+        std::vector<std::pair<std::string, double>> _features;
+        std::vector<std::pair<std::string, double>> _statistics;
+
+        bool _tuned = false;
+        int _tuned_settings[3];     // color_strategy, balanced, sol_gather_period
+        std::string _tuning_rule;
+        std::string _tuning_rationale;
+};
+
+/**
+ * @brief checks, in parallel, that every vertex is colored and that no edge joins 
+ *        two vertices with the same color. Neighbour lists are read in place,
+ *        so no memory is allocated
+ * 
+ * @param graph graph whose edges are checked
+ * @param full_coloring coloring such that full_coloring[vertex] is the color of vertex
+ * @return true if the coloring is valid
+ */
+bool VerifyColoring(const CSRGraph& graph, const std::vector<unsigned short>& full_coloring);
+
+#endif // RESULT_WRITER_HPP
@@ -0,0 +1,142 @@
+#include "event_log.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+EventLog::EventLog(const std::string& file_name, bool enabled)
+: _enabled{enabled}
+{
+    _file.open(file_name, std::ios::binary);
+    if ( !_file.is_open() ) {
+        throw std::runtime_error("Failed to open log file: " + file_name);
+    }
+
+    int32_t rank = 0;
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if ( initialized ) {
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    }
+    _file.write(MAGIC, sizeof(MAGIC));
+    _file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    _file.write(reinterpret_cast<const char*>(&rank), sizeof(rank));
+    _file.flush();
+
+    if ( _enabled ) {
+        for ( ThreadBuffer& buffer : _buffers ) {
+            buffer.records.reserve(BUFFER_RECORDS);
+        }
+    }
+}
+
+EventLog::~EventLog()
+{
+    Flush();
+}
+
+void EventLog::Record(LogEvent event, int depth, int32_t arg0, int32_t arg1, int32_t arg2)
+{
+    int thread = std::min(omp_get_thread_num(), MAX_THREADS - 1);
+    std::vector<EventRecord>& records = _buffers[thread].records;
+    records.push_back({MPI_Wtime(), static_cast<uint16_t>(event), static_cast<uint8_t>(thread),
+                       static_cast<uint8_t>(std::clamp(depth, 0, 255)), {arg0, arg1, arg2}});
+    if ( records.size() == BUFFER_RECORDS ) {
+        Write(records);
+    }
+}
+
+void EventLog::Flush()
+{
+    for ( ThreadBuffer& buffer : _buffers ) {
+        Write(buffer.records);
+    }
+}
+
+void EventLog::Write(std::vector<EventRecord>& records)
+{
+    if ( records.empty() ) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_file_mutex);
+    _file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(EventRecord));
+    _file.flush();
+    records.clear();
+}
+
+const char* EventLog::Format(LogEvent event)
+{
+    switch ( event ) {
+        case LogEvent::INIT_COLORING:           return "[INITIALIZATION] Initial coloring given: ub = %d";
+        case LogEvent::INIT_BOUNDS:             return "[INITIALIZATION] Initial bounds: lb = %d, ub = %d";
+        case LogEvent::TIMEOUT:                 return "[TERMINATION]: Timeout reached.";
+        case LogEvent::SOLUTION_COMMUNICATED:   return "[TERMINATION]: Solution found communicated.";
+        case LogEvent::GROUP_IDLE:              return "[TERMINATION]: All processes of group %d idle.";
+        case LogEvent::BOUND_MET:               return "[TERMINATION]: Best coloring meets the lower bound.";
+        case LogEvent::GATHERED_UB:             return "[UPDATE] Gathered best_ub %d";
+        case LogEvent::NOGOODS_LEARNT:          return "[NOGOOD] Learnt %d nogoods from the other ranks";
+        case LogEvent::NOGOODS_KEPT:            return "[NOGOOD] %d nogoods kept, %d children pruned";
+        case LogEvent::REQUEST_WORK:            return "[REQUEST] Requesting work...";
+        case LogEvent::WORK_RECEIVED:           return "[REQUEST] Work received.";
+        case LogEvent::PROCESS_NODE:            return "[BRANCH] Processing node: lb = %d, ub = %d";
+        case LogEvent::FOUND:                   return "[FOUND] Chromatic number found: %d";
+        case LogEvent::FOUND_AT_ROOT:           return "[FOUND] Chromatic number found (very first computation at root): %d";
+        case LogEvent::END:                     return "========== END ==========";
+        case LogEvent::PRUNE_EQUAL:             return "[PRUNE] Branch pruned at depth %d: lb = %d == ub = %d";
+        case LogEvent::PRUNE_BEST:              return "[PRUNE] Branch pruned at depth %d: lb = %d >= best_ub = %d";
+        case LogEvent::UPDATE_UB:               return "[UPDATE] Updated best_ub: %d";
+        case LogEvent::SAT_UNSAT:               return "[SAT] No coloring with %d colors: branch pruned";
+        case LogEvent::SAT_UB:                  return "[SAT] Updated best_ub: %d";
+        case LogEvent::BRANCH_VERTICES:         return "[BRANCH] Branching on vertices: u = %d, v = %d";
+        case LogEvent::SYMMETRY:                return "[Symmetry] added %d edges";
+        case LogEvent::ADD_EDGE:                return "[Add Edge] depth %d, lb = %d, ub = %d";
+        case LogEvent::MERGE:                   return "[Merge] depth %d, lb = %d, ub = %d";
+        case LogEvent::NOGOOD_ADD_EDGE:         return "[NOGOOD] Add edge child pruned";
+        case LogEvent::NOGOOD_MERGE:            return "[NOGOOD] Merge child pruned";
+        case LogEvent::BRANCH_MERGE:            return "[Branch 1] (Merge u, v) lb = %d, ub = %d";
+        case LogEvent::BRANCH_ADD_EDGE:         return "[Branch 2] (Add edge u-v) lb = %d, ub = %d";
+        case LogEvent::FINALIZING:              return "[TERMINATION] Finalizing... ";
+        default:                                return "[UNKNOWN] event %d %d %d";
+    }
+}
+
+std::string EventLog::Render(const EventRecord& record, int rank)
+{
+    char message[160];
+    std::snprintf(message, sizeof(message), Format(static_cast<LogEvent>(record.event)),
+                  record.args[0], record.args[1], record.args[2]);
+
+    std::ostringstream line;
+    line << std::string(record.depth * 2, ' ') << "[Rank " << rank << " | Thread " << (int) record.thread << "] "
+         << "[Time " << record.time << "] " << message;
+    return line.str();
+}
+
+bool EventLog::Read(const std::string& file_name, int& rank, std::vector<EventRecord>& records)
+{
+    std::ifstream in(file_name, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    uint32_t version;
+    int32_t file_rank;
+    if ( !in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+         !in.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != VERSION ||
+         !in.read(reinterpret_cast<char*>(&file_rank), sizeof(file_rank)) ) {
+        return false;
+    }
+    rank = file_rank;
+
+    records.clear();
+    EventRecord record;
+    while ( in.read(reinterpret_cast<char*>(&record), sizeof(record)) ) {
+        records.push_back(record);
+    }
+    std::stable_sort(records.begin(), records.end(), [](const EventRecord& a, const EventRecord& b) {
+        return a.time < b.time;
+    });
+    return true;
+}
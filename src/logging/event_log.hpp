@@ -0,0 +1,144 @@
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// LOG_EVENT call sites compile to nothing when the build disables the event log
+#ifndef GCN_EVENT_LOG
+#define GCN_EVENT_LOG 1
+#endif
+
+/**
+ * @brief events of the solvers, each rendered by the decoder with its format (see EventLog::Format)
+ */
+enum class LogEvent : uint16_t {
+    INIT_COLORING,      // ub
+    INIT_BOUNDS,        // lb, ub
+    TIMEOUT,
+    SOLUTION_COMMUNICATED,
+    GROUP_IDLE,         // group
+    BOUND_MET,
+    GATHERED_UB,        // best_ub
+    NOGOODS_LEARNT,     // learnt
+    NOGOODS_KEPT,       // nogoods, hits
+    REQUEST_WORK,
+    WORK_RECEIVED,
+    PROCESS_NODE,       // lb, ub
+    FOUND,              // ub
+    FOUND_AT_ROOT,      // lb
+    END,
+    PRUNE_EQUAL,        // depth, lb, ub
+    PRUNE_BEST,         // depth, lb, best_ub
+    UPDATE_UB,          // best_ub
+    SAT_UNSAT,          // colors
+    SAT_UB,             // best_ub
+    BRANCH_VERTICES,    // u, v
+    SYMMETRY,           // edges added
+    ADD_EDGE,           // depth, lb, ub
+    MERGE,              // depth, lb, ub
+    NOGOOD_ADD_EDGE,
+    NOGOOD_MERGE,
+    BRANCH_MERGE,       // lb, ub
+    BRANCH_ADD_EDGE,    // lb, ub
+    FINALIZING,
+    COUNT
+};
+
+/**
+ * @brief fixed-size binary record of an event
+ */
+struct EventRecord {
+    double time;        // MPI_Wtime
+    uint16_t event;     // LogEvent
+    uint8_t thread;     // OpenMP thread
+    uint8_t depth;      // indentation, depth of the node (saturated)
+    int32_t args[3];
+};
+static_assert(sizeof(EventRecord) == 24, "event records are written as they are");
+
+/**
+ * @brief typed event log of a rank, written in binary and rendered as text by decode_log
+ *
+ * @details an event is a fixed-size record, its arguments are integers and its message is
+ *          only formatted by the decoder, so logging builds no string and allocates nothing.
+ *          Every OpenMP thread fills its own buffer of records, without locks, which is
+ *          appended to the file when full (the only moment the threads synchronize) and
+ *          by Flush. <br>
+ *          The file starts with a header (magic, version, rank), followed by the records
+ *          in the order they were flushed: the decoder sorts them by time. <br>
+ *          Record must only be called from OpenMP threads with different numbers at the
+ *          same time, as the solvers do; use the LOG_EVENT macro, which evaluates nothing
+ *          when the log is disabled, at runtime or at compile time (GCN_EVENT_LOG=0).
+ */
+class EventLog {
+    public:
+        static constexpr char MAGIC[8] = {'G', 'C', 'N', 'L', 'O', 'G', '\0', '\0'};
+        static constexpr uint32_t VERSION = 1;
+        static constexpr int MAX_THREADS = 16;
+        static constexpr size_t BUFFER_RECORDS = 4096;
+
+        /**
+         * @param file_name binary file written
+         * @param enabled whether events are recorded, the file is created anyway
+         * @throws std::runtime_error if the file cannot be opened
+         */
+        EventLog(const std::string& file_name, bool enabled);
+        ~EventLog();
+
+        EventLog(const EventLog&) = delete;
+        EventLog& operator=(const EventLog&) = delete;
+
+        bool Enabled() const { return _enabled; }
+
+        void Record(LogEvent event, int depth, int32_t arg0 = 0, int32_t arg1 = 0, int32_t arg2 = 0);
+
+        /**
+         * @brief appends the buffered records of every thread to the file, only when no
+         *        thread is recording
+         */
+        void Flush();
+
+        /**
+         * @brief printf format of the message of an event, with up to three %d
+         */
+        static const char* Format(LogEvent event);
+
+        /**
+         * @brief the line of the text log of a record: indentation, rank, thread, time and message
+         */
+        static std::string Render(const EventRecord& record, int rank);
+
+        /**
+         * @brief reads a binary log
+         *
+         * @param rank rank which wrote it
+         * @param records its records, sorted by time
+         * @return false if the file cannot be read or is not an event log
+         */
+        static bool Read(const std::string& file_name, int& rank, std::vector<EventRecord>& records);
+
+    private:
+        struct alignas(64) ThreadBuffer {
+            std::vector<EventRecord> records;
+        };
+
+        bool _enabled;
+        std::ofstream _file;
+        std::mutex _file_mutex;
+        ThreadBuffer _buffers[MAX_THREADS];
+
+        void Write(std::vector<EventRecord>& records);
+};
+
+#if GCN_EVENT_LOG
+#define LOG_EVENT(log, event, depth, ...) \
+    do { if ( (log).Enabled() ) (log).Record(LogEvent::event, (depth), ##__VA_ARGS__); } while (0)
+#else
+#define LOG_EVENT(log, event, depth, ...) do { } while (0)
+#endif
+
+#endif // EVENT_LOG_HPP
@@ -0,0 +1,187 @@
+#include "nogood_index.hpp"
+
+#include <algorithm>
+
+NogoodIndex::NogoodIndex(const Graph& root, size_t capacity)
+: _capacity{capacity}
+{
+    _root_adj.resize(root.GetHighestVertex() + 1);
+    for ( int vertex : root.GetVertices() ) {
+        root.GetNeighbours(vertex, _root_adj[vertex]);
+        std::sort(_root_adj[vertex].begin(), _root_adj[vertex].end());
+    }
+}
+
+bool NogoodIndex::RootEdge(int a, int b) const
+{
+    return std::binary_search(_root_adj[a].begin(), _root_adj[a].end(), b);
+}
+
+std::vector<int> NogoodIndex::Endpoints(const std::vector<int>& vertices) const
+{
+    std::vector<int> endpoints;
+    for ( size_t i = 0; i < vertices.size(); i++ ) {
+        for ( size_t j = i + 1; j < vertices.size(); j++ ) {
+            if ( !RootEdge(vertices[i], vertices[j]) ) {
+                endpoints.push_back(vertices[i]);
+                endpoints.push_back(vertices[j]);
+            }
+        }
+    }
+    std::sort(endpoints.begin(), endpoints.end());
+    endpoints.erase(std::unique(endpoints.begin(), endpoints.end()), endpoints.end());
+    return endpoints;
+}
+
+void NogoodIndex::Link(int id)
+{
+    for ( int vertex : Endpoints(_nogoods[id].vertices) ) {
+        _by_vertex[vertex].push_back(id);
+    }
+}
+
+void NogoodIndex::Unlink(int id)
+{
+    for ( int vertex : Endpoints(_nogoods[id].vertices) ) {
+        std::vector<int>& ids = _by_vertex[vertex];
+        ids.erase(std::find(ids.begin(), ids.end(), id));
+    }
+}
+
+bool NogoodIndex::Record(std::vector<int> clique)
+{
+    if ( _capacity == 0 ) {
+        return false;
+    }
+    for ( int vertex : clique ) {
+        if ( vertex < 0 || vertex >= (int)_root_adj.size() ) {
+            return false;
+        }
+    }
+    std::sort(clique.begin(), clique.end());
+    std::vector<int> endpoints = Endpoints(clique);
+    if ( endpoints.empty() ) {
+        return false;   // already a clique of the root, every node has it
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto known = _by_vertex.find(endpoints[0]);
+    if ( known != _by_vertex.end() ) {
+        for ( int id : known->second ) {
+            if ( _nogoods[id].vertices == clique ) {
+                return false;
+            }
+        }
+    }
+
+    int id;
+    if ( _nogoods.size() < _capacity ) {
+        id = _nogoods.size();
+        _nogoods.emplace_back();
+    } else {
+        auto victim = std::min_element(_nogoods.begin(), _nogoods.end(), [](const Nogood& a, const Nogood& b) {
+            return a.hits < b.hits || ( a.hits == b.hits && a.stamp < b.stamp );
+        });
+        id = victim - _nogoods.begin();
+        Unlink(id);
+    }
+    _nogoods[id] = Nogood{std::move(clique), 0, _clock++};
+    Link(id);
+    return true;
+}
+
+bool NogoodIndex::Satisfied(const Graph& graph, const std::vector<int>& representative,
+                            const std::vector<int>& vertices)
+{
+    for ( size_t i = 0; i < vertices.size(); i++ ) {
+        int a = representative[vertices[i]];
+        if ( a == -1 ) {
+            return false;
+        }
+        for ( size_t j = i + 1; j < vertices.size(); j++ ) {
+            int b = representative[vertices[j]];
+            if ( b == -1 || a == b || !graph.HasEdge(a, b) ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool NogoodIndex::Prunes(const Graph& child, int u, int v, int min_size)
+{
+    std::vector<int> changed = child.GetMergedVertices(u);
+    std::vector<int> merged_v = child.GetMergedVertices(v);
+    changed.insert(changed.end(), merged_v.begin(), merged_v.end());
+    changed.push_back(u);
+    changed.push_back(v);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<int> candidates;
+    for ( int vertex : changed ) {
+        auto ids = _by_vertex.find(vertex);
+        if ( ids == _by_vertex.end() ) {
+            continue;
+        }
+        for ( int id : ids->second ) {
+            if ( (int)_nogoods[id].vertices.size() >= min_size ) {
+                candidates.push_back(id);
+            }
+        }
+    }
+    if ( candidates.empty() ) {
+        return false;
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<int> representative(_root_adj.size(), -1);
+    for ( int vertex : child.GetVertices() ) {
+        representative[vertex] = vertex;
+        for ( int merged : child.GetMergedVertices(vertex) ) {
+            representative[merged] = vertex;
+        }
+    }
+
+    for ( int id : candidates ) {
+        if ( Satisfied(child, representative, _nogoods[id].vertices) ) {
+            _nogoods[id].hits++;
+            _hits++;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::vector<int>> NogoodIndex::MostUsed(size_t count)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<int> ids;
+    for ( size_t id = 0; id < _nogoods.size(); id++ ) {
+        if ( _nogoods[id].hits > 0 ) {
+            ids.push_back(id);
+        }
+    }
+    count = std::min(count, ids.size());
+    std::partial_sort(ids.begin(), ids.begin() + count, ids.end(), [this](int a, int b) {
+        return _nogoods[a].hits > _nogoods[b].hits;
+    });
+
+    std::vector<std::vector<int>> result;
+    for ( size_t i = 0; i < count; i++ ) {
+        result.push_back(_nogoods[ids[i]].vertices);
+    }
+    return result;
+}
+
+size_t NogoodIndex::GetNumNogoods()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nogoods.size();
+}
+
+long NogoodIndex::GetNumHits()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hits;
+}
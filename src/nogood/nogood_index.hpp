@@ -0,0 +1,98 @@
+#ifndef NOGOOD_INDEX_HPP
+#define NOGOOD_INDEX_HPP
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.hpp"
+
+/**
+ * @brief bounded index of the nogoods learnt from the nodes pruned by their clique
+ *
+ * @details
+ * A node is pruned when it has a clique with at least best_ub vertices. The clique only
+ * depends on the few merges and added edges of the path that made its vertices pairwise
+ * adjacent, so it is recorded as a witness: the labels of its vertices, which are vertices
+ * of the original graph. Any node in which the classes of the witness vertices (the vertex
+ * and the ones merged into it) are pairwise adjacent has the same clique and is pruned as
+ * well. Merging and adding edges never separate two adjacent classes, so this also holds
+ * for the whole subtree of the node. <br>
+ * A nogood is indexed by the endpoints of its pairs which are not adjacent in the original
+ * graph, the pairs made adjacent by the path: a child satisfies a nogood its parent did not
+ * only through a pair it made adjacent, which has an endpoint in the classes it changed. <br>
+ * When the index is full, the nogood used least (the oldest among them) is replaced.
+ * All the methods are thread safe.
+ */
+class NogoodIndex {
+    public:
+        /**
+         * @param root graph given to the solver, before any branching
+         * @param capacity maximum number of nogoods stored
+         */
+        NogoodIndex(const Graph& root, size_t capacity);
+
+        /**
+         * @brief records the clique of a pruned node as a nogood
+         *
+         * @param clique labels of the vertices of a clique of the node
+         * @return false if it was not recorded: already known, or a clique of the root
+         */
+        bool Record(std::vector<int> clique);
+
+        /**
+         * @brief checks whether a child satisfies a nogood with at least min_size vertices
+         *
+         * @param child node just created by merging v into u or by adding edges at u and v
+         * @param u first branching vertex
+         * @param v second branching vertex (missing from a merge child)
+         * @param min_size size of the cliques which prune the child, best_ub
+         */
+        bool Prunes(const Graph& child, int u, int v, int min_size);
+
+        /**
+         * @brief the nogoods that pruned most nodes
+         *
+         * @param count maximum number of nogoods returned
+         */
+        std::vector<std::vector<int>> MostUsed(size_t count);
+
+        size_t GetNumNogoods();
+        long GetNumHits();
+
+    private:
+        struct Nogood {
+            std::vector<int> vertices;  // sorted labels of the witness
+            long hits = 0;
+            long stamp = 0;             // time of recording
+        };
+
+        std::vector<std::vector<int>> _root_adj;       // sorted adjacency of the root
+        size_t _capacity;
+        std::vector<Nogood> _nogoods;
+        // vertex -> nogoods with a non-root pair at that vertex
+        std::unordered_map<int, std::vector<int>> _by_vertex;
+        long _clock = 0;
+        long _hits = 0;
+        std::mutex _mutex;
+
+        bool RootEdge(int a, int b) const;
+
+        /**
+         * @brief whether the witness vertices lie in pairwise adjacent classes of graph
+         *
+         * @param representative class of each original vertex in graph, -1 if none
+         */
+        static bool Satisfied(const Graph& graph, const std::vector<int>& representative,
+                              const std::vector<int>& vertices);
+
+        /**
+         * @brief endpoints of the pairs of vertices which are not adjacent in the root
+         */
+        std::vector<int> Endpoints(const std::vector<int>& vertices) const;
+
+        void Link(int id);
+        void Unlink(int id);
+};
+
+#endif // NOGOOD_INDEX_HPP
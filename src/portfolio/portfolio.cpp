@@ -0,0 +1,100 @@
+#include "portfolio.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+/**
+ * @brief parses a non-negative integer filling the whole of text
+ * @return false if text is not such a number
+ */
+bool ParseUnsigned(const std::string& text, unsigned long& value) {
+    if ( text.empty() || text.find_first_not_of("0123456789") != std::string::npos || text.size() > 9 ) {
+        return false;
+    }
+    value = std::stoul(text);
+    return true;
+}
+
+/**
+ * @brief sets the field key of config
+ * @return false if the key is unknown or the value is not valid for it
+ */
+bool SetField(PortfolioConfig& config, const std::string& key, const std::string& value) {
+    unsigned long number;
+    if ( key == "ranks" ) {
+        if ( !ParseUnsigned(value, number) || number == 0 ) return false;
+        config.ranks = number;
+    } else if ( key == "branching" ) {
+        if ( value != "neighbours" && value != "random" ) return false;
+        config.branching = value;
+    } else if ( key == "color" ) {
+        if ( !ParseUnsigned(value, number) || number > 3 ) return false;
+        config.color = number;
+    } else if ( key == "selection" ) {
+        if ( value == "depth" )     config.selection = NodeSelection::DEPTH;
+        else if ( value == "lb" )   config.selection = NodeSelection::LB;
+        else if ( value == "gap" )  config.selection = NodeSelection::GAP;
+        else return false;
+    } else if ( key == "seed" ) {
+        if ( !ParseUnsigned(value, number) ) return false;
+        config.seed = number;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}
+
+bool ReadPortfolio(const std::string& file_name, std::vector<PortfolioConfig>& configs,
+                   std::string& error)
+{
+    std::ifstream in(file_name);
+    if ( !in.is_open() ) {
+        error = "Could not open portfolio file " + file_name;
+        return false;
+    }
+
+    configs.clear();
+    std::string line;
+    while ( std::getline(in, line) ) {
+        std::istringstream fields(line);
+        std::string field;
+        if ( !(fields >> field) || field[0] == '#' ) {
+            continue;
+        }
+
+        PortfolioConfig config;
+        do {
+            size_t equal = field.find('=');
+            if ( equal == std::string::npos ||
+                 !SetField(config, field.substr(0, equal), field.substr(equal + 1)) ) {
+                error = "Invalid field `" + field + "` in portfolio file: " + line;
+                return false;
+            }
+            config.description += ( config.description.empty() ? "" : " " ) + field;
+        } while ( fields >> field );
+
+        configs.push_back(config);
+    }
+
+    if ( configs.empty() ) {
+        error = "No group found in portfolio file " + file_name;
+        return false;
+    }
+    return true;
+}
+
+std::vector<int> AssignGroups(const std::vector<PortfolioConfig>& configs, int num_ranks)
+{
+    std::vector<int> group_of_rank;
+    for ( size_t group = 0; group < configs.size(); group++ ) {
+        group_of_rank.insert(group_of_rank.end(), configs[group].ranks, group);
+    }
+    if ( (int)group_of_rank.size() != num_ranks ) {
+        return {};
+    }
+    return group_of_rank;
+}
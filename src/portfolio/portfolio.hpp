@@ -0,0 +1,46 @@
+#ifndef PORTFOLIO_HPP
+#define PORTFOLIO_HPP
+
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+
+/**
+ * @brief configuration of a group of ranks in a portfolio run. All the groups search the
+ *        whole tree and share the incumbent, each with its own strategies
+ */
+struct PortfolioConfig {
+    int ranks = 1;
+    std::string branching = "neighbours";   // neighbours or random
+    int color = 0;                          // as --color_strategy
+    NodeSelection selection = NodeSelection::DEPTH;
+    unsigned int seed = 0;                  // 0: not seeded
+    std::string description;                // fields as written in the file, for the reports
+};
+
+/**
+ * @brief reads a portfolio file: one group per line, made of `key=value` fields among
+ *        ranks, branching (neighbours, random), color (0-3, as --color_strategy),
+ *        selection (depth, lb, gap) and seed. Missing fields get the defaults of
+ *        PortfolioConfig, blank lines and lines starting with '#' are skipped. E.g.
+ *
+ *        ranks=2 branching=neighbours color=0 selection=depth
+ *        ranks=2 branching=random color=2 selection=gap seed=7
+ *
+ * @param configs filled with a configuration per group, in file order
+ * @param error set to a description of the problem when false is returned
+ * @return false if the file could not be opened, is malformed or has no group
+ */
+bool ReadPortfolio(const std::string& file_name, std::vector<PortfolioConfig>& configs,
+                   std::string& error);
+
+/**
+ * @brief assigns the ranks to the groups in order: the first configs[0].ranks ranks form
+ *        group 0, the next configs[1].ranks group 1, and so on
+ *
+ * @return group of each rank, empty if the groups do not add up to num_ranks
+ */
+std::vector<int> AssignGroups(const std::vector<PortfolioConfig>& configs, int num_ranks);
+
+#endif // PORTFOLIO_HPP
@@ -0,0 +1,53 @@
+#include "fast_random.hpp"
+
+#include <omp.h>
+
+#include <atomic>
+#include <random>
+
+static uint64_t SplitMix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t DeviceSeed() {
+    std::random_device device;
+    uint64_t seed = ((uint64_t) device() << 32) | device();
+    return seed != 0 ? seed : 1;
+}
+
+static std::atomic<uint64_t> run_seed{DeviceSeed()};
+static std::atomic<int> run_rank{0};
+// incremented by every Seed(), a thread whose generator is older derives it again
+static std::atomic<uint64_t> generation{1};
+
+struct ThreadGenerator {
+    Xoshiro256 generator;
+    uint64_t generation = 0;
+};
+static thread_local ThreadGenerator thread_generator;
+
+void ThreadRandom::Seed(uint64_t seed, int rank)
+{
+    run_seed.store(seed != 0 ? seed : DeviceSeed());
+    run_rank.store(rank);
+    generation.fetch_add(1);
+}
+
+uint64_t ThreadRandom::GetSeed()
+{
+    return run_seed.load();
+}
+
+Xoshiro256& ThreadRandom::Get()
+{
+    uint64_t current = generation.load(std::memory_order_relaxed);
+    if ( thread_generator.generation != current ) {
+        uint64_t stream = ((uint64_t) run_rank.load() << 16) | (uint64_t) omp_get_thread_num();
+        thread_generator.generator.Seed(SplitMix(run_seed.load()) ^ SplitMix(~stream));
+        thread_generator.generation = current;
+    }
+    return thread_generator.generator;
+}
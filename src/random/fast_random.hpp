@@ -0,0 +1,96 @@
+#ifndef FAST_RANDOM_HPP
+#define FAST_RANDOM_HPP
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief xoshiro256** generator (Blackman and Vigna): 32 bytes of state and a few shifts per
+ *        number, against the 5 KB of std::mt19937. It is a UniformRandomBitGenerator, so it
+ *        drives the <random> distributions, std::sample and std::shuffle
+ */
+class Xoshiro256 {
+    public:
+        using result_type = uint64_t;
+
+        /**
+         * @brief state expanded from seed with splitmix64, so that close seeds give unrelated streams
+         */
+        explicit Xoshiro256(uint64_t seed = 0) { Seed(seed); }
+
+        void Seed(uint64_t seed) {
+            for ( uint64_t& word : _state ) {
+                seed += 0x9e3779b97f4a7c15ULL;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            uint64_t result = Rotate(_state[1] * 5, 7) * 9;
+            uint64_t t = _state[1] << 17;
+            _state[2] ^= _state[0];
+            _state[3] ^= _state[1];
+            _state[1] ^= _state[2];
+            _state[0] ^= _state[3];
+            _state[2] ^= t;
+            _state[3] = Rotate(_state[3], 45);
+            return result;
+        }
+
+        /**
+         * @brief uniform integer in [0, bound), bound > 0, by multiplication (Lemire) instead of a modulo
+         */
+        uint64_t Below(uint64_t bound) {
+            return (uint64_t) (((unsigned __int128) (*this)() * bound) >> 64);
+        }
+
+        /**
+         * @brief uniform double in [0, 1)
+         */
+        double Uniform() {
+            return ((*this)() >> 11) * 0x1.0p-53;
+        }
+
+    private:
+        uint64_t _state[4];
+
+        static uint64_t Rotate(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/**
+ * @brief random streams of the process, one generator per thread, all derived from one seed:
+ *        the stream of a thread only depends on the seed, the MPI rank and the OpenMP thread
+ *        number (the role of the thread in the solvers), so that the random choices of a run
+ *        are reproduced by giving its seed again
+ *
+ * @details a thread gets its generator at its first Get() after a Seed(), which restarts every
+ *          stream, as between the runs of run_all_instances. Threads outside OpenMP count as
+ *          thread 0 and share its stream (not its generator). <br>
+ *          Without a Seed() the seed is drawn once from std::random_device.
+ */
+class ThreadRandom {
+    public:
+        /**
+         * @param seed seed of the run, 0 to draw one from std::random_device
+         * @param rank MPI rank of the process, which selects its streams
+         */
+        static void Seed(uint64_t seed, int rank);
+
+        /**
+         * @brief seed of the run, to be reported so that the run can be repeated
+         */
+        static uint64_t GetSeed();
+
+        /**
+         * @brief generator of the calling thread
+         */
+        static Xoshiro256& Get();
+};
+
+#endif // FAST_RANDOM_HPP
@@ -0,0 +1,52 @@
+#include "connected_components.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+std::vector<std::vector<int>> ConnectedComponents(const CSRGraph& graph)
+{
+    std::vector<std::vector<int>> components;
+    std::vector<size_t> num_edges;
+    std::vector<char> visited(graph.GetHighestVertex() + 1, 0);
+
+    // iterative BFS, the component itself is used as the queue
+    for ( int root : graph.GetVertices() ) {
+        if ( visited[root] ) {
+            continue;
+        }
+
+        std::vector<int> component{root};
+        visited[root] = 1;
+        size_t degree_sum = 0;
+        for ( size_t head = 0; head < component.size(); head++ ) {
+            const std::vector<int>& neighbours = graph.GetAdjacency(component[head]);
+            degree_sum += neighbours.size();
+            for ( int neighbour : neighbours ) {
+                if ( !visited[neighbour] ) {
+                    visited[neighbour] = 1;
+                    component.push_back(neighbour);
+                }
+            }
+        }
+
+        std::sort(component.begin(), component.end());
+        components.push_back(std::move(component));
+        num_edges.push_back(degree_sum / 2);
+    }
+
+    std::vector<size_t> order(components.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if ( num_edges[a] != num_edges[b] ) {
+            return num_edges[a] > num_edges[b];
+        }
+        return components[a].size() > components[b].size();
+    });
+
+    std::vector<std::vector<int>> sorted;
+    sorted.reserve(components.size());
+    for ( size_t i : order ) {
+        sorted.push_back(std::move(components[i]));
+    }
+    return sorted;
+}
@@ -0,0 +1,17 @@
+#ifndef CONNECTED_COMPONENTS_HPP
+#define CONNECTED_COMPONENTS_HPP
+
+#include <vector>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief finds the connected components of the graph
+ * 
+ * @param graph graph to split
+ * @return the vertices of each component, components are sorted by decreasing number
+ *         of edges (hardest first), ties broken by decreasing number of vertices
+ */
+std::vector<std::vector<int>> ConnectedComponents(const CSRGraph& graph);
+
+#endif // CONNECTED_COMPONENTS_HPP
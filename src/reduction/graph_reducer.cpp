@@ -0,0 +1,128 @@
+#include "graph_reducer.hpp"
+
+#include <algorithm>
+
+GraphReducer::GraphReducer(CSRGraph& graph)
+: _graph{graph}
+{
+}
+
+void GraphReducer::Remove(int vertex, int dominator)
+{
+    Removal removal;
+    removal.vertex = vertex;
+    removal.dominator = dominator;
+    removal.neighbours = _graph.GetAdjacency(vertex);
+    _removals.push_back(std::move(removal));
+
+    _graph.RemoveVertex(vertex);
+}
+
+int GraphReducer::PeelLowDegree(int lb)
+{
+    std::vector<int> to_remove;
+    std::vector<char> queued(_graph.GetHighestVertex() + 1, 0);
+    for ( int vertex : _graph.GetVertices() ) {
+        if ( (int) _graph.GetDegree(vertex) < lb ) {
+            to_remove.push_back(vertex);
+            queued[vertex] = 1;
+        }
+    }
+
+    int num_removed = 0;
+    while ( !to_remove.empty() ) {
+        int vertex = to_remove.back();
+        to_remove.pop_back();
+
+        Remove(vertex);
+        num_removed++;
+
+        // removing `vertex` lowers the degree of its neighbours
+        for ( int neighbour : _removals.back().neighbours ) {
+            if ( !queued[neighbour] && (int) _graph.GetDegree(neighbour) < lb ) {
+                to_remove.push_back(neighbour);
+                queued[neighbour] = 1;
+            }
+        }
+    }
+
+    return num_removed;
+}
+
+int GraphReducer::RemoveDominated()
+{
+    // sorted rows allow linear subset tests
+    _graph.SortAdjacency();
+
+    int num_removed = 0;
+    std::vector<int> vertices = _graph.GetVertices();
+    for ( int u : vertices ) {
+        const std::vector<int>& u_neighbours = _graph.GetAdjacency(u);
+        if ( u_neighbours.empty() ) {
+            continue;
+        }
+
+        // a dominator is adjacent to all of N(u), so it is looked for among the
+        // neighbours of the neighbour of u with the lowest degree
+        int pivot = *std::min_element(u_neighbours.begin(), u_neighbours.end(), 
+            [this](int w, int z) { return _graph.GetDegree(w) < _graph.GetDegree(z); });
+
+        int dominator = -1;
+        for ( int v : _graph.GetAdjacency(pivot) ) {
+            if ( v == u || _graph.GetDegree(v) < u_neighbours.size() ||
+                 std::binary_search(u_neighbours.begin(), u_neighbours.end(), v) ) {
+                continue;
+            }
+            const std::vector<int>& v_neighbours = _graph.GetAdjacency(v);
+            if ( std::includes(v_neighbours.begin(), v_neighbours.end(), 
+                               u_neighbours.begin(), u_neighbours.end()) ) {
+                dominator = v;
+                break;
+            }
+        }
+
+        if ( dominator != -1 ) {
+            Remove(u, dominator);
+            num_removed++;
+        }
+    }
+
+    return num_removed;
+}
+
+int GraphReducer::Reduce(int lb)
+{
+    int num_removed = 0;
+    int removed;
+    do {
+        removed = PeelLowDegree(lb);
+        removed += RemoveDominated();
+        num_removed += removed;
+    } while ( removed > 0 );
+
+    return num_removed;
+}
+
+void GraphReducer::RestoreColoring(std::vector<unsigned short>& full_coloring) const
+{
+    std::vector<char> used;
+    for ( auto it = _removals.rbegin(); it != _removals.rend(); it++ ) {
+        if ( it->dominator != -1 ) {
+            full_coloring[it->vertex] = full_coloring[it->dominator];
+            continue;
+        }
+
+        // among deg+1 colors at least one is free
+        used.assign(it->neighbours.size() + 2, 0);
+        for ( int neighbour : it->neighbours ) {
+            unsigned short color = full_coloring[neighbour];
+            if ( color < used.size() ) {
+                used[color] = 1;
+            }
+        }
+
+        unsigned short color = 1;
+        while ( used[color] ) color++;
+        full_coloring[it->vertex] = color;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef GRAPH_REDUCER_HPP
+#define GRAPH_REDUCER_HPP
+
+#include <vector>
+
+#include "csr_graph.hpp"
+
+/**
+ * @brief shrinks a graph before the search, removing vertices that can be colored
+ *        at the end without new colors, and completes the coloring of the reduced
+ *        graph afterwards
+ * 
+ * @details every removal is recorded with the neighbours the vertex had at that time;
+ *          these are either still in the reduced graph or removed later, so undoing the
+ *          removals in reverse order always finds the neighbours already colored
+ */
+class GraphReducer {
+    public:
+        /**
+         * @param graph graph to reduce, modified in place
+         */
+        GraphReducer(CSRGraph& graph);
+
+        /**
+         * @brief removes, until none is left, the vertices with degree lower than `lb`.
+         *        Such a vertex can always be colored with one of the first `lb` colors
+         * 
+         * @param lb lower bound on the chromatic number of the graph (e.g. a clique size)
+         * @return number of vertices removed
+         */
+        int PeelLowDegree(int lb);
+
+        /**
+         * @brief removes the vertices u for which there is a non-adjacent vertex v with
+         *        N(u) ⊆ N(v) (twins included): u can take the color of v
+         * 
+         * @return number of vertices removed
+         */
+        int RemoveDominated();
+
+        /**
+         * @brief alternates PeelLowDegree and RemoveDominated until neither removes 
+         *        a vertex, since each removal can enable the other
+         * 
+         * @param lb lower bound on the chromatic number of the graph
+         * @return number of vertices removed
+         */
+        int Reduce(int lb);
+
+        /**
+         * @brief colors the removed vertices, in reverse order of removal: a dominated
+         *        vertex takes the color of its dominator, the others the smallest color
+         *        not used by their neighbours
+         * 
+         * @param full_coloring coloring of the reduced graph such that full_coloring[vertex]
+         *                      is the color of vertex. It must be sized for every vertex
+         *                      of the original graph
+         */
+        void RestoreColoring(std::vector<unsigned short>& full_coloring) const;
+
+        size_t GetNumRemoved() const { return _removals.size(); }
+
+    private:
+        struct Removal {
+            int vertex;
+            // vertex whose color is taken, -1 if the vertex was peeled
+            int dominator;
+            std::vector<int> neighbours;
+        };
+
+        CSRGraph& _graph;
+        std::vector<Removal> _removals;
+
+        void Remove(int vertex, int dominator = -1);
+};
+
+#endif // GRAPH_REDUCER_HPP
@@ -0,0 +1,70 @@
+#include "k_core.hpp"
+
+#include <algorithm>
+
+std::vector<int> PeelKCore(Graph& graph, int k)
+{
+    std::vector<int> degrees(graph.GetHighestVertex() + 1, 0);
+    std::vector<char> peeled(degrees.size(), 0);
+    std::vector<int> to_remove;
+    for ( int vertex : graph.GetVertices() ) {
+        degrees[vertex] = graph.GetDegree(vertex);
+        if ( degrees[vertex] < k ) {
+            peeled[vertex] = 1;
+            to_remove.push_back(vertex);
+        }
+    }
+
+    // a vertex is marked when its degree drops below k: its neighbours removed after that
+    // moment are fewer than k, and they are the ones colored before it when extending
+    std::vector<int> order;
+    std::vector<int> neighbours;
+    while ( !to_remove.empty() ) {
+        int vertex = to_remove.back();
+        to_remove.pop_back();
+        order.push_back(vertex);
+
+        neighbours.clear();
+        graph.GetNeighbours(vertex, neighbours);
+        for ( int neighbour : neighbours ) {
+            if ( !peeled[neighbour] && --degrees[neighbour] < k ) {
+                peeled[neighbour] = 1;
+                to_remove.push_back(neighbour);
+            }
+        }
+    }
+
+    for ( int vertex : order ) {
+        graph.RemoveVertex(vertex);
+    }
+    return order;
+}
+
+unsigned short ExtendCoreColoring(const Graph& graph, const std::vector<int>& peeled,
+                                  std::vector<unsigned short>& full_coloring)
+{
+    std::vector<int> neighbours;
+    std::vector<char> used;
+    for ( auto it = peeled.rbegin(); it != peeled.rend(); it++ ) {
+        neighbours.clear();
+        graph.GetNeighbours(*it, neighbours);
+
+        used.assign(neighbours.size() + 2, 0);
+        for ( int neighbour : neighbours ) {
+            if ( full_coloring[neighbour] < used.size() ) {
+                used[full_coloring[neighbour]] = 1;
+            }
+        }
+        unsigned short color = 1;
+        while ( used[color] ) {
+            color++;
+        }
+        full_coloring[*it] = color;
+    }
+
+    unsigned short num_colors = 0;
+    for ( int vertex : graph.GetVertices() ) {
+        num_colors = std::max(num_colors, full_coloring[vertex]);
+    }
+    return num_colors;
+}
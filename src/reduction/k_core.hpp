@@ -0,0 +1,36 @@
+#ifndef K_CORE_HPP
+#define K_CORE_HPP
+
+#include <vector>
+
+#include "graph.hpp"
+
+/**
+ * @brief removes from the graph, until none is left, the vertices with fewer than k 
+ *        neighbours: what is left is the k-core. The graph is k-colorable if and only 
+ *        if its k-core is
+ * 
+ * @details degrees are kept in an array and decremented as the 
+ *          neighbours are removed, so the cost is linear in the size of the graph
+ * 
+ * @param graph graph to peel, modified in place
+ * @param k number of colors available
+ * @return removed vertices, in removal order
+ */
+std::vector<int> PeelKCore(Graph& graph, int k);
+
+/**
+ * @brief colors the vertices peeled from graph (in reverse removal order) with the 
+ *        smallest color not used by their neighbours. If they were peeled with PeelKCore 
+ *        for some k, no color above max(k, colors of the core) is used
+ * 
+ * @param graph graph before peeling
+ * @param peeled vertices returned by PeelKCore
+ * @param full_coloring coloring of the core (label indexed, 0 for the peeled vertices),
+ *                      completed in place
+ * @return number of colors of the completed coloring
+ */
+unsigned short ExtendCoreColoring(const Graph& graph, const std::vector<int>& peeled,
+                                  std::vector<unsigned short>& full_coloring);
+
+#endif // K_CORE_HPP
@@ -0,0 +1,366 @@
+#include "cdcl_solver.hpp"
+
+#include <algorithm>
+
+#define VAR_DECAY 0.95          // activities decay by this factor at each conflict
+#define RESTART_BASE 100        // conflicts in the first (Luby) restart
+
+int CDCLSolver::NewVar()
+{
+    int var = _assigns.size();
+    _assigns.push_back(UNDEF);
+    _levels.push_back(0);
+    _reasons.push_back(-1);
+    _activities.push_back(0.0);
+    _heap_positions.push_back(-1);
+    _phases.push_back(false);
+    _seen.push_back(0);
+    _watches.emplace_back();
+    _watches.emplace_back();
+    HeapInsert(var);
+    return var;
+}
+
+int CDCLSolver::Value(int literal) const
+{
+    signed char assign = _assigns[literal >> 1];
+    if ( assign == UNDEF ) {
+        return UNDEF;
+    }
+    return assign ^ (literal & 1);
+}
+
+void CDCLSolver::Enqueue(int literal, int reason)
+{
+    int var = literal >> 1;
+    _assigns[var] = (literal & 1) ? 0 : 1;
+    _levels[var]  = DecisionLevel();
+    _reasons[var] = reason;
+    _trail.push_back(literal);
+}
+
+bool CDCLSolver::AddClause(std::vector<int> literals)
+{
+    if ( _unsatisfiable ) {
+        return false;
+    }
+
+    std::sort(literals.begin(), literals.end());
+    literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+
+    // dropping false literals, skipping satisfied clauses and tautologies (x and not x are adjacent)
+    size_t kept = 0;
+    for ( size_t i = 0; i < literals.size(); i++ ) {
+        int value = Value(literals[i]);
+        if ( value == 1 || ( i > 0 && literals[i] == (literals[i-1] ^ 1) ) ) {
+            return true;
+        }
+        if ( value == UNDEF ) {
+            literals[kept++] = literals[i];
+        }
+    }
+    literals.resize(kept);
+
+    if ( literals.empty() ) {
+        _unsatisfiable = true;
+        return false;
+    }
+    if ( literals.size() == 1 ) {
+        Enqueue(literals[0], -1);
+        if ( Propagate() != -1 ) {
+            _unsatisfiable = true;
+            return false;
+        }
+        return true;
+    }
+
+    int index = _clauses.size();
+    _watches[literals[0]].push_back(index);
+    _watches[literals[1]].push_back(index);
+    _clauses.push_back(Clause{std::move(literals)});
+    return true;
+}
+
+int CDCLSolver::Propagate()
+{
+    while ( _propagation_head < _trail.size() ) {
+        int false_literal = _trail[_propagation_head++] ^ 1;
+        std::vector<int>& watchers = _watches[false_literal];
+
+        size_t i = 0, j = 0;
+        while ( i < watchers.size() ) {
+            int index = watchers[i++];
+            std::vector<int>& literals = _clauses[index].literals;
+
+            // the false literal goes in position 1
+            if ( literals[0] == false_literal ) {
+                std::swap(literals[0], literals[1]);
+            }
+            if ( Value(literals[0]) == 1 ) {
+                watchers[j++] = index;
+                continue;
+            }
+
+            // looking for a new literal to watch
+            bool moved = false;
+            for ( size_t k = 2; k < literals.size(); k++ ) {
+                if ( Value(literals[k]) != 0 ) {
+                    std::swap(literals[1], literals[k]);
+                    _watches[literals[1]].push_back(index);
+                    moved = true;
+                    break;
+                }
+            }
+            if ( moved ) {
+                continue;
+            }
+
+            // unit or conflicting
+            watchers[j++] = index;
+            if ( Value(literals[0]) == 0 ) {
+                while ( i < watchers.size() ) {
+                    watchers[j++] = watchers[i++];
+                }
+                watchers.resize(j);
+                return index;
+            }
+            Enqueue(literals[0], index);
+        }
+        watchers.resize(j);
+    }
+    return -1;
+}
+
+int CDCLSolver::Analyze(int conflict, std::vector<int>& learnt)
+{
+    learnt.assign(1, -1);   // room for the asserting literal
+    int path_count = 0;
+    int literal = -1;
+    int trail_index = _trail.size() - 1;
+    int index = conflict;
+
+    do {
+        const std::vector<int>& literals = _clauses[index].literals;
+        // literals[0] of a reason is the literal it implied, already counted
+        for ( size_t j = (literal == -1 ? 0 : 1); j < literals.size(); j++ ) {
+            int var = literals[j] >> 1;
+            if ( !_seen[var] && _levels[var] > 0 ) {
+                _seen[var] = 1;
+                BumpActivity(var);
+                if ( _levels[var] >= DecisionLevel() ) {
+                    path_count++;
+                } else {
+                    learnt.push_back(literals[j]);
+                }
+            }
+        }
+
+        // next literal of the current level to expand
+        while ( !_seen[_trail[trail_index] >> 1] ) {
+            trail_index--;
+        }
+        literal = _trail[trail_index--];
+        index   = _reasons[literal >> 1];
+        _seen[literal >> 1] = 0;
+        path_count--;
+    } while ( path_count > 0 );
+    learnt[0] = literal ^ 1;
+
+    // the literal of the highest level goes in position 1, to be watched
+    int backtrack_level = 0;
+    for ( size_t j = 1; j < learnt.size(); j++ ) {
+        int var = learnt[j] >> 1;
+        _seen[var] = 0;
+        if ( _levels[var] > backtrack_level ) {
+            backtrack_level = _levels[var];
+            std::swap(learnt[1], learnt[j]);
+        }
+    }
+    return backtrack_level;
+}
+
+void CDCLSolver::Backtrack(int level)
+{
+    if ( DecisionLevel() <= level ) {
+        return;
+    }
+    for ( int i = _trail.size() - 1; i >= _trail_limits[level]; i-- ) {
+        int var = _trail[i] >> 1;
+        _phases[var]  = _assigns[var] == 1;
+        _assigns[var] = UNDEF;
+        _reasons[var] = -1;
+        if ( _heap_positions[var] == -1 ) {
+            HeapInsert(var);
+        }
+    }
+    _trail.resize(_trail_limits[level]);
+    _trail_limits.resize(level);
+    _propagation_head = _trail.size();
+}
+
+void CDCLSolver::BumpActivity(int var)
+{
+    _activities[var] += _activity_increment;
+    if ( _activities[var] > 1e100 ) {
+        for ( double& activity : _activities ) {
+            activity *= 1e-100;
+        }
+        _activity_increment *= 1e-100;
+    }
+    if ( _heap_positions[var] != -1 ) {
+        HeapUp(_heap_positions[var]);
+    }
+}
+
+int CDCLSolver::PickBranchLiteral()
+{
+    while ( !_heap.empty() ) {
+        int var = HeapPop();
+        if ( _assigns[var] == UNDEF ) {
+            return Lit(var, !_phases[var]);
+        }
+    }
+    return -1;
+}
+
+CDCLSolver::Result CDCLSolver::Search(long nof_conflicts, long conflict_budget)
+{
+    long conflicts = 0;
+    std::vector<int> learnt;
+    while ( true ) {
+        int conflict = Propagate();
+        if ( conflict != -1 ) {
+            _num_conflicts++;
+            conflicts++;
+            if ( DecisionLevel() == 0 ) {
+                return Result::UNSAT;
+            }
+
+            int backtrack_level = Analyze(conflict, learnt);
+            Backtrack(backtrack_level);
+            if ( learnt.size() == 1 ) {
+                Enqueue(learnt[0], -1);
+            } else {
+                int index = _clauses.size();
+                _watches[learnt[0]].push_back(index);
+                _watches[learnt[1]].push_back(index);
+                _clauses.push_back(Clause{learnt});
+                Enqueue(learnt[0], index);
+            }
+            _activity_increment /= VAR_DECAY;
+            continue;
+        }
+
+        if ( conflicts >= nof_conflicts || _num_conflicts >= conflict_budget ) {
+            Backtrack(0);
+            return Result::UNKNOWN;
+        }
+
+        int literal = PickBranchLiteral();
+        if ( literal == -1 ) {
+            return Result::SAT;
+        }
+        _trail_limits.push_back(_trail.size());
+        Enqueue(literal, -1);
+    }
+}
+
+CDCLSolver::Result CDCLSolver::Solve(long conflict_budget)
+{
+    if ( _unsatisfiable || Propagate() != -1 ) {
+        _unsatisfiable = true;
+        return Result::UNSAT;
+    }
+
+    _num_conflicts = 0;
+    for ( int restart = 0; _num_conflicts < conflict_budget; restart++ ) {
+        Result result = Search(Luby(restart) * RESTART_BASE, conflict_budget);
+        if ( result == Result::SAT ) {
+            _model.resize(_assigns.size());
+            for ( size_t var = 0; var < _assigns.size(); var++ ) {
+                _model[var] = _assigns[var] == 1;
+            }
+            Backtrack(0);
+            return result;
+        }
+        if ( result == Result::UNSAT ) {
+            _unsatisfiable = true;
+            return result;
+        }
+    }
+    return Result::UNKNOWN;
+}
+
+double CDCLSolver::Luby(int index)
+{
+    // finding the subsequence containing index and its size
+    int size = 1, sequence = 0;
+    while ( size < index + 1 ) {
+        sequence++;
+        size = 2 * size + 1;
+    }
+    while ( size - 1 != index ) {
+        size = (size - 1) >> 1;
+        sequence--;
+        index = index % size;
+    }
+    return 1 << sequence;
+}
+
+// ----------------------------------- ACTIVITY HEAP -----------------------------------
+
+void CDCLSolver::HeapInsert(int var)
+{
+    _heap_positions[var] = _heap.size();
+    _heap.push_back(var);
+    HeapUp(_heap.size() - 1);
+}
+
+int CDCLSolver::HeapPop()
+{
+    int top = _heap[0];
+    _heap[0] = _heap.back();
+    _heap_positions[_heap[0]] = 0;
+    _heap.pop_back();
+    _heap_positions[top] = -1;
+    if ( !_heap.empty() ) {
+        HeapDown(0);
+    }
+    return top;
+}
+
+void CDCLSolver::HeapUp(int position)
+{
+    int var = _heap[position];
+    while ( position > 0 ) {
+        int parent = (position - 1) >> 1;
+        if ( _activities[_heap[parent]] >= _activities[var] ) {
+            break;
+        }
+        _heap[position] = _heap[parent];
+        _heap_positions[_heap[position]] = position;
+        position = parent;
+    }
+    _heap[position] = var;
+    _heap_positions[var] = position;
+}
+
+void CDCLSolver::HeapDown(int position)
+{
+    int var = _heap[position];
+    int size = _heap.size();
+    while ( 2 * position + 1 < size ) {
+        int child = 2 * position + 1;
+        if ( child + 1 < size && _activities[_heap[child + 1]] > _activities[_heap[child]] ) {
+            child++;
+        }
+        if ( _activities[_heap[child]] <= _activities[var] ) {
+            break;
+        }
+        _heap[position] = _heap[child];
+        _heap_positions[_heap[position]] = position;
+        position = child;
+    }
+    _heap[position] = var;
+    _heap_positions[var] = position;
+}
@@ -0,0 +1,115 @@
+#ifndef CDCL_SOLVER_HPP
+#define CDCL_SOLVER_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief small conflict driven clause learning SAT solver
+ *
+ * @details
+ * Two watched literals per clause, VSIDS variable activities kept in a binary heap,
+ * phase saving, first-UIP learning and Luby restarts. Learnt clauses are never deleted:
+ * the solver is meant to be run with a conflict budget. <br>
+ * A literal is 2 * var for the variable and 2 * var + 1 for its negation (see Lit).
+ */
+class CDCLSolver {
+    public:
+        enum class Result { SAT, UNSAT, UNKNOWN };
+
+        static int Lit(int var, bool negated = false) { return 2 * var + (negated ? 1 : 0); }
+
+        /**
+         * @brief adds a new variable
+         * @return the index of the variable
+         */
+        int NewVar();
+
+        int GetNumVars() const { return _assigns.size(); }
+
+        /**
+         * @brief adds a clause, only allowed before Solve
+         *
+         * @param literals literals of the clause (duplicates and tautologies are fine)
+         * @return false if the formula became unsatisfiable (empty clause or conflicting units)
+         */
+        bool AddClause(std::vector<int> literals);
+
+        /**
+         * @brief searches an assignment satisfying all the clauses
+         *
+         * @param conflict_budget maximum number of conflicts, then UNKNOWN is returned
+         */
+        Result Solve(long conflict_budget);
+
+        /**
+         * @brief value of var in the assignment found by the last Solve returning SAT
+         */
+        bool GetValue(int var) const { return _model[var]; }
+
+        long GetNumConflicts() const { return _num_conflicts; }
+
+    private:
+        struct Clause {
+            std::vector<int> literals;  // literals[0] and literals[1] are the watched ones
+        };
+
+        static constexpr signed char UNDEF = -1;
+
+        std::vector<Clause> _clauses;
+        std::vector<std::vector<int>> _watches;    // clauses watching each literal
+        std::vector<signed char> _assigns;         // per variable: -1, 0 (false) or 1 (true)
+        std::vector<int> _levels;
+        std::vector<int> _reasons;                 // clause that implied the variable, -1 if none
+        std::vector<int> _trail;
+        std::vector<int> _trail_limits;            // trail size at each decision
+        size_t _propagation_head = 0;
+        bool _unsatisfiable = false;
+
+        // VSIDS
+        std::vector<double> _activities;
+        double _activity_increment = 1.0;
+        std::vector<int> _heap;                    // variables, max-heap on activity
+        std::vector<int> _heap_positions;          // position of each variable in _heap, -1 if absent
+        std::vector<bool> _phases;                 // last value of each variable
+
+        std::vector<char> _seen;
+        std::vector<bool> _model;
+        long _num_conflicts = 0;
+
+        int Value(int literal) const;
+        int DecisionLevel() const { return _trail_limits.size(); }
+        void Enqueue(int literal, int reason);
+
+        /**
+         * @brief propagates the assignments of the trail
+         * @return index of a conflicting clause, -1 if none
+         */
+        int Propagate();
+
+        /**
+         * @brief first-UIP conflict analysis
+         *
+         * @param conflict conflicting clause
+         * @param learnt learnt clause, the asserting literal first
+         * @return level to backtrack to
+         */
+        int Analyze(int conflict, std::vector<int>& learnt);
+        void Backtrack(int level);
+
+        /**
+         * @brief runs the search until a solution, a proof or nof_conflicts conflicts
+         */
+        Result Search(long nof_conflicts, long conflict_budget);
+        int PickBranchLiteral();
+        void BumpActivity(int var);
+
+        void HeapInsert(int var);
+        int HeapPop();
+        void HeapUp(int position);
+        void HeapDown(int position);
+
+        static double Luby(int index);
+};
+
+#endif // CDCL_SOLVER_HPP
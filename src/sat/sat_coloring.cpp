@@ -0,0 +1,72 @@
+#include "sat_coloring.hpp"
+
+#include <algorithm>
+
+CDCLSolver::Result SatColor(Graph& graph, int k, const std::vector<int>& clique, long conflict_budget)
+{
+    if ( (int)clique.size() > k ) {
+        return CDCLSolver::Result::UNSAT;
+    }
+
+    const std::vector<int>& vertices = graph.GetVertices();
+    // more colors than vertices are never needed, and would only blow up the encoding
+    k = std::min<int>(k, vertices.size());
+    std::vector<int> index(graph.GetHighestVertex() + 1, -1);
+    for ( size_t i = 0; i < vertices.size(); i++ ) {
+        index[vertices[i]] = i;
+    }
+
+    CDCLSolver solver;
+    for ( size_t var = 0; var < vertices.size() * k; var++ ) {
+        solver.NewVar();
+    }
+    auto color_var = [k](int i, int c) { return i * k + c; };
+
+    bool satisfiable = true;
+    std::vector<int> clause;
+    for ( size_t i = 0; i < vertices.size() && satisfiable; i++ ) {
+        clause.clear();
+        for ( int c = 0; c < k; c++ ) {
+            clause.push_back(CDCLSolver::Lit(color_var(i, c)));
+        }
+        satisfiable = solver.AddClause(clause);
+    }
+
+    for ( size_t j = 0; j < clique.size() && satisfiable; j++ ) {
+        satisfiable = solver.AddClause({ CDCLSolver::Lit(color_var(index[clique[j]], j)) });
+    }
+
+    std::vector<int> neighbours;
+    for ( size_t i = 0; i < vertices.size() && satisfiable; i++ ) {
+        neighbours.clear();
+        graph.GetNeighbours(vertices[i], neighbours);
+        for ( int neighbour : neighbours ) {
+            int j = index[neighbour];
+            if ( j <= (int)i ) {
+                continue;   // each edge once, self loops skipped
+            }
+            for ( int c = 0; c < k && satisfiable; c++ ) {
+                satisfiable = solver.AddClause({ CDCLSolver::Lit(color_var(i, c), true),
+                                                 CDCLSolver::Lit(color_var(j, c), true) });
+            }
+        }
+    }
+    if ( !satisfiable ) {
+        return CDCLSolver::Result::UNSAT;
+    }
+
+    CDCLSolver::Result result = solver.Solve(conflict_budget);
+    if ( result == CDCLSolver::Result::SAT ) {
+        std::vector<unsigned short> coloring(graph.GetHighestVertex() + 1, 0);
+        for ( size_t i = 0; i < vertices.size(); i++ ) {
+            for ( int c = 0; c < k; c++ ) {
+                if ( solver.GetValue(color_var(i, c)) ) {
+                    coloring[vertices[i]] = c + 1;
+                    break;
+                }
+            }
+        }
+        graph.SetFullColoring(coloring);
+    }
+    return result;
+}
@@ -0,0 +1,25 @@
+#ifndef SAT_COLORING_HPP
+#define SAT_COLORING_HPP
+
+#include <vector>
+
+#include "graph.hpp"
+#include "cdcl_solver.hpp"
+
+/**
+ * @brief decides with the CDCL solver whether graph can be colored with k colors
+ *
+ * @details
+ * Variable x(v, c) means "v has color c". Every vertex gets a clause with all its colors 
+ * and every edge one clause per color forbidding both ends to take it (self loops are 
+ * ignored, as in the rest of the solver). The vertices of clique are precolored with 
+ * distinct colors: it breaks the symmetry between colors without losing solutions.
+ *
+ * @param graph graph to color, its coloring is set if the answer is SAT
+ * @param k number of colors
+ * @param clique vertices of a clique of graph, may be empty
+ * @param conflict_budget maximum number of conflicts before giving up (UNKNOWN)
+ */
+CDCLSolver::Result SatColor(Graph& graph, int k, const std::vector<int>& clique, long conflict_budget);
+
+#endif // SAT_COLORING_HPP
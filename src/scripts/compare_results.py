@@ -0,0 +1,209 @@
+"""
+Compares the results of a run of the solver against a baseline and flags the regressions.
+
+Usage: python3 compare_results.py --baseline=<file or directory>... <file or directory>...
+       [--alpha=0.05] [--min_change=0.05] [--threshold=0.2] [--min_time=0.05]
+
+Both sides are read from the --output (.txt) and --json_output (.json) files of run_instance,
+such as results/, and from the CSV of run_all_instances; a directory stands for all of them.
+For every instance run on both sides, three metrics are compared:
+  - time to chi: wall time (time to the proof for run_all_instances), timeouts count as worse
+    than any time;
+  - nodes per second: nodes processed over the wall time, when the counters were recorded;
+  - colors found.
+With at least two runs per side, a slowdown is flagged when a one-sided Welch t-test rejects
+"not worse" at level alpha and the means differ by more than min_change. With a single run
+on a side there is no variance to test against, a slowdown is flagged when the change exceeds
+threshold. More colors are always flagged. Times under min_time seconds are noise and skipped.
+
+Exits with 1 if a regression was flagged.
+"""
+import csv
+import json
+import math
+import os
+import sys
+from collections import defaultdict
+
+
+def empty_runs():
+    return {"time": [], "timeouts": 0, "nodes_per_sec": [], "colors": []}
+
+
+def add_run(runs, instance, time, colors, nodes):
+    run = runs[instance]
+    if time is None:
+        run["timeouts"] += 1
+    else:
+        run["time"].append(time)
+        if nodes is not None and time > 0:
+            run["nodes_per_sec"].append(nodes / time)
+    if colors is not None:
+        run["colors"].append(colors)
+
+
+def read_text(file_name, runs):
+    fields, stats = {}, {}
+    with open(file_name) as f:
+        for line in f:
+            words = line.split()
+            if len(words) >= 3 and words[0] == "stat":
+                stats[words[1]] = float(words[2])
+            elif len(words) >= 2 and not words[0].isdigit():
+                fields[words[0].rstrip(":")] = " ".join(words[1:])
+    if "problem_instance_file_name" not in fields or "number_of_colors" not in fields:
+        return
+    within = fields.get("is_within_time_limit") == "1"
+    time = float(fields["wall_time_sec"]) if within else None
+    add_run(runs, fields["problem_instance_file_name"], time, int(fields["number_of_colors"]),
+            stats.get("nodes_processed"))
+
+
+def read_json(file_name, runs):
+    with open(file_name) as f:
+        run = json.load(f)
+    if "problem_instance_file_name" not in run:
+        return
+    time = run["wall_time_sec"] if run.get("is_within_time_limit") else None
+    add_run(runs, run["problem_instance_file_name"], time, run.get("number_of_colors"),
+            run.get("statistics", {}).get("nodes_processed"))
+
+
+def read_csv(file_name, runs):
+    with open(file_name) as f:
+        for row in csv.DictReader(f):
+            if "instance" not in row:
+                return
+            time = float(row["time_to_proof"]) if row["time_to_proof"] else None
+            add_run(runs, row["instance"], time, int(row["chi"]), float(row["nodes"]))
+
+
+def load(paths):
+    runs = defaultdict(empty_runs)
+    readers = {".txt": read_text, ".json": read_json, ".csv": read_csv}
+    for path in paths:
+        files = [os.path.join(path, name) for name in sorted(os.listdir(path))] if os.path.isdir(path) else [path]
+        for file_name in files:
+            reader = readers.get(os.path.splitext(file_name)[1])
+            if reader:
+                try:
+                    reader(file_name, runs)
+                except (ValueError, KeyError, json.JSONDecodeError) as e:
+                    print(f"Warning: skipping {file_name}: {e}", file=sys.stderr)
+    return runs
+
+
+def incomplete_beta(a, b, x):
+    """regularized incomplete beta function I_x(a, b), by its continued fraction"""
+    if x <= 0 or x >= 1:
+        return 0.0 if x <= 0 else 1.0
+    if x > (a + 1) / (a + b + 2):
+        return 1 - incomplete_beta(b, a, 1 - x)
+    front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log(1 - x)) / a
+    c, d, f = 1.0, 0.0, 1.0
+    for i in range(200):
+        m = i // 2
+        if i == 0:
+            numerator = 1.0
+        elif i % 2 == 0:
+            numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+        else:
+            numerator = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))
+        d = 1 + numerator * d
+        d = 1 / (d if abs(d) > 1e-30 else 1e-30)
+        c = 1 + numerator / (c if abs(c) > 1e-30 else 1e-30)
+        f *= c * d
+        if abs(1 - c * d) < 1e-12:
+            break
+    return front * (f - 1)
+
+
+def welch_p_value(baseline, current):
+    """one-sided p-value of "mean of current > mean of baseline" (Welch's t-test)"""
+    n1, n2 = len(baseline), len(current)
+    m1, m2 = sum(baseline) / n1, sum(current) / n2
+    v1 = sum((x - m1) ** 2 for x in baseline) / (n1 - 1)
+    v2 = sum((x - m2) ** 2 for x in current) / (n2 - 1)
+    se2 = v1 / n1 + v2 / n2
+    if se2 == 0:
+        return 0.0 if m2 > m1 else 1.0
+    t = (m2 - m1) / math.sqrt(se2)
+    df = se2 ** 2 / ((v1 / n1) ** 2 / (n1 - 1) + (v2 / n2) ** 2 / (n2 - 1)) if v1 > 0 or v2 > 0 else n1 + n2 - 2
+    tail = 0.5 * incomplete_beta(df / 2, 0.5, df / (df + t * t))
+    return tail if t > 0 else 1 - tail
+
+
+def worse(baseline, current, higher_is_worse, options):
+    """(flagged, change, test) of a metric, change of the mean relative to the baseline"""
+    if not baseline or not current:
+        return False, None, "-"
+    m1, m2 = sum(baseline) / len(baseline), sum(current) / len(current)
+    if m1 == 0:
+        return False, None, "-"
+    change = (m2 - m1) / m1
+    worsening = change if higher_is_worse else -change
+    if not higher_is_worse:
+        baseline, current = [-x for x in baseline], [-x for x in current]
+    if len(baseline) >= 2 and len(current) >= 2:
+        p = welch_p_value(baseline, current)
+        return p < options["alpha"] and worsening > options["min_change"], change, f"p={p:.3f}"
+    return worsening > options["threshold"], change, "n=1"
+
+
+def main():
+    options = {"alpha": 0.05, "min_change": 0.05, "threshold": 0.2, "min_time": 0.05}
+    baseline_paths, current_paths = [], []
+    for arg in sys.argv[1:]:
+        key, _, value = arg.partition("=")
+        if key == "--baseline":
+            baseline_paths.append(value)
+        elif key.lstrip("-") in options and arg.startswith("--"):
+            options[key.lstrip("-")] = float(value)
+        elif arg.startswith("--"):
+            print(f"Error: unknown argument {arg}", file=sys.stderr)
+            return 2
+        else:
+            current_paths.append(arg)
+    if not baseline_paths or not current_paths:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    baseline, current = load(baseline_paths), load(current_paths)
+    instances = sorted(set(baseline) & set(current))
+    if not instances:
+        print("Error: no instance in common between the baseline and the current results", file=sys.stderr)
+        return 2
+
+    regressions = 0
+    print(f"{'instance':<20}{'metric':<16}{'baseline':>12}{'current':>12}{'change':>9}  test")
+    for instance in instances:
+        old, new = baseline[instance], current[instance]
+        rows = []
+        if new["timeouts"] > 0 and old["timeouts"] == 0:
+            rows.append(("time to chi", f"{len(old['time'])} solved", f"{new['timeouts']} timeouts", None, "-", True))
+        elif max(old["time"] + new["time"], default=0) >= options["min_time"]:
+            flagged, change, test = worse(old["time"], new["time"], True, options)
+            rows.append(("time to chi", old["time"], new["time"], change, test, flagged))
+            flagged, change, test = worse(old["nodes_per_sec"], new["nodes_per_sec"], False, options)
+            if change is not None:
+                rows.append(("nodes/s", old["nodes_per_sec"], new["nodes_per_sec"], change, test, flagged))
+        if old["colors"] and new["colors"]:
+            more = max(new["colors"]) > max(old["colors"]) or sum(new["colors"]) / len(new["colors"]) > \
+                   sum(old["colors"]) / len(old["colors"])
+            rows.append(("colors", old["colors"], new["colors"], None, "-", more))
+
+        for metric, old_values, new_values, change, test, flagged in rows:
+            def show(values):
+                return values if isinstance(values, str) else f"{sum(values) / len(values):.4g}" if values else "-"
+            change_text = f"{change:+.1%}" if change is not None else ""
+            print(f"{instance:<20}{metric:<16}{show(old_values):>12}{show(new_values):>12}{change_text:>9}  {test}"
+                  f"{'  REGRESSION' if flagged else ''}")
+            regressions += flagged
+
+    only = len(set(baseline) ^ set(current))
+    print(f"{len(instances)} instances compared ({only} on one side only), {regressions} regressions")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
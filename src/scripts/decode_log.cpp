@@ -0,0 +1,31 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "event_log.hpp"
+
+/**
+ * Renders the binary event logs written by the solvers (logs/log_<rank>.bin with
+ * --logging=1) as the text log, one line per event, sorted by time.
+ *
+ * Usage: decode_log <log.bin>... [> log.txt]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <log.bin>..." << std::endl;
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        int rank;
+        std::vector<EventRecord> records;
+        if (!EventLog::Read(argv[i], rank, records)) {
+            std::cerr << "Error: " << argv[i] << " is not an event log" << std::endl;
+            return 1;
+        }
+        for (const EventRecord& record : records) {
+            std::cout << EventLog::Render(record, rank) << "\n";
+        }
+    }
+    return 0;
+}
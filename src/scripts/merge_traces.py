@@ -0,0 +1,77 @@
+"""
+Merges the per-rank timelines of run_instance --trace=<prefix> into one Chrome trace.
+
+Usage: python3 merge_traces.py <prefix>.*.json > trace.json
+
+Open the result in ui.perfetto.dev (or chrome://tracing): every rank is a process, every
+thread role (terminator, gatherer, employer, worker, estimator) a thread, and arrows link
+the spans exchanging MPI messages. A summary is printed on stderr: the latency of the work
+requests (from the request sent to the response received, and to the node received) and
+the time every rank spent idle.
+"""
+import json
+import sys
+from collections import defaultdict
+
+# tags of branch_n_bound_par.cpp
+TAG_WORK_REQUEST = 1
+TAG_WORK_RESPONSE = 2
+TAG_WORK_STEALING = 6
+
+
+def percentile(values, fraction):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(fraction * len(values)))]
+
+
+def describe(name, latencies):
+    if not latencies:
+        return f"{name}: none"
+    return (f"{name}: {len(latencies)}, mean {sum(latencies) / len(latencies):.3f} ms, "
+            f"p50 {percentile(latencies, 0.5):.3f} ms, p95 {percentile(latencies, 0.95):.3f} ms, "
+            f"max {max(latencies):.3f} ms")
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+
+    events = []
+    for file_name in sys.argv[1:]:
+        with open(file_name) as f:
+            events.extend(json.load(f)["traceEvents"])
+
+    # flow id -> timestamps (us) of the message sent and received
+    sent, received = {}, {}
+    idle = defaultdict(float)
+    for event in events:
+        if event["ph"] == "s":
+            sent[event["id"]] = event
+        elif event["ph"] == "f":
+            received[event["id"]] = event
+        elif event["ph"] == "X" and event["name"] == "idle":
+            idle[event["pid"]] += event["dur"]
+
+    messages = defaultdict(list)
+    for flow_id, start in sent.items():
+        if flow_id in received:
+            messages[start["args"]["tag"]].append((received[flow_id]["ts"] - start["ts"]) / 1000)
+
+    print(describe("work requests delivered", messages[TAG_WORK_REQUEST]), file=sys.stderr)
+    print(describe("work responses delivered", messages[TAG_WORK_RESPONSE]), file=sys.stderr)
+    print(describe("stolen nodes delivered", messages[TAG_WORK_STEALING]), file=sys.stderr)
+    round_trips = [s["dur"] / 1000 for s in events if s["ph"] == "X" and s["name"] == "steal request"]
+    print(describe("steal requests (round trip)", round_trips), file=sys.stderr)
+    for rank in sorted(idle):
+        print(f"rank {rank}: idle {idle[rank] / 1e6:.3f} s", file=sys.stderr)
+    unmatched = len(sent) - sum(len(latencies) for latencies in messages.values())
+    if unmatched:
+        print(f"{unmatched} messages sent were not received (termination)", file=sys.stderr)
+
+    json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
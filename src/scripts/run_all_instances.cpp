@@ -1,175 +1,347 @@
-#include <string>
-#include <unordered_map>
-#include <iostream>
+#include <mpi.h>
+
+#include <algorithm>
+#include <climits>
 #include <cstdlib> // For std::stoi
 #include <fstream>
-#include <filesystem>
-
-std::string exec(const char* cmd) {
-    std::array<char, 128> buffer;
-    std::string result;
-    std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(cmd, "r"), pclose);
-    if (!pipe) {
-        throw std::runtime_error("popen() failed!");
-    }
-    while (fgets(buffer.data(), static_cast<int>(buffer.size()), pipe.get()) != nullptr) {
-        result += buffer.data();
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "branch_n_bound_par.hpp"
+#include "branching_strategy.hpp"
+#include "fastwclq.hpp"
+#include "color.hpp"
+#include "recolor.hpp"
+#include "advanced_color.hpp"
+#include "dsatur_color.hpp"
+#include "csr_graph.hpp"
+#include "graph_generators.hpp"
+#include "result_writer.hpp"
+#include "solver_stats.hpp"
+#include "fast_random.hpp"
+
+/**
+ * Runs the instances of the easy, medium and hard suites in this process, each one several
+ * times, and writes one CSV line per run: time to the best upper bound, time to the proof,
+ * nodes processed and peak memory. All ranks of mpirun take part in every run.
+ *
+ * Usage: mpirun -np <p> ./run_all_instances [--run_easy] [--run_medium] [--run_hard]
+ *        [--instances=<a.col,b.col>] [--generate=<spec>]... [--repetitions=<n>] [--seed=<seed>] [--timeout=<timeout>]
+ *        [--sol_gather_period=<period>] [--balanced=<0|1>] [--color_strategy=<0-3>] [--csv=<file>]
+ *        [--fail_on_mismatch=<0|1>] [--hw_counters=<0|1>] [--stop_at_expected=<0|1>]
+ *
+ * --generate adds a synthetic graph to the runs (suite "generated", see GraphGenerator::FromSpec,
+ * e.g. leighton:n=450,k=15,m=8000,seed=2), checked against its chromatic number when the
+ * construction fixes it.
+ *
+ * --hw_counters=1 adds the instructions per cycle and the LLC and branch misses per node of the
+ * search (MPI waits excluded), from the hardware counters of every thread (see HardwareCounters).
+ *
+ * The runs search for the chromatic number without knowing it, and are checked against
+ * expected_chi.txt afterwards: time_to_proof is when the optimality was proven. With
+ * --stop_at_expected=1 a run also stops once it reaches the expected chromatic number, which is
+ * not a proof; its time is then reported as time_to_expected instead.
+ *
+ * Exits with 1 if a run returns a chromatic number different from expected_chi.txt (a timeout
+ * included) or an invalid coloring, unless --fail_on_mismatch=0 (e.g. when compare_results.py
+ * judges the colors against a baseline).
+ */
+
+/**
+ * @brief restarts the peak resident memory of the process (Linux), so that each run measures its own
+ */
+static void ResetPeakMemory() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+/**
+ * @brief peak resident memory of the process since the last reset, in kB (0 if unknown)
+ */
+static long PeakMemoryKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stol(line.substr(6));
+        }
     }
-    return result;
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
-    std::unordered_map<std::string, int> expectedEasyResults;
-    std::unordered_map<std::string, int> expectedMediumResults;
-    std::unordered_map<std::string, int> expectedHardResults;
-    expectedEasyResults.insert({"anna.col", 11});
-    expectedEasyResults.insert({"david.col", 11});
-    expectedEasyResults.insert({"fpsol2.i.1.col", 65});
-    expectedEasyResults.insert({"fpsol2.i.2.col", 30});
-    expectedEasyResults.insert({"fpsol2.i.3.col", 30});
-    expectedEasyResults.insert({"games120.col", 9});
-    expectedEasyResults.insert({"homer.col", 13});
-    expectedEasyResults.insert({"huck.col", 11});
-    expectedEasyResults.insert({"inithx.i.1.col", 54});
-    expectedEasyResults.insert({"inithx.i.2.col", 31});
-    expectedEasyResults.insert({"inithx.i.3.col", 31});
-    expectedEasyResults.insert({"jean.col", 10});
-    expectedEasyResults.insert({"miles250.col", 8});
-    expectedEasyResults.insert({"miles500.col", 20});
-    expectedEasyResults.insert({"miles750.col", 31});
-    expectedEasyResults.insert({"miles1000.col", 42});
-    expectedEasyResults.insert({"miles1500.col", 73});
-    expectedEasyResults.insert({"myciel3.col", 4});
-    expectedEasyResults.insert({"myciel4.col", 5});
-    expectedEasyResults.insert({"myciel5.col", 6});
-    expectedEasyResults.insert({"myciel6.col", 7});
-    expectedEasyResults.insert({"myciel7.col", 8});
-    expectedEasyResults.insert({"zeroin.i.1.col", 49});
-    expectedEasyResults.insert({"zeroin.i.2.col", 30});
-    expectedEasyResults.insert({"zeroin.i.3.col", 30});
-
-    expectedMediumResults.insert({"queen5_5.col", 5});
-    expectedMediumResults.insert({"queen6_6.col", 7});
-    expectedMediumResults.insert({"queen7_7.col", 7});
-
-    expectedHardResults.insert({"queen8_8.col", 9});
-    expectedHardResults.insert({"queen8_12.col", 12});
-    expectedHardResults.insert({"queen9_9.col", 10});
-    expectedHardResults.insert({"queen11_11.col", 11});
-    expectedHardResults.insert({"queen13_13.col", 13});
-    expectedHardResults.insert({"le450_5a.col", 5});
-    expectedHardResults.insert({"le450_5b.col", 5});
-    expectedHardResults.insert({"le450_5c.col", 5});
-    expectedHardResults.insert({"le450_5d.col", 5});
-    expectedHardResults.insert({"le450_15a.col", 15});
-    expectedHardResults.insert({"le450_15b.col", 15});
-    expectedHardResults.insert({"le450_15c.col", 15});
-    expectedHardResults.insert({"le450_15d.col", 15});
-    expectedHardResults.insert({"le450_25a.col", 25});
-    expectedHardResults.insert({"le450_25b.col", 25});
-    expectedHardResults.insert({"le450_25c.col", 25});
-    expectedHardResults.insert({"le450_25d.col", 25});
-    expectedHardResults.insert({"mulsol.i.1.col", 49});
-    expectedHardResults.insert({"mulsol.i.3.col", 31});
-    expectedHardResults.insert({"mulsol.i.4.col", 31});
-    expectedHardResults.insert({"mulsol.i.5.col", 31});
+    std::map<std::string, int> expectedEasyResults = {
+        {"anna.col", 11}, {"david.col", 11}, {"fpsol2.i.1.col", 65}, {"fpsol2.i.2.col", 30}, {"fpsol2.i.3.col", 30},
+        {"games120.col", 9}, {"homer.col", 13}, {"huck.col", 11}, {"inithx.i.1.col", 54}, {"inithx.i.2.col", 31},
+        {"inithx.i.3.col", 31}, {"jean.col", 10}, {"miles250.col", 8}, {"miles500.col", 20}, {"miles750.col", 31},
+        {"miles1000.col", 42}, {"miles1500.col", 73}, {"myciel3.col", 4}, {"myciel4.col", 5}, {"myciel5.col", 6},
+        {"myciel6.col", 7}, {"myciel7.col", 8}, {"zeroin.i.1.col", 49}, {"zeroin.i.2.col", 30}, {"zeroin.i.3.col", 30}
+    };
+    std::map<std::string, int> expectedMediumResults = {
+        {"queen5_5.col", 5}, {"queen6_6.col", 7}, {"queen7_7.col", 7}
+    };
+    std::map<std::string, int> expectedHardResults = {
+        {"queen8_8.col", 9}, {"queen8_12.col", 12}, {"queen9_9.col", 10}, {"queen11_11.col", 11}, {"queen13_13.col", 13},
+        {"le450_5a.col", 5}, {"le450_5b.col", 5}, {"le450_5c.col", 5}, {"le450_5d.col", 5},
+        {"le450_15a.col", 15}, {"le450_15b.col", 15}, {"le450_15c.col", 15}, {"le450_15d.col", 15},
+        {"le450_25a.col", 25}, {"le450_25b.col", 25}, {"le450_25c.col", 25}, {"le450_25d.col", 25},
+        {"mulsol.i.1.col", 49}, {"mulsol.i.3.col", 31}, {"mulsol.i.4.col", 31}, {"mulsol.i.5.col", 31}
+    };
 
     bool run_easy = false;
     bool run_medium = false;
     bool run_hard = false;
+    std::vector<std::string> instances;
+    std::map<std::string, GeneratedGraph> generated;
+    int repetitions = 3;
+    int seed = 1;
+    int timeout = 60;
+    int sol_gather_period = 10;
+    int balanced = 1;
+    int color_strategy = 0;
+    std::string csv_file = "run_all_instances.csv";
+    int fail_on_mismatch = 1;
+    int hw_counters = 0;
+    int stop_at_expected = 0;
 
     // Parse optional arguments
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
         if (arg == "--run_easy") {
             run_easy = true;
+            continue;
         } else if (arg == "--run_medium") {
             run_medium = true;
-        } else if (arg== "--run_hard") {
+            continue;
+        } else if (arg == "--run_hard") {
             run_hard = true;
-        } else {
+            continue;
+        }
+        size_t pos = arg.find('=');
+        if (pos == std::string::npos) {
             std::cerr << "Error: Invalid argument format " << arg << ".\n";
             return 1;
         }
+        std::string key = arg.substr(0, pos);
+        std::string value = arg.substr(pos + 1);
+        try {
+            if (key == "--instances") {
+                std::stringstream names(value);
+                std::string name;
+                while (std::getline(names, name, ',')) {
+                    if (!name.empty()) instances.push_back(name);
+                }
+            } else if (key == "--generate") {
+                GeneratedGraph graph;
+                std::string error;
+                if (!GraphGenerator::FromSpec(value, graph, error)) {
+                    std::cerr << "Error: " << error << ".\n";
+                    return 1;
+                }
+                instances.push_back(graph.name);
+                generated[graph.name] = std::move(graph);
+            } else if (key == "--repetitions") {
+                repetitions = std::max(1, std::stoi(value));
+            } else if (key == "--seed") {
+                seed = std::stoi(value);
+            } else if (key == "--timeout") {
+                timeout = std::stoi(value);
+            } else if (key == "--sol_gather_period") {
+                sol_gather_period = std::stoi(value);
+            } else if (key == "--balanced") {
+                balanced = std::stoi(value);
+            } else if (key == "--color_strategy") {
+                color_strategy = std::stoi(value);
+            } else if (key == "--csv") {
+                csv_file = value;
+            } else if (key == "--fail_on_mismatch") {
+                fail_on_mismatch = std::stoi(value);
+            } else if (key == "--hw_counters") {
+                hw_counters = std::stoi(value);
+            } else if (key == "--stop_at_expected") {
+                stop_at_expected = std::stoi(value);
+            } else {
+                std::cerr << "Error: Unknown argument " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Invalid value for argument " << key << ".\n";
+            return 1;
+        }
     }
 
-    if ( run_easy ) {
-        for ( auto file_chi_pair : expectedEasyResults ) {
-            std::string command;
-            std::string output_file = "run_all_instances.slurm";
-            std::ofstream ofs(output_file);
-            
-            ofs << "#!/bin/bash " << std::endl
-                << "#SBATCH --job-name=team2_mpi_branch_n_bound    # Job name" << std::endl 
-                << "#SBATCH --nodes=1                        # Number of nodes" << std::endl
-                << "#SBATCH --ntasks-per-node=8              # MPI tasks per node" << std::endl
-                << "#SBATCH --cpus-per-task=4               # Cores per MPI task (increase if CPU-BOUND)" << std::endl
-                << "#SBATCH --time=00:15:00                  # Time limit (HH:MM:SS)" << std::endl
-                << "#SBATCH --partition=cpu                  # Replace with actual partition" << std::endl
-                << "#SBATCH --output=output_mpi.txt           # Standard output file" << std::endl
-                << "#SBATCH --error=error_mpi.txt             # Standard error file" << std::endl << std::endl;
-            
-            std::string output = file_chi_pair.first;
-            output = output.substr(0, output.size() - 3) + "_output.txt";
-            ofs << "srun run_instance " << file_chi_pair.first << " --timeout=600 --sol_gather_period=20 --balanced=1 --output=" 
-                << output << std::endl;
-
-            command = "sbatch " + output_file;
-            std::cout << exec(command.c_str()) << std::endl;
-        }
+    // suite of every instance run
+    std::vector<std::pair<std::string, std::string>> runs;
+    auto add_suite = [&runs](const std::map<std::string, int>& suite, const std::string& name) {
+        for (const auto& file_chi_pair : suite) runs.emplace_back(file_chi_pair.first, name);
+    };
+    if (run_easy) add_suite(expectedEasyResults, "easy");
+    if (run_medium) add_suite(expectedMediumResults, "medium");
+    if (run_hard) add_suite(expectedHardResults, "hard");
+    for (const std::string& name : instances) {
+        std::string suite = expectedEasyResults.count(name) ? "easy" : expectedMediumResults.count(name) ? "medium"
+                          : expectedHardResults.count(name) ? "hard" : generated.count(name) ? "generated" : "other";
+        runs.emplace_back(name, suite);
+    }
+    if (runs.empty()) {
+        std::cerr << "Error: no instance to run, use --run_easy, --run_medium, --run_hard, --instances or --generate.\n";
+        return 1;
     }
 
-    if ( run_medium ) {
-        for ( auto file_chi_pair : expectedMediumResults ) {
-            std::string command;
-            std::string output_file = "run_all_instances.slurm";
-            std::ofstream ofs(output_file);
-            
-            ofs << "#!/bin/bash " << std::endl
-                << "#SBATCH --job-name=team2_mpi_branch_n_bound    # Job name" << std::endl 
-                << "#SBATCH --nodes=8                        # Number of nodes" << std::endl
-                << "#SBATCH --ntasks-per-node=8              # MPI tasks per node" << std::endl
-                << "#SBATCH --cpus-per-task=4               # Cores per MPI task (increase if CPU-BOUND)" << std::endl
-                << "#SBATCH --time=04:00:00                  # Time limit (HH:MM:SS)" << std::endl
-                << "#SBATCH --partition=cpu                  # Replace with actual partition" << std::endl
-                << "#SBATCH --output=output_mpi.txt           # Standard output file" << std::endl
-                << "#SBATCH --error=error_mpi.txt             # Standard error file" << std::endl << std::endl;
-            
-            std::string output = file_chi_pair.first;
-            output = output.substr(0, output.size() - 3) + "_output.txt";
-            ofs << "srun run_instance " << file_chi_pair.first << " --timeout=10000 --sol_gather_period=20 --balanced=1 --output=" 
-                << output << std::endl;
-
-
-            command = "sbatch " + output_file;
-            std::cout << exec(command.c_str()) << std::endl;
-        }
+    // Load expected results from text file
+    std::ifstream txt_file("expected_chi.txt");
+    if (!txt_file.is_open()) {
+        std::cerr << "Error: Could not open expected results text file.\n";
+        return 1;
+    }
+    std::unordered_map<std::string, int> expected_results;
+    std::string key;
+    int value;
+    while (txt_file >> key >> value) {
+        expected_results[key] = value;
+    }
+    txt_file.close();
+
+    // Initialize MPI with multithreading enabled
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    if (provided < MPI_THREAD_MULTIPLE) {
+        std::cerr << "MPI does not support full multithreading!" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    int my_rank, p;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &p);
+
+    if (hw_counters == 1 && !HardwareCounters::Enable(true) && my_rank == 0) {
+        std::cerr << "Warning: hardware counters are not available (perf_event_open), running without them" << std::endl;
+    }
+
+    NeighboursBranchingStrategy branching_strategy;
+    FastCliqueStrategy clique_strategy;
+    GreedyColorStrategy greedy_color_strategy;
+    DSaturColorStrategy base_color_strategy;
+    DSaturColorStrategy another_dsatur_strategy;
+    GreedySwapRecolorStrategy recolor_strategy;
+    ColorNRecolorStrategy advanced_color_strategy(base_color_strategy, recolor_strategy);
+    InterleavedColorStrategy mixed_color_strategy(greedy_color_strategy, advanced_color_strategy, 5, 2);
+    InterleavedColorStrategy another_mixed_color_strategy(another_dsatur_strategy, advanced_color_strategy, 5, 2);
+    ColorStrategy* color_strategy_obj = color_strategy == 0 ? (ColorStrategy*) &greedy_color_strategy
+                                      : color_strategy == 1 ? (ColorStrategy*) &mixed_color_strategy
+                                      : color_strategy == 2 ? (ColorStrategy*) &base_color_strategy
+                                      : (ColorStrategy*) &another_mixed_color_strategy;
+
+    std::ofstream csv;
+    if (my_rank == 0) {
+        csv.open(csv_file);
+        csv << "instance,suite,repetition,seed,ranks,expected_chi,chi,valid,time_to_best_ub,time_to_proof,"
+            << "time_to_expected,wall_time,nodes,peak_memory_kb,ipc,llc_misses_per_node,branch_misses_per_node" << std::endl;
     }
 
-    if ( run_hard ) {
-        for ( auto file_chi_pair : expectedHardResults ) {
-            std::string command;
-            std::string output_file = "run_all_instances.slurm";
-            std::ofstream ofs(output_file);
-            
-            ofs << "#!/bin/bash " << std::endl
-                << "#SBATCH --job-name=team2_mpi_branch_n_bound    # Job name" << std::endl 
-                << "#SBATCH --nodes=64                        # Number of nodes" << std::endl
-                << "#SBATCH --ntasks-per-node=8              # MPI tasks per node" << std::endl
-                << "#SBATCH --cpus-per-task=4               # Cores per MPI task (increase if CPU-BOUND)" << std::endl
-                << "#SBATCH --time=04:00:00                  # Time limit (HH:MM:SS)" << std::endl
-                << "#SBATCH --partition=cpu                  # Replace with actual partition" << std::endl
-                << "#SBATCH --output=output_mpi.txt           # Standard output file" << std::endl
-                << "#SBATCH --error=error_mpi.txt             # Standard error file" << std::endl << std::endl;
-            
-            std::string output = file_chi_pair.first;
-            output = output.substr(0, output.size() - 3) + "_output.txt";
-            ofs << "srun run_instance " << file_chi_pair.first << " --timeout=10000 --sol_gather_period=20 --balanced=1 --output=" 
-                << output << std::endl;
-
-            command = "sbatch " + output_file;
-            std::cout << exec(command.c_str()) << std::endl;
+    int mismatches = 0;
+    for (const auto& [file_name, suite] : runs) {
+        // All processes read (or generate) the graph once, every run solves a copy
+        std::unique_ptr<CSRGraph> graph;
+        int expected_chromatic_number;
+        if (suite == "generated") {
+            graph = generated[file_name].ToCSRGraph();
+            // 0 when the construction leaves it unknown, the run is then not checked
+            expected_chromatic_number = generated[file_name].chromatic_number;
+        } else {
+            auto expected = expected_results.find(file_name);
+            if (expected == expected_results.end()) {
+                if (my_rank == 0) std::cerr << "Error: No expected result found for " << file_name << ", skipped.\n";
+                mismatches++;
+                continue;
+            }
+            expected_chromatic_number = expected->second;
+
+            Dimacs dimacs;
+            graph.reset(CSRGraph::LoadFromDimacs("graphs_instances/" + file_name, dimacs));
+            if (!graph) {
+                if (my_rank == 0) std::cerr << "Error: " << dimacs.getError() << ", " << file_name << " skipped.\n";
+                mismatches++;
+                continue;
+            }
+        }
+        // without a target the run has to prove its result, which is checked afterwards
+        unsigned short target_chi = stop_at_expected == 1 && expected_chromatic_number > 0
+                                  ? expected_chromatic_number : USHRT_MAX;
+
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            int run_seed = seed + repetition;
+            ThreadRandom::Seed(run_seed, my_rank);
+            CSRGraph run_graph(*graph);
+            BranchNBoundPar solver(branching_strategy, clique_strategy, *color_strategy_obj,
+                                   "logs/log_" + std::to_string(my_rank) + ".bin", false);
+            BalancedBranchNBoundPar balanced_solver(branching_strategy, clique_strategy, *color_strategy_obj,
+                                                    "logs/log_" + std::to_string(my_rank) + ".bin", false);
+
+            SolverStats::Reset();
+            ResetPeakMemory();
+            MPI_Barrier(MPI_COMM_WORLD);
+            double start_time = MPI_Wtime();
+            double optimum_time;
+            int chromatic_number = balanced
+                ? balanced_solver.Solve(run_graph, optimum_time, timeout, sol_gather_period, target_chi)
+                : solver.Solve(run_graph, optimum_time, timeout, sol_gather_period, target_chi);
+            double wall_time = MPI_Wtime() - start_time;
+
+            StatsReport stats = SolverStats::Reduce(MPI_COMM_WORLD);
+            long peak_memory = PeakMemoryKb(), max_peak_memory = 0;
+            MPI_Reduce(&peak_memory, &max_peak_memory, 1, MPI_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+            // the best upper bound was found by the rank whose coloring was returned
+            double incumbent_time = balanced ? balanced_solver.GetIncumbentTime() : solver.GetIncumbentTime();
+            std::vector<double> incumbent_times(p);
+            MPI_Gather(&incumbent_time, 1, MPI_DOUBLE, incumbent_times.data(), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+            if (my_rank == 0) {
+                int incumbent_rank = balanced ? balanced_solver.GetIncumbentRank() : solver.GetIncumbentRank();
+                double time_to_best = incumbent_times[std::max(incumbent_rank, 0)];
+                SolveOutcome outcome = balanced ? balanced_solver.GetOutcome() : solver.GetOutcome();
+                auto time_if = [optimum_time, outcome](SolveOutcome reason) {
+                    return outcome == reason ? std::to_string(optimum_time) : std::string();
+                };
+                bool valid = VerifyColoring(run_graph, run_graph.GetFullColoring());
+                long long nodes = stats.counters[static_cast<size_t>(StatCounter::NODES_PROCESSED)];
+                HardwareValues events = stats.SearchEvents();
+                auto event = [&events](HardwareEvent e) { return events[static_cast<size_t>(e)]; };
+                // per node rates, empty without the hardware counters
+                auto rate = [&stats](double value, double per) {
+                    return stats.HasHardwareEvents() && per > 0 ? std::to_string(value / per) : std::string();
+                };
+                if ((expected_chromatic_number > 0 && chromatic_number != expected_chromatic_number) || !valid) {
+                    mismatches++;
+                }
+
+                csv << file_name << "," << suite << "," << repetition << "," << run_seed << "," << p << ","
+                    << (expected_chromatic_number > 0 ? std::to_string(expected_chromatic_number) : "") << ","
+                    << chromatic_number << "," << valid << ","
+                    << time_to_best << "," << time_if(SolveOutcome::PROVEN) << "," << time_if(SolveOutcome::EXPECTED) << ","
+                    << wall_time << "," << nodes << "," << max_peak_memory << ","
+                    << rate(event(HardwareEvent::INSTRUCTIONS), event(HardwareEvent::CYCLES)) << ","
+                    << rate(event(HardwareEvent::LLC_MISSES), nodes) << ","
+                    << rate(event(HardwareEvent::BRANCH_MISSES), nodes) << std::endl;
+                std::cout << std::left << std::setw(18) << file_name << " #" << repetition << ": chi " << chromatic_number
+                          << " (expected "
+                          << (expected_chromatic_number > 0 ? std::to_string(expected_chromatic_number) : "?") << ")" << (valid ? "" : " INVALID")
+                          << (outcome == SolveOutcome::TIMEOUT ? " timeout" : outcome == SolveOutcome::EXPECTED ? " not proven" : "")
+                          << ", " << wall_time << " s" << std::endl;
+            }
         }
     }
 
+    MPI_Bcast(&mismatches, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (my_rank == 0) {
+        std::cout << runs.size() << " instances, " << mismatches << " wrong or missing results, written to "
+                  << csv_file << std::endl;
+    }
+    MPI_Finalize();
+    return mismatches == 0 || fail_on_mismatch == 0 ? 0 : 1;
 }
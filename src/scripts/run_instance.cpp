@@ -4,6 +4,9 @@
 #include <cstdlib> // For std::stoi
 #include <unordered_map>
 #include <filesystem>
+#include <algorithm>
+#include <climits>
+#include <memory>
 
 #include "branch_n_bound_par.hpp"
 #include "branching_strategy.hpp"
@@ -15,36 +18,21 @@
 #include "dsatur_color.hpp"
 #include "csr_graph.hpp"
 #include "dimacs.hpp"
+#include "result_writer.hpp"
+#include "coloring_reader.hpp"
+#include "graph_fingerprint.hpp"
+#include "result_cache.hpp"
+#include "graph_reducer.hpp"
+#include "connected_components.hpp"
+#include "portfolio.hpp"
+#include "instance_features.hpp"
+#include "strategy_tuner.hpp"
+#include "solver_stats.hpp"
+#include "timeline_trace.hpp"
+#include "fast_random.hpp"
+#include "status_server.hpp"
 
 
-/**
- * @brief checks if the coloring is valid (i.e. a vertex is not colored or two neighours have the same color)
- * 
- * @param graph graph to check if the coloring is valid
- * @return true if coloring is valid
- * @return false if coloring is not valid
- */
-bool CheckColoring(const Graph& graph) {
-    unsigned short current_color;
-    std::vector<int> neighbours;
-    for ( int vertex : graph.GetVertices() ) {
-        current_color = graph.GetColor(vertex);
-        graph.GetNeighbours(vertex, neighbours);
-
-        if ( current_color == 0 ) {
-            return false;
-        }
-
-        for ( int neighbour : neighbours ) {
-            if ( graph.GetColor(neighbour) == current_color ) {
-                return false;
-            } 
-        }
-        
-    }
-    return true;
-}
-
 /**
  * @brief Main function to run the graph coloring solver using the branch and bound method.
  *
@@ -60,13 +48,36 @@ int main(int argc, char** argv) {
     int balanced = 1;
     int color_strategy = 0;
     int logging_flag = 0;
+    int reduce = 1;
+    int symmetry = 0;
+    int decision = 0;
+    int sat_threshold = 0;
+    int sat_gap = 0;
+    long sat_conflicts = 10000;
+    int nogoods = 0;
+    int nogood_share = 0;
+    int auto_tune = 0;
+    int progress = 0;
+    int hw_counters = 0;
+    unsigned long long seed = 0;
     std::string file_name;
     std::string output_file = "output.txt";
+    std::string json_output_file;
+    std::string initial_coloring_file;
+    std::string cache_dir;
+    std::string portfolio_file;
+    std::string tuning_rules_file;
+    std::string trace_prefix;
+    std::string status_socket;
 
     // Check for required arguments
     if (argc < 2) {
         std::cerr << "Usage: " << argv[0] << " <file_name> [--timeout=<timeout>] [--sol_gather_period=<period>] "
-                  << "[--balanced=<0|1>] [--output=<output_file>] [--logging=<0|1>]\n";
+                  << "[--balanced=<0|1>] [--output=<output_file>] [--json_output=<json_file>] [--logging=<0|1>] "
+                  << "[--initial_coloring=<coloring_file>] [--cache_dir=<directory>] [--reduce=<0|1>] [--symmetry=<levels>] [--decision=<0|1>]\n"
+                  << "[--sat_threshold=<vertices>] [--sat_gap=<gap>] [--sat_conflicts=<conflicts>] [--nogoods=<capacity>] [--nogood_share=<count>]\n"
+                  << "[--portfolio=<portfolio_file>] [--auto_tune=<0|1>] [--tuning_rules=<rules_file>] [--progress=<0|1>] [--trace=<prefix>]\n"
+                  << "[--seed=<seed>] [--hw_counters=<0|1>] [--status_socket=<path>]\n";
         return 1;
     }
 
@@ -97,6 +108,44 @@ int main(int argc, char** argv) {
                     color_strategy = std::stoi(value);
                 } else if (key == "--output") {
                     output_file = value;
+                } else if (key == "--json_output") {
+                    json_output_file = value;
+                } else if (key == "--initial_coloring") {
+                    initial_coloring_file = value;
+                } else if (key == "--cache_dir") {
+                    cache_dir = value;
+                } else if (key == "--reduce") {
+                    reduce = std::stoi(value);
+                } else if (key == "--symmetry") {
+                    symmetry = std::stoi(value);
+                } else if (key == "--decision") {
+                    decision = std::stoi(value);
+                } else if (key == "--sat_threshold") {
+                    sat_threshold = std::stoi(value);
+                } else if (key == "--sat_gap") {
+                    sat_gap = std::stoi(value);
+                } else if (key == "--sat_conflicts") {
+                    sat_conflicts = std::stol(value);
+                } else if (key == "--nogoods") {
+                    nogoods = std::stoi(value);
+                } else if (key == "--nogood_share") {
+                    nogood_share = std::stoi(value);
+                } else if (key == "--portfolio") {
+                    portfolio_file = value;
+                } else if (key == "--auto_tune") {
+                    auto_tune = std::stoi(value);
+                } else if (key == "--tuning_rules") {
+                    tuning_rules_file = value;
+                } else if (key == "--progress") {
+                    progress = std::stoi(value);
+                } else if (key == "--trace") {
+                    trace_prefix = value;
+                } else if (key == "--seed") {
+                    seed = std::stoull(value);
+                } else if (key == "--hw_counters") {
+                    hw_counters = std::stoi(value);
+                } else if (key == "--status_socket") {
+                    status_socket = value;
                 } else if (key == "--logging") {
                     logging_flag = std::stoi(value);
                 } else {
@@ -140,7 +189,9 @@ int main(int argc, char** argv) {
 
     Dimacs dimacs;
     CSRGraph* graph;
-    NeighboursBranchingStrategy branching_strategy;
+    NeighboursBranchingStrategy neighbours_branching_strategy;
+    std::unique_ptr<RandomBranchingStrategy> random_branching_strategy;
+    BranchingStrategy* branching_strategy = &neighbours_branching_strategy;
     FastCliqueStrategy clique_strategy;
 
     // Light color strategy
@@ -155,18 +206,6 @@ int main(int argc, char** argv) {
     // Heavy color strategy
 
 
-    ColorStrategy* color_strategy_obj;
-    if (color_strategy == 0) {
-        color_strategy_obj = &greedy_color_strategy;
-    } else if (color_strategy == 1) {
-        color_strategy_obj = &mixed_color_strategy;
-    }
-    else if (color_strategy == 2) {
-        color_strategy_obj = &base_color_strategy;
-    } else {
-        color_strategy_obj = &another_mixed_color_strategy;
-    }
-
     // Initialize MPI with multithreading enabled
     int provided;
     MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
@@ -177,42 +216,359 @@ int main(int argc, char** argv) {
     int my_rank;
     MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
 
+    // Random streams: every rank derives its own from the seed of rank 0, drawn when not given
+    ThreadRandom::Seed(seed, my_rank);
+    uint64_t run_seed = ThreadRandom::GetSeed();
+    MPI_Bcast(&run_seed, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+    ThreadRandom::Seed(run_seed, my_rank);
+
+    // Portfolio: each group of ranks runs with its own strategies
+    std::vector<PortfolioConfig> portfolio;
+    std::vector<int> group_of_rank;
+    NodeSelection node_selection = NodeSelection::DEPTH;
+    if (!portfolio_file.empty()) {
+        int p;
+        MPI_Comm_size(MPI_COMM_WORLD, &p);
+        std::string error;
+        if (ReadPortfolio(portfolio_file, portfolio, error)) {
+            group_of_rank = AssignGroups(portfolio, p);
+            if (group_of_rank.empty()) {
+                error = "The groups of " + portfolio_file + " do not add up to " + std::to_string(p) + " ranks";
+            }
+        }
+        if (group_of_rank.empty()) {
+            if (my_rank == 0) {
+                std::cerr << "Error: " << error << "\n";
+            }
+            MPI_Finalize();
+            return 1;
+        }
+
+        const PortfolioConfig& config = portfolio[group_of_rank[my_rank]];
+        if (config.branching == "random") {
+            random_branching_strategy = config.seed != 0 ? std::make_unique<RandomBranchingStrategy>(config.seed)
+                                                         : std::make_unique<RandomBranchingStrategy>();
+            branching_strategy = random_branching_strategy.get();
+        }
+        color_strategy = config.color;
+        node_selection = config.selection;
+        if (config.seed != 0) {
+            ThreadRandom::Seed(config.seed, my_rank);
+        }
+    }
+
     // Output arguments
     if (my_rank == 0) {
         std::cout << "Reading file: " << file_name << "\n";
         std::cout << "Using timeout: " << timeout << " seconds\n";
         std::cout << "Using sol_gather_period: " << sol_gather_period << " seconds\n";
         std::cout << "Using balanced approach: " << balanced << "\n";
+        std::cout << "Using seed: " << run_seed << "\n";
     }
 
     // Read the Graph
+    double load_start_time = MPI_Wtime();
     std::string full_file_name = "graphs_instances/" + file_name; 
     // All processes read the graph, since they all start with it.
-    if (!dimacs.load(full_file_name.c_str())) {
+    graph = CSRGraph::LoadFromDimacs(full_file_name, dimacs);
+    if (graph == nullptr) {
         std::cout << dimacs.getError() << std::endl;
         return 1;
     }
-    graph = CSRGraph::LoadFromDimacs(full_file_name);
+    double load_time = MPI_Wtime() - load_start_time;
     std::cout << "Rank " << my_rank << ": Successfully read Graph " << file_name << std::endl;
 
-    BranchNBoundPar solver(branching_strategy, clique_strategy, *color_strategy_obj, "logs/log_" + std::to_string(my_rank) + ".txt", logging_flag==1);
-    BalancedBranchNBoundPar balanced_solver(branching_strategy, clique_strategy, *color_strategy_obj, "logs/log_" + std::to_string(my_rank) + ".txt", logging_flag==1);
+    // Features of the instance, to pick the settings and, written with the results, to learn 
+    // the tuning rules from past runs
+    InstanceFeatures features;
+    bool extract_features = auto_tune == 1 || !json_output_file.empty();
+    if (extract_features && my_rank == 0) {
+        features = ExtractFeatures(dimacs, *graph);
+    }
+    TuningChoice tuning;
+    if (auto_tune == 1) {
+        StrategyTuner tuner;
+        std::string error;
+        if (!tuning_rules_file.empty() && !tuner.LoadRules(tuning_rules_file, error)) {
+            if (my_rank == 0) std::cerr << "Error: " << error << std::endl;
+            MPI_Finalize();
+            return 1;
+        }
+        // rank 0 chooses, the clique heuristic is randomized and every rank has to agree
+        if (my_rank == 0) {
+            TuningChoice defaults;
+            defaults.color_strategy = color_strategy;
+            defaults.balanced = balanced;
+            defaults.sol_gather_period = sol_gather_period;
+            tuning = tuner.Choose(features, defaults);
+        }
+        int settings[3] = {tuning.color_strategy, tuning.balanced, tuning.sol_gather_period};
+        MPI_Bcast(settings, 3, MPI_INT, 0, MPI_COMM_WORLD);
+        // the groups of a portfolio keep their own color strategy
+        if (portfolio.empty()) {
+            color_strategy = settings[0];
+        }
+        balanced = settings[1];
+        sol_gather_period = settings[2];
+        if (my_rank == 0) {
+            std::cout << "Auto-tuning: color_strategy " << color_strategy << ", balanced " << balanced 
+                      << ", sol_gather_period " << sol_gather_period << ", " << tuning.rationale << std::endl;
+        }
+    }
+
+    ColorStrategy* color_strategy_obj;
+    if (color_strategy == 0) {
+        color_strategy_obj = &greedy_color_strategy;
+    } else if (color_strategy == 1) {
+        color_strategy_obj = &mixed_color_strategy;
+    }
+    else if (color_strategy == 2) {
+        color_strategy_obj = &base_color_strategy;
+    } else {
+        color_strategy_obj = &another_mixed_color_strategy;
+    }
+
+    BranchNBoundPar solver(*branching_strategy, clique_strategy, *color_strategy_obj, "logs/log_" + std::to_string(my_rank) + ".bin", logging_flag==1);
+    BalancedBranchNBoundPar balanced_solver(*branching_strategy, clique_strategy, *color_strategy_obj, "logs/log_" + std::to_string(my_rank) + ".bin", logging_flag==1);
+    solver.SetSymmetryDepth(symmetry);
+    balanced_solver.SetSymmetryDepth(symmetry);
+    solver.SetDecisionMode(decision == 1);
+    balanced_solver.SetDecisionMode(decision == 1);
+    solver.SetSatBackend(sat_threshold, sat_gap, sat_conflicts);
+    balanced_solver.SetSatBackend(sat_threshold, sat_gap, sat_conflicts);
+    solver.SetNogoodLearning(nogoods, nogood_share);
+    balanced_solver.SetNogoodLearning(nogoods, nogood_share);
+    solver.SetPortfolio(group_of_rank);
+    balanced_solver.SetPortfolio(group_of_rank);
+    solver.SetNodeSelection(node_selection);
+    balanced_solver.SetNodeSelection(node_selection);
+    solver.SetProgressEstimation(progress == 1);
+    balanced_solver.SetProgressEstimation(progress == 1);
+
+    // live status of the search, served by rank 0
+    StatusServer status_server;
+    if (!status_socket.empty()) {
+        std::string error;
+        bool serving = my_rank == 0 && status_server.Start(status_socket, error);
+        if (my_rank == 0 && !serving) {
+            std::cerr << "Warning: " << error << ", running without the status socket" << std::endl;
+        }
+        solver.SetStatusReporting(true, serving ? &status_server : nullptr);
+        balanced_solver.SetStatusReporting(true, serving ? &status_server : nullptr);
+    }
+
+    // Every process reads the initial coloring, so that all of them start with the same incumbent
+    unsigned short initial_ub = USHRT_MAX;
+    if (!initial_coloring_file.empty()) {
+        std::vector<unsigned short> initial_coloring;
+        std::string error;
+        if (!ReadColoring(initial_coloring_file, initial_coloring, error)) {
+            if (my_rank == 0) std::cerr << "Error: " << error << std::endl;
+            MPI_Finalize();
+            return 1;
+        }
+        initial_coloring.resize(graph->GetFullColoring().size(), 0);
+        if (!VerifyColoring(*graph, initial_coloring)) {
+            if (my_rank == 0) std::cerr << "Error: " << initial_coloring_file << " is not a valid coloring of " << file_name << std::endl;
+            MPI_Finalize();
+            return 1;
+        }
+        solver.SetInitialColoring(initial_coloring);
+        balanced_solver.SetInitialColoring(initial_coloring);
+        initial_ub = *std::max_element(initial_coloring.begin(), initial_coloring.end());
+    }
 
 
     // Start the timer.
     auto start_time = MPI_Wtime();
+
+    // Look the graph up in the result cache. Rank 0 reads the entry and broadcasts it,
+    // so that all processes agree even if another job rewrites it meanwhile.
+    uint64_t fingerprint = 0;
+    CacheEntry cached;
+    // 0: miss, 1: known bounds and coloring, 2: chromatic number already known
+    int cache_status = 0;
+    // proven lower bound on the chromatic number, ends the search once reached
+    unsigned short known_lb = 0;
+    if (!cache_dir.empty()) {
+        fingerprint = GraphFingerprint(*graph);
+        size_t coloring_size = graph->GetFullColoring().size();
+        if (my_rank == 0 && ResultCache(cache_dir).Lookup(fingerprint, cached)) {
+            cached.coloring.resize(coloring_size, 0);
+            if (VerifyColoring(*graph, cached.coloring)) {
+                cache_status = cached.optimal ? 2 : 1;
+            } else {
+                std::cerr << "Warning: ignoring cache entry " << FingerprintToString(fingerprint) 
+                          << ", its coloring is not valid" << std::endl;
+            }
+        }
+
+        int cache_info[3] = {cache_status, cached.lower_bound, cached.upper_bound};
+        MPI_Bcast(cache_info, 3, MPI_INT, 0, MPI_COMM_WORLD);
+        cache_status = cache_info[0];
+        cached.lower_bound = cache_info[1];
+        cached.upper_bound = cache_info[2];
+        if (cache_status != 0) {
+            cached.coloring.resize(coloring_size, 0);
+            MPI_Bcast(cached.coloring.data(), coloring_size, MPI_UNSIGNED_SHORT, 0, MPI_COMM_WORLD);
+        }
+
+        if (cache_status == 1) {
+            if (cached.upper_bound < initial_ub) {
+                solver.SetInitialColoring(cached.coloring);
+                balanced_solver.SetInitialColoring(cached.coloring);
+            }
+            known_lb = cached.lower_bound;
+        }
+        if (my_rank == 0) {
+            std::cout << "Cache entry " << FingerprintToString(fingerprint) << ": "
+                      << (cache_status == 2 ? "solved" : cache_status == 1 ? "bounds " + std::to_string(cached.lower_bound) + 
+                          ".." + std::to_string(cached.upper_bound) : "miss") << std::endl;
+        }
+    }
+
+    if (hw_counters == 1 && !HardwareCounters::Enable(true) && my_rank == 0) {
+        std::cerr << "Warning: hardware counters are not available (perf_event_open), running without them" << std::endl;
+    }
+
+    // the statistics only cover the search, not the loading
+    SolverStats::Reset();
+    if (!trace_prefix.empty()) {
+        TimelineTrace::Start(MPI_COMM_WORLD);
+    }
+
     // Run.
     double optimum_time;    
     int chromatic_number;
-    if (balanced) {
-        chromatic_number = balanced_solver.Solve(*graph, optimum_time, timeout-0.05, sol_gather_period,  expected_chromatic_number);
+    // whether chromatic_number is proven, not only reached (rank 0 only)
+    bool proven = true;
+    if (cache_status == 2) {
+        graph->SetFullColoring(cached.coloring);
+        chromatic_number = cached.upper_bound;
+        optimum_time = MPI_Wtime() - start_time;
     } else {
-        chromatic_number = solver.Solve(*graph, optimum_time, timeout-0.05, sol_gather_period, expected_chromatic_number);
+        // Preprocessing: vertices which can be colored after the search are removed
+        CSRGraph* graph_to_solve = graph;
+        std::unique_ptr<CSRGraph> reduced_graph;
+        std::unique_ptr<GraphReducer> reducer;
+        int root_lb = 0;
+        if (reduce) {
+            // the clique heuristic is randomized: rank 0 decides, so all processes reduce the same way
+            if (my_rank == 0) root_lb = clique_strategy.FindClique(*graph);
+            MPI_Bcast(&root_lb, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+            reduced_graph = std::make_unique<CSRGraph>(*graph);
+            reducer = std::make_unique<GraphReducer>(*reduced_graph);
+            reducer->Reduce(root_lb);
+            graph_to_solve = reduced_graph.get();
+            known_lb = std::max<int>(known_lb, root_lb);
+            if (my_rank == 0) {
+                std::cout << "Reduction (lb = " << root_lb << ") removed " << reducer->GetNumRemoved() 
+                          << " of " << graph->GetNumVertices() << " vertices" << std::endl;
+            }
+        }
+        // chi is the maximum over the connected components: they are solved one after the
+        // other (hardest first) by all processes, and each one only needs to be colored
+        // with the colors already needed by the previous ones
+        std::vector<std::vector<int>> components = ConnectedComponents(*graph_to_solve);
+        if (my_rank == 0 && components.size() > 1) {
+            std::cout << "Solving " << components.size() << " connected components separately" << std::endl;
+        }
+
+        std::vector<unsigned short> coloring(graph_to_solve->GetFullColoring().size(), 0);
+        bool timed_out = false;
+        chromatic_number = 0;
+        for (const std::vector<int>& component_vertices : components) {
+            std::unique_ptr<CSRGraph> component_owner;
+            CSRGraph* component = graph_to_solve;
+            if (components.size() > 1) {
+                component_owner = graph_to_solve->InducedSubgraph(component_vertices);
+                component = component_owner.get();
+            }
+
+            unsigned short component_lb = std::max<int>(known_lb, chromatic_number);
+            solver.SetKnownLowerBound(component_lb);
+            balanced_solver.SetKnownLowerBound(component_lb);
+
+            int component_chi;
+            // measured on rank 0 only, so that all ranks take the same branch: Solve is collective
+            double remaining_time = timeout - 0.05 - (MPI_Wtime() - start_time);
+            MPI_Bcast(&remaining_time, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+            if (remaining_time < 1) {
+                // no time left for a search, a heuristic coloring keeps the result valid
+                unsigned short ub;
+                color_strategy_obj->Color(*component, ub);
+                component_chi = ub;
+                timed_out = true;
+                proven = false;
+            } else {
+                double component_time;
+                if (balanced) {
+                    component_chi = balanced_solver.Solve(*component, component_time, (int) remaining_time, sol_gather_period, expected_chromatic_number);
+                } else {
+                    component_chi = solver.Solve(*component, component_time, (int) remaining_time, sol_gather_period, expected_chromatic_number);
+                }
+                timed_out = timed_out || component_time == -1;
+                // on rank 0, reaching the expected chromatic number proves nothing
+                SolveOutcome outcome = balanced ? balanced_solver.GetOutcome() : solver.GetOutcome();
+                proven = proven && outcome == SolveOutcome::PROVEN;
+
+                if (!portfolio.empty() && my_rank == 0) {
+                    int incumbent_rank = balanced ? balanced_solver.GetIncumbentRank() : solver.GetIncumbentRank();
+                    int proof_group = balanced ? balanced_solver.GetProofGroup() : solver.GetProofGroup();
+                    std::cout << "Portfolio: incumbent from ";
+                    if (incumbent_rank == -1) {
+                        std::cout << "the initial coloring";
+                    } else {
+                        int group = group_of_rank[incumbent_rank];
+                        std::cout << "group " << group << " (" << portfolio[group].description << ")";
+                    }
+                    std::cout << ", optimality ";
+                    if (proof_group != -1) {
+                        std::cout << "proven by group " << proof_group << " (" << portfolio[proof_group].description << ")";
+                    } else if (component_time != -1) {
+                        std::cout << "reached by a bound";
+                    } else {
+                        std::cout << "not proven (timeout)";
+                    }
+                    std::cout << std::endl;
+                }
+            }
+            // rank 0 holds the coloring, so its result is the one used for the next bounds
+            MPI_Bcast(&component_chi, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+            for (int vertex : component_vertices) {
+                coloring[vertex] = component->GetColor(vertex);
+            }
+            chromatic_number = std::max(chromatic_number, component_chi);
+        }
+        graph_to_solve->SetFullColoring(coloring);
+        optimum_time = timed_out ? -1 : MPI_Wtime() - start_time;
+
+        // Color the removed vertices, the reduced graph needs at least root_lb colors anyway
+        if (reducer) {
+            std::vector<unsigned short> coloring = graph_to_solve->GetFullColoring();
+            coloring.resize(graph->GetFullColoring().size(), 0);
+            reducer->RestoreColoring(coloring);
+            graph->SetFullColoring(coloring);
+            chromatic_number = std::max(chromatic_number, root_lb);
+        }
     }
     // Stop the timer.
     auto end_time = MPI_Wtime();
     auto time = end_time - start_time;
 
+    // counters and phase times of all the processes
+    StatsReport stats = SolverStats::Reduce(MPI_COMM_WORLD);
+
+    // timeline of every rank, merged by merge_traces.py
+    if (!trace_prefix.empty()) {
+        std::string trace_file = trace_prefix + "." + std::to_string(my_rank) + ".json";
+        if (!TimelineTrace::Write(trace_file)) {
+            std::cerr << "Error: cannot write the trace " << trace_file << std::endl;
+        }
+    }
+
     // Output results
     if (my_rank == 0) {
         std::cout << "Execution took " << time << " seconds." << std::endl;
@@ -221,49 +577,106 @@ int main(int argc, char** argv) {
         else
             std::cout << "Solve() finished prematurely measuring " << optimum_time << " seconds. " << std::endl;
         
-        if ( !CheckColoring(*graph) ) {
+        double verify_start_time = MPI_Wtime();
+        bool valid_coloring = VerifyColoring(*graph, graph->GetFullColoring());
+        double verify_time = MPI_Wtime() - verify_start_time;
+        if ( !valid_coloring ) {
             std::cout << "Coloring is not valid!" << std::endl;
         }
 
+        auto counter = [&stats](StatCounter c) { return stats.counters[static_cast<size_t>(c)]; };
+        std::cout << "Stats: " << counter(StatCounter::NODES_PROCESSED) << " nodes processed, pruned " 
+                  << counter(StatCounter::PRUNED_BOUNDS) << " by lb == ub, " << counter(StatCounter::PRUNED_BEST) 
+                  << " by lb >= best_ub, " << counter(StatCounter::PRUNED_EXPECTED) << " by the expected chi; "
+                  << counter(StatCounter::STEALS_SENT) << " nodes stolen, " << counter(StatCounter::BYTES_SENT) 
+                  << " bytes sent, " << counter(StatCounter::CLONES) << " clones" << std::endl;
+        std::cout << "Phase times (s, all ranks / slowest rank):";
+        for (size_t i = 0; i < NUM_STAT_PHASES; i++) {
+            std::cout << (i == 0 ? " " : ", ") << SolverStats::Name(static_cast<StatPhase>(i)) << " " 
+                      << stats.seconds[i] << " / " << stats.max_rank_seconds[i];
+        }
+        std::cout << std::endl;
+        if (stats.HasHardwareEvents()) {
+            std::cout << "Hardware counters (IPC, LLC misses / branch misses per node):";
+            for (size_t i = 0; i < NUM_STAT_PHASES; i++) {
+                StatPhase phase = static_cast<StatPhase>(i);
+                std::cout << (i == 0 ? " " : ", ") << SolverStats::Name(phase) << " " << stats.Ipc(phase) << " "
+                          << stats.PerNode(phase, HardwareEvent::LLC_MISSES) << " / "
+                          << stats.PerNode(phase, HardwareEvent::BRANCH_MISSES);
+            }
+            std::cout << std::endl;
+        }
+
         // Compare with expected chromatic number
         if (chromatic_number != expected_chromatic_number) 
             std::cout << "Failed: expected " << expected_chromatic_number << " but got " << chromatic_number << std::endl;
         else 
             std::cout << "Suceeded: Chromatic number: " << chromatic_number << std::endl;
-        
-            std::ofstream out(output_file);
-            out << "problem_instance_file_name "    << file_name << std::endl;
-            out << "cmd line "                      << std::endl;
-            out << "solver version "                << std::endl;
-            out << "number_of_vertices "            << graph->GetNumVertices() << std::endl;
-            out << "number_of_edges: "              << graph->GetNumEdges() << std::endl;
-            out << "time_limit_sec "                << timeout << std::endl;
-            int n_proc;
-            MPI_Comm_size(MPI_COMM_WORLD, &n_proc);
-            out << "number_of_worker_processes "    << n_proc << std::endl;
-            out << "number_of_cores_per_worker "    << 4 << std::endl;
-            if ( optimum_time == -1 ) {
-                out << "wall_time_sec "             << "> 10000" << std::endl;
-                out << "is_within_time_limit "      << false << std::endl;
-            } else {
-                out << "wall_time_sec "             << optimum_time << std::endl;
-                out << "is_within_time_limit "      << true << std::endl;
-            }
 
-            std::vector<unsigned short> colors = graph->GetFullColoring();
-            unsigned max_color = 0;
-            for ( int color : colors ) {
-                if ( color > max_color ) {
-                    max_color = color;
-                }
-            }
+        std::string command_line = argv[0];
+        for (int i = 1; i < argc; ++i) {
+            command_line += " ";
+            command_line += argv[i];
+        }
+        int n_proc;
+        MPI_Comm_size(MPI_COMM_WORLD, &n_proc);
 
-            out << "number_of_colors "              << max_color << std::endl;
-            std::vector<int> vertices = graph->GetVertices();
-            for ( int vertex : vertices ) {
-                out << vertex << " " << colors[vertex] << std::endl;
+        ResultWriter writer(file_name);
+        writer.SetCommandLine(command_line);
+        writer.SetGraphSize(graph->GetNumVertices(), graph->GetNumEdges());
+        writer.SetTimeLimit(timeout);
+        writer.SetResources(n_proc, 4);
+        writer.SetWallTime(optimum_time);
+        writer.SetColoring(graph->GetVertices(), graph->GetFullColoring());
+        writer.AddTiming("load", load_time);
+        writer.AddTiming("solve", time);
+        writer.AddTiming("verify", verify_time);
+        writer.AddCounter("chromatic_number", chromatic_number);
+        writer.AddCounter("expected_chromatic_number", expected_chromatic_number);
+        writer.AddCounter("valid_coloring", valid_coloring);
+        writer.AddCounter("seed", (long long) run_seed);
+        if (!cache_dir.empty()) {
+            writer.AddCounter("cache_status", cache_status);
+        }
+        if (extract_features) {
+            for (const auto& [name, value] : NamedFeatures(features)) {
+                writer.AddFeature(name, value);
             }
+        }
+        if (progress == 1) {
+            // estimates of the last component solved
+            ProgressEstimate estimate = balanced ? balanced_solver.GetProgressEstimate() : solver.GetProgressEstimate();
+            writer.AddCounter("nodes_explored", estimate.explored);
+            writer.AddCounter("estimated_tree_size", (long long) estimate.tree_size);
+            writer.AddCounter("estimated_nodes_left", (long long) estimate.remaining);
+        }
+        for (const auto& [name, value] : stats.Named()) {
+            writer.AddStatistic(name, value);
+        }
+        if (auto_tune == 1) {
+            writer.SetTuning(color_strategy, balanced, sol_gather_period, tuning.rule, tuning.rationale);
+        }
 
+        if ( !writer.WriteText(output_file) ) {
+            std::cerr << "Error: Could not write " << output_file << std::endl;
+        }
+        if ( !json_output_file.empty() && !writer.WriteJson(json_output_file) ) {
+            std::cerr << "Error: Could not write " << json_output_file << std::endl;
+        }
+
+        // Update the cache with what this run found out
+        if ( !cache_dir.empty() && cache_status != 2 && valid_coloring ) {
+            CacheEntry result;
+            result.upper_bound = writer.GetNumberOfColors();
+            result.coloring = graph->GetFullColoring();
+            // stopping at expected_chi.txt proves nothing, a wrong entry must not be cached as solved
+            unsigned short lower_bound = std::max<int>(known_lb, clique_strategy.FindClique(*graph));
+            result.optimal = proven || result.upper_bound <= lower_bound;
+            result.lower_bound = result.optimal ? result.upper_bound : lower_bound;
+            if ( !ResultCache(cache_dir).Store(fingerprint, file_name, result) ) {
+                std::cerr << "Error: Could not update the cache in " << cache_dir << std::endl;
+            }
+        }
     }
 
 
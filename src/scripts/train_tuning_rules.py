@@ -0,0 +1,127 @@
+"""
+Learns a tuning rule table for run_instance --auto_tune=1 --tuning_rules=<file> from past runs.
+
+Usage: python3 train_tuning_rules.py <result.json>... > tuning_rules.txt
+
+Each file is the --json_output of a run_instance run, which carries the features of the
+instance. For every instance, the fastest run that found the expected chromatic number
+gives the best settings. A decision list is then learnt greedily: the rule (one or two
+threshold conditions on the features) that covers the most instances still uncovered,
+all with the same best settings, is appended until no rule covers at least two of them.
+The instances left fall back to their most common settings.
+"""
+import json
+import sys
+from collections import Counter
+
+# settings of run_instance when not given on the command line
+DEFAULTS = {"color": 0, "balanced": 1, "period": 10}
+FLAGS = {"--color_strategy": "color", "--balanced": "balanced", "--sol_gather_period": "period"}
+
+
+def settings_of(run):
+    if "tuning" in run:
+        tuning = run["tuning"]
+        return (tuning["color_strategy"], tuning["balanced"], tuning["sol_gather_period"])
+    settings = dict(DEFAULTS)
+    for word in run["cmd_line"].split():
+        key, _, value = word.partition("=")
+        if key in FLAGS:
+            settings[FLAGS[key]] = int(value)
+    return (settings["color"], settings["balanced"], settings["period"])
+
+
+def load_best_runs(file_names):
+    """instance -> (wall time, settings, features) of its fastest successful run"""
+    best = {}
+    for file_name in file_names:
+        with open(file_name) as f:
+            run = json.load(f)
+        counters = run["counters"]
+        if not run.get("features") or run["wall_time_sec"] is None:
+            continue
+        if not counters.get("valid_coloring") or \
+           counters.get("chromatic_number") != counters.get("expected_chromatic_number"):
+            continue
+        name = run["problem_instance_file_name"]
+        if name not in best or run["wall_time_sec"] < best[name][0]:
+            best[name] = (run["wall_time_sec"], settings_of(run), run["features"])
+    return best
+
+
+def candidate_conditions(examples):
+    conditions = []
+    features = sorted(set(key for _, _, values in examples for key in values))
+    for feature in features:
+        values = sorted(set(example[feature] for _, _, example in examples))
+        for low, high in zip(values, values[1:]):
+            threshold = float("%.4g" % ((low + high) / 2))
+            conditions.append((feature, "<", threshold))
+            conditions.append((feature, ">", threshold))
+    return conditions
+
+
+def holds(features, condition):
+    feature, op, threshold = condition
+    return features[feature] < threshold if op == "<" else features[feature] > threshold
+
+
+def best_rule(remaining, conditions):
+    """the pure rule with the largest coverage, ties broken by fewer conditions"""
+    best = None
+    for first in conditions:
+        covered = [example for example in remaining if holds(example[2], first)]
+        if not covered:
+            continue
+        candidates = [((first,), covered)]
+        if len(set(settings for _, settings, _ in covered)) > 1:
+            for second in conditions:
+                if second[0] != first[0]:
+                    candidates.append(((first, second), [e for e in covered if holds(e[2], second)]))
+        for rule, rule_covered in candidates:
+            if len(set(settings for _, settings, _ in rule_covered)) != 1:
+                continue
+            score = (len(rule_covered), -len(rule))
+            if best is None or score > best[0]:
+                best = (score, rule, rule_covered)
+    return best
+
+
+def format_rule(conditions, settings, reason):
+    text = ""
+    if conditions:
+        text = "when " + " ".join("%s%s%g" % condition for condition in conditions) + " "
+    color, balanced, period = settings
+    return "%suse color=%d balanced=%d period=%d because %s" % (text, color, balanced, period, reason)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+
+    best = load_best_runs(sys.argv[1:])
+    if not best:
+        print("No successful run with features among the given files", file=sys.stderr)
+        return 1
+    examples = [(name, settings, features) for name, (_, settings, features) in sorted(best.items())]
+
+    print("# learnt by train_tuning_rules.py from the fastest runs of %d instances" % len(examples))
+    conditions = candidate_conditions(examples)
+    remaining = examples
+    while remaining:
+        found = best_rule(remaining, conditions)
+        if found is None or len(found[2]) < 2:
+            break
+        _, rule, covered = found
+        names = ", ".join(name for name, _, _ in covered)
+        print(format_rule(rule, covered[0][1], "fastest on %d past instances (%s)" % (len(covered), names)))
+        remaining = [example for example in remaining if example not in covered]
+
+    fallback = Counter(settings for _, settings, _ in (remaining or examples)).most_common(1)[0][0]
+    print(format_rule((), fallback, "most common best settings of the other past instances"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,135 @@
+#include "hardware_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+std::atomic<bool> HardwareCounters::_enabled{false};
+
+namespace {
+
+#ifdef __linux__
+
+struct CounterGroup {
+    bool opened = false;
+    int leader = -1;
+    // fds of the events that could be opened and their events, in the order of the group
+    int fds[NUM_HARDWARE_EVENTS];
+    size_t events[NUM_HARDWARE_EVENTS];
+    size_t size = 0;
+
+    ~CounterGroup() {
+        for ( size_t i = 0; i < size; i++ ) {
+            close(fds[i]);
+        }
+    }
+
+    void Open() {
+        opened = true;
+        const uint64_t configs[NUM_HARDWARE_EVENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        };
+        for ( size_t event = 0; event < NUM_HARDWARE_EVENTS; event++ ) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[event];
+            attr.disabled = leader == -1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // this thread, on any cpu
+            int fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+            if ( fd == -1 ) {
+                continue;
+            }
+            if ( leader == -1 ) {
+                leader = fd;
+            }
+            fds[size] = fd;
+            events[size] = event;
+            size++;
+        }
+        if ( leader != -1 ) {
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+};
+
+thread_local CounterGroup group;
+
+#endif
+
+}
+
+bool HardwareCounters::Enable(bool enable)
+{
+    if ( enable ) {
+        HardwareSample sample;
+        enable = Read(sample);
+    }
+    _enabled.store(enable);
+    return enable;
+}
+
+bool HardwareCounters::Read(HardwareSample& sample)
+{
+    sample = HardwareSample();
+#ifdef __linux__
+    if ( !group.opened ) {
+        group.Open();
+    }
+    if ( group.leader == -1 ) {
+        return false;
+    }
+    // number of events, time enabled, time running, then the values
+    uint64_t buffer[3 + NUM_HARDWARE_EVENTS];
+    if ( read(group.leader, buffer, sizeof(buffer)) < (ssize_t) ((3 + group.size) * sizeof(uint64_t)) ) {
+        return false;
+    }
+    sample.enabled = buffer[1];
+    sample.running = buffer[2];
+    for ( size_t i = 0; i < group.size && i < buffer[0]; i++ ) {
+        sample.values[group.events[i]] = buffer[3 + i];
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool HardwareCounters::Delta(const HardwareSample& start, const HardwareSample& end, HardwareValues& delta)
+{
+    delta.fill(0);
+    // the raw values and times only grow, their differences cannot wrap around
+    if ( end.running <= start.running || end.enabled < start.enabled ) {
+        return false;
+    }
+    uint64_t enabled = end.enabled - start.enabled, running = end.running - start.running;
+    for ( size_t i = 0; i < NUM_HARDWARE_EVENTS; i++ ) {
+        uint64_t value = end.values[i] >= start.values[i] ? end.values[i] - start.values[i] : 0;
+        if ( running < enabled ) {
+            value = (uint64_t) ((double) value * enabled / running);
+        }
+        delta[i] = value;
+    }
+    return true;
+}
+
+const char* HardwareCounters::Name(HardwareEvent event)
+{
+    switch ( event ) {
+        case HardwareEvent::CYCLES:         return "cycles";
+        case HardwareEvent::INSTRUCTIONS:   return "instructions";
+        case HardwareEvent::LLC_MISSES:     return "llc_misses";
+        case HardwareEvent::BRANCH_MISSES:  return "branch_misses";
+        default:                            return "unknown";
+    }
+}
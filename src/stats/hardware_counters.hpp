@@ -0,0 +1,74 @@
+#ifndef HARDWARE_COUNTERS_HPP
+#define HARDWARE_COUNTERS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum class HardwareEvent {
+    CYCLES,             // core cycles
+    INSTRUCTIONS,       // instructions retired
+    LLC_MISSES,         // last level cache misses
+    BRANCH_MISSES,      // mispredicted branches
+    COUNT
+};
+
+constexpr size_t NUM_HARDWARE_EVENTS = static_cast<size_t>(HardwareEvent::COUNT);
+
+using HardwareValues = std::array<uint64_t, NUM_HARDWARE_EVENTS>;
+
+/**
+ * @brief raw values of the counters with the time their group was enabled and running (ns)
+ */
+struct HardwareSample {
+    HardwareValues values{};
+    uint64_t enabled = 0;
+    uint64_t running = 0;
+};
+
+/**
+ * @brief hardware performance counters of the calling thread, with perf_event_open (Linux)
+ *
+ * @details every thread opens its own group of counters at its first Read, counting only
+ *          itself in user space (so that perf_event_paranoid up to 2 is enough). The counters
+ *          of a group are scheduled together, so their ratios (e.g. instructions per cycle)
+ *          are exact; when the kernel multiplexes the group with other ones the events of an
+ *          interval are scaled by the share of the interval it was counting (see Delta). <br>
+ *          A Read is a system call, about a microsecond: the counters are off unless
+ *          enabled, which makes a PhaseTimer cost two more reads. Events the processor
+ *          (or the virtual machine) does not provide read as 0.
+ */
+class HardwareCounters {
+    public:
+        static bool Enabled() { return _enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief turns the counters on or off for every thread
+         *
+         * @return false if the counters are not available, in which case they stay off
+         */
+        static bool Enable(bool enable);
+
+        /**
+         * @brief raw values counted by the calling thread since it opened its counters
+         *
+         * @return false if its counters could not be opened, the sample is then 0
+         */
+        static bool Read(HardwareSample& sample);
+
+        /**
+         * @brief events between two samples of the same thread: the raw difference scaled by
+         *        the time enabled over the time running in between
+         *
+         * @return false if the group did not run in between, the interval is then dropped
+         */
+        static bool Delta(const HardwareSample& start, const HardwareSample& end, HardwareValues& delta);
+
+        static const char* Name(HardwareEvent event);
+
+    private:
+        static std::atomic<bool> _enabled;
+};
+
+#endif // HARDWARE_COUNTERS_HPP
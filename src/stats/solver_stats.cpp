@@ -0,0 +1,180 @@
+#include "solver_stats.hpp"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+namespace {
+
+// the counters of every thread that ever counted, a deque never moves them
+std::mutex registry_mutex;
+std::deque<ThreadStats> registry;
+
+// calibration of the ticks: their value and the time when it started
+uint64_t calibration_ticks = SolverStats::Ticks();
+std::chrono::steady_clock::time_point calibration_time = std::chrono::steady_clock::now();
+
+double SecondsPerTick() {
+    uint64_t ticks = SolverStats::Ticks() - calibration_ticks;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - calibration_time).count();
+    return ticks == 0 ? 0 : seconds / ticks;
+}
+
+}
+
+ThreadStats& SolverStats::Local()
+{
+    thread_local ThreadStats* local = nullptr;
+    thread_local ThreadStats discarded;
+    if ( !_counted ) {
+        return discarded;
+    }
+    if ( local == nullptr ) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        local = &registry.emplace_back();
+    }
+    return *local;
+}
+
+void SolverStats::Reset()
+{
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for ( ThreadStats& stats : registry ) {
+        stats = ThreadStats();
+    }
+    calibration_ticks = Ticks();
+    calibration_time = std::chrono::steady_clock::now();
+}
+
+StatsReport SolverStats::Collect()
+{
+    double seconds_per_tick = SecondsPerTick();
+    StatsReport report;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for ( const ThreadStats& stats : registry ) {
+        for ( size_t i = 0; i < NUM_STAT_COUNTERS; i++ ) {
+            report.counters[i] += stats.counters[i];
+        }
+        for ( size_t i = 0; i < NUM_STAT_PHASES; i++ ) {
+            report.calls[i] += stats.calls[i];
+            report.seconds[i] += stats.ticks[i] * seconds_per_tick;
+            for ( size_t j = 0; j < NUM_HARDWARE_EVENTS; j++ ) {
+                report.events[i][j] += stats.events[i][j];
+            }
+        }
+    }
+    report.max_rank_seconds = report.seconds;
+    return report;
+}
+
+StatsReport SolverStats::Reduce(MPI_Comm comm, int root)
+{
+    StatsReport local = Collect();
+    StatsReport total;
+    MPI_Reduce(local.counters.data(), total.counters.data(), NUM_STAT_COUNTERS, MPI_LONG_LONG, MPI_SUM, root, comm);
+    MPI_Reduce(local.calls.data(), total.calls.data(), NUM_STAT_PHASES, MPI_LONG_LONG, MPI_SUM, root, comm);
+    MPI_Reduce(local.seconds.data(), total.seconds.data(), NUM_STAT_PHASES, MPI_DOUBLE, MPI_SUM, root, comm);
+    MPI_Reduce(local.seconds.data(), total.max_rank_seconds.data(), NUM_STAT_PHASES, MPI_DOUBLE, MPI_MAX, root, comm);
+    MPI_Reduce(local.events.data(), total.events.data(), NUM_STAT_PHASES * NUM_HARDWARE_EVENTS, MPI_UINT64_T, MPI_SUM,
+               root, comm);
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    return rank == root ? total : local;
+}
+
+const char* SolverStats::Name(StatCounter counter)
+{
+    switch ( counter ) {
+        case StatCounter::NODES_PROCESSED:  return "nodes_processed";
+        case StatCounter::PRUNED_BOUNDS:    return "pruned_lb_eq_ub";
+        case StatCounter::PRUNED_BEST:      return "pruned_lb_ge_best";
+        case StatCounter::PRUNED_EXPECTED:  return "pruned_expected_chi";
+        case StatCounter::STEALS_SENT:      return "steals_sent";
+        case StatCounter::STEALS_RECEIVED:  return "steals_received";
+        case StatCounter::BYTES_SENT:       return "bytes_sent";
+        case StatCounter::BYTES_RECEIVED:   return "bytes_received";
+        case StatCounter::CLONES:           return "clones";
+        default:                            return "unknown";
+    }
+}
+
+const char* SolverStats::Name(StatPhase phase)
+{
+    switch ( phase ) {
+        case StatPhase::CLIQUE:     return "clique";
+        case StatPhase::COLOR:      return "color";
+        case StatPhase::RECOLOR:    return "recolor";
+        case StatPhase::BRANCHING:  return "branching";
+        case StatPhase::CLONE:      return "clone";
+        case StatPhase::SERIALIZE:  return "serialize";
+        case StatPhase::MPI:        return "mpi";
+        default:                    return "unknown";
+    }
+}
+
+bool StatsReport::HasHardwareEvents() const
+{
+    for ( const HardwareValues& phase_events : events ) {
+        if ( phase_events[static_cast<size_t>(HardwareEvent::CYCLES)] != 0 ||
+             phase_events[static_cast<size_t>(HardwareEvent::INSTRUCTIONS)] != 0 ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+HardwareValues StatsReport::SearchEvents() const
+{
+    HardwareValues search{};
+    for ( size_t i = 0; i < NUM_STAT_PHASES; i++ ) {
+        if ( static_cast<StatPhase>(i) == StatPhase::MPI ) {
+            continue;
+        }
+        for ( size_t j = 0; j < NUM_HARDWARE_EVENTS; j++ ) {
+            search[j] += events[i][j];
+        }
+    }
+    return search;
+}
+
+double StatsReport::Ipc(StatPhase phase) const
+{
+    const HardwareValues& phase_events = events[static_cast<size_t>(phase)];
+    uint64_t cycles = phase_events[static_cast<size_t>(HardwareEvent::CYCLES)];
+    return cycles == 0 ? 0 : (double) phase_events[static_cast<size_t>(HardwareEvent::INSTRUCTIONS)] / cycles;
+}
+
+double StatsReport::PerNode(StatPhase phase, HardwareEvent event) const
+{
+    long long nodes = counters[static_cast<size_t>(StatCounter::NODES_PROCESSED)];
+    return nodes == 0 ? 0 : (double) events[static_cast<size_t>(phase)][static_cast<size_t>(event)] / nodes;
+}
+
+std::vector<std::pair<std::string, double>> StatsReport::Named() const
+{
+    std::vector<std::pair<std::string, double>> named;
+    for ( size_t i = 0; i < NUM_STAT_COUNTERS; i++ ) {
+        named.emplace_back(SolverStats::Name(static_cast<StatCounter>(i)), counters[i]);
+    }
+    for ( size_t i = 0; i < NUM_STAT_PHASES; i++ ) {
+        std::string name = SolverStats::Name(static_cast<StatPhase>(i));
+        named.emplace_back(name + "_sec", seconds[i]);
+        named.emplace_back(name + "_max_rank_sec", max_rank_seconds[i]);
+        named.emplace_back(name + "_calls", calls[i]);
+    }
+    if ( HasHardwareEvents() ) {
+        for ( size_t i = 0; i < NUM_STAT_PHASES; i++ ) {
+            StatPhase phase = static_cast<StatPhase>(i);
+            std::string name = SolverStats::Name(phase);
+            for ( size_t j = 0; j < NUM_HARDWARE_EVENTS; j++ ) {
+                named.emplace_back(name + "_" + HardwareCounters::Name(static_cast<HardwareEvent>(j)), events[i][j]);
+            }
+            named.emplace_back(name + "_ipc", Ipc(phase));
+            for ( HardwareEvent miss : {HardwareEvent::LLC_MISSES, HardwareEvent::BRANCH_MISSES} ) {
+                named.emplace_back(name + "_" + HardwareCounters::Name(miss) + "_per_node", PerNode(phase, miss));
+            }
+        }
+    }
+    return named;
+}
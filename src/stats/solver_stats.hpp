@@ -0,0 +1,216 @@
+#ifndef SOLVER_STATS_HPP
+#define SOLVER_STATS_HPP
+
+#include <mpi.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "timeline_trace.hpp"
+#include "hardware_counters.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+enum class StatCounter {
+    NODES_PROCESSED,    // nodes taken from the queue by a worker
+    PRUNED_BOUNDS,      // nodes pruned because lb == ub
+    PRUNED_BEST,        // nodes pruned because lb >= best_ub
+    PRUNED_EXPECTED,    // nodes which reached the expected chromatic number (or the known lb)
+    STEALS_SENT,        // nodes given away to an idle rank
+    STEALS_RECEIVED,    // nodes received after a work request
+    BYTES_SENT,         // bytes of the branches sent
+    BYTES_RECEIVED,     // bytes of the branches received
+    CLONES,             // graphs cloned
+    COUNT
+};
+
+enum class StatPhase {
+    CLIQUE,             // clique heuristic
+    COLOR,              // coloring heuristics
+    RECOLOR,            // recoloring of the colorings found
+    BRANCHING,          // choice of the branching vertices
+    CLONE,              // graph clones
+    SERIALIZE,          // branch (de)serialization
+    MPI,                // waiting for the branches and work requests exchanged with the other ranks
+    COUNT
+};
+
+constexpr size_t NUM_STAT_COUNTERS = static_cast<size_t>(StatCounter::COUNT);
+constexpr size_t NUM_STAT_PHASES   = static_cast<size_t>(StatPhase::COUNT);
+
+/**
+ * @brief counters and timers of the current thread, written without any synchronization
+ */
+struct ThreadStats {
+    std::array<long long, NUM_STAT_COUNTERS> counters{};
+    std::array<long long, NUM_STAT_PHASES> calls{};
+    std::array<uint64_t, NUM_STAT_PHASES> ticks{};
+    std::array<HardwareValues, NUM_STAT_PHASES> events{};   // only with HardwareCounters enabled
+};
+
+/**
+ * @brief totals of a run
+ */
+struct StatsReport {
+    std::array<long long, NUM_STAT_COUNTERS> counters{};
+    std::array<long long, NUM_STAT_PHASES> calls{};
+    std::array<double, NUM_STAT_PHASES> seconds{};          // summed over the threads (and ranks)
+    std::array<double, NUM_STAT_PHASES> max_rank_seconds{}; // of the rank which spent the most
+    std::array<HardwareValues, NUM_STAT_PHASES> events{};   // summed over the threads (and ranks)
+
+    /**
+     * @brief whether the hardware counters were enabled (and available) during the run
+     */
+    bool HasHardwareEvents() const;
+
+    /**
+     * @brief hardware events of the search itself: all the phases but MPI waits
+     */
+    HardwareValues SearchEvents() const;
+
+    /**
+     * @brief instructions per cycle of a phase, 0 if it ran no cycle
+     */
+    double Ipc(StatPhase phase) const;
+
+    /**
+     * @brief event counted in a phase per node processed
+     */
+    double PerNode(StatPhase phase, HardwareEvent event) const;
+
+    /**
+     * @brief counters and timers as named values: "<counter>", "<phase>_sec",
+     *        "<phase>_max_rank_sec" and "<phase>_calls", and with the hardware counters
+     *        "<phase>_<event>", "<phase>_ipc" and "<phase>_<miss event>_per_node"
+     */
+    std::vector<std::pair<std::string, double>> Named() const;
+};
+
+/**
+ * @brief low overhead counters and phase timers of the solvers
+ *
+ * @details every thread owns its own counters, so counting is a plain increment and
+ *          timing a phase reads the time stamp counter twice, a few nanoseconds against
+ *          the microseconds (at least) of the timed phases. Ticks are converted into
+ *          seconds by comparing the time stamp counter with a steady clock over the run. <br>
+ *          The counters of all threads are summed by Collect and Reduce, which must not be
+ *          called while other threads are counting (e.g. after the parallel region).
+ */
+class SolverStats {
+    public:
+#if GCN_SOLVER_STATS
+        static inline void Count(StatCounter counter, long long amount = 1) {
+            Local().counters[static_cast<size_t>(counter)] += amount;
+        }
+#else
+        static inline void Count(StatCounter, long long = 1) {}
+#endif
+
+        static inline uint64_t Ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
+
+        /**
+         * @brief clears the counters of every thread and restarts the tick calibration
+         */
+        static void Reset();
+
+        /**
+         * @brief totals of the threads of this process
+         */
+        static StatsReport Collect();
+
+        /**
+         * @brief totals of all the processes of comm, with MPI_Reduce (collective)
+         *
+         * @return the totals on root, the local ones on the other ranks
+         */
+        static StatsReport Reduce(MPI_Comm comm, int root = 0);
+
+        static const char* Name(StatCounter counter);
+        static const char* Name(StatPhase phase);
+
+        /**
+         * @brief whether the calling thread counts: the probes of the progress estimator are not
+         *        part of the search, so its thread drops its counters and phase times
+         */
+        static void SetCounted(bool counted) { _counted = counted; }
+        static bool Counted() { return _counted; }
+
+        /**
+         * @brief counters of the calling thread, a scratch copy never collected if it does not count
+         */
+        static ThreadStats& Local();
+
+    private:
+        static inline thread_local bool _counted = true;
+};
+
+#if GCN_SOLVER_STATS
+/**
+ * @brief times the scope it lives in as the given phase, also a span of the timeline trace,
+ *        and counts its hardware events when HardwareCounters is enabled
+ */
+class PhaseTimer {
+    public:
+        explicit PhaseTimer(StatPhase phase)
+        : _phase{static_cast<size_t>(phase)}, _counting{HardwareCounters::Enabled() && SolverStats::Counted()}, _span{SolverStats::Name(phase)} {
+            if ( _counting ) {
+                HardwareCounters::Read(_start_sample);
+            }
+            _start = SolverStats::Ticks();
+        }
+        ~PhaseTimer() {
+            ThreadStats& stats = SolverStats::Local();
+            stats.ticks[_phase] += SolverStats::Ticks() - _start;
+            stats.calls[_phase]++;
+            if ( _counting ) {
+                HardwareSample end_sample;
+                HardwareValues events;
+                HardwareCounters::Read(end_sample);
+                if ( HardwareCounters::Delta(_start_sample, end_sample, events) ) {
+                    for ( size_t i = 0; i < NUM_HARDWARE_EVENTS; i++ ) {
+                        stats.events[_phase][i] += events[i];
+                    }
+                }
+            }
+        }
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    private:
+        size_t _phase;
+        bool _counting;
+        uint64_t _start;
+        HardwareSample _start_sample;
+        TraceSpan _span;
+};
+#else
+/**
+ * @brief only the span of the timeline trace, the statistics are compiled out
+ */
+class PhaseTimer {
+    public:
+        explicit PhaseTimer(StatPhase phase) : _span{SolverStats::Name(phase)} {}
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    private:
+        TraceSpan _span;
+};
+#endif
+
+#endif // SOLVER_STATS_HPP
@@ -0,0 +1,203 @@
+#include "status_server.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+// a client sending more than this without a newline is dropped
+constexpr size_t MAX_LINE = 1024;
+
+struct Client {
+    int fd;
+    std::string input;
+};
+
+bool SendAll(int fd, const std::string& text) {
+    size_t sent = 0;
+    while ( sent < text.size() ) {
+        ssize_t written = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+        if ( written <= 0 ) {
+            return false;
+        }
+        sent += written;
+    }
+    return true;
+}
+
+}
+
+StatusServer::~StatusServer()
+{
+    Stop();
+}
+
+bool StatusServer::Start(const std::string& path, std::string& error)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if ( path.empty() || path.size() >= sizeof(address.sun_path) ) {
+        error = "invalid socket path " + path;
+        return false;
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // the socket left by a run which did not stop cleanly is replaced, any other file is kept
+    struct stat existing;
+    if ( lstat(path.c_str(), &existing) == 0 ) {
+        if ( !S_ISSOCK(existing.st_mode) ) {
+            error = path + " exists and is not a socket";
+            return false;
+        }
+        unlink(path.c_str());
+    }
+
+    _listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( _listen_fd == -1 ) {
+        error = std::string("cannot create a socket: ") + std::strerror(errno);
+        return false;
+    }
+    if ( bind(_listen_fd, (sockaddr*) &address, sizeof(address)) == -1 || listen(_listen_fd, 8) == -1 ) {
+        error = "cannot listen on " + path + ": " + std::strerror(errno);
+        close(_listen_fd);
+        _listen_fd = -1;
+        return false;
+    }
+    _path = path;
+    _stop.store(false);
+    _thread = std::thread(&StatusServer::Serve, this);
+    return true;
+}
+
+void StatusServer::Stop()
+{
+    if ( _listen_fd == -1 ) {
+        return;
+    }
+    _stop.store(true);
+    if ( _thread.joinable() ) {
+        _thread.join();
+    }
+    close(_listen_fd);
+    _listen_fd = -1;
+    unlink(_path.c_str());
+}
+
+void StatusServer::Publish(const StatusSnapshot& snapshot)
+{
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    _snapshot = snapshot;
+}
+
+StatusSnapshot StatusServer::Snapshot()
+{
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    return _snapshot;
+}
+
+std::string StatusServer::Answer(const std::string& command)
+{
+    std::ostringstream answer;
+    if ( command == "status" ) {
+        StatusSnapshot snapshot = Snapshot();
+        long queued = 0;
+        for ( const RankStatus& rank : snapshot.ranks ) {
+            queued += rank.queue_size;
+        }
+        answer << "running " << snapshot.running << "\n"
+               << "elapsed " << snapshot.elapsed << "\n"
+               << "best_ub " << snapshot.best_ub << "\n"
+               << "global_lb " << snapshot.global_lb << "\n"
+               << "nodes " << snapshot.nodes << "\n"
+               << "nodes_per_second " << snapshot.nodes_per_second << "\n"
+               << "steals_per_second " << snapshot.steals_per_second << "\n"
+               << "queued " << queued << "\n"
+               << "ranks " << snapshot.ranks.size() << "\n";
+        if ( snapshot.estimated ) {
+            answer << "estimated_tree_size " << snapshot.progress.tree_size << "\n"
+                   << "estimated_nodes_left " << snapshot.progress.remaining << "\n";
+        }
+    } else if ( command == "ranks" ) {
+        StatusSnapshot snapshot = Snapshot();
+        for ( size_t i = 0; i < snapshot.ranks.size(); i++ ) {
+            const RankStatus& rank = snapshot.ranks[i];
+            answer << i << " " << rank.nodes << " " << rank.queue_size << " " << rank.steals << "\n";
+        }
+    } else if ( command == "help" ) {
+        answer << "status: bounds, throughput and estimates of the search\n"
+               << "ranks: <rank> <nodes> <queue_size> <steals> of every rank\n"
+               << "quit: closes the connection\n";
+    } else {
+        answer << "error unknown command " << command << "\n";
+    }
+    answer << "end\n";
+    return answer.str();
+}
+
+void StatusServer::Serve()
+{
+    std::vector<Client> clients;
+    while ( !_stop.load(std::memory_order_relaxed) ) {
+        std::vector<pollfd> fds;
+        fds.push_back({_listen_fd, POLLIN, 0});
+        for ( const Client& client : clients ) {
+            fds.push_back({client.fd, POLLIN, 0});
+        }
+        // wakes up every 100 ms to notice Stop
+        if ( poll(fds.data(), fds.size(), 100) <= 0 ) {
+            continue;
+        }
+
+        std::vector<Client> open_clients;
+        for ( size_t i = 0; i < clients.size(); i++ ) {
+            Client& client = clients[i];
+            bool open = true;
+            if ( fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR) ) {
+                char buffer[256];
+                ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+                open = received > 0;
+                if ( open ) {
+                    client.input.append(buffer, received);
+                }
+                size_t newline;
+                while ( open && (newline = client.input.find('\n')) != std::string::npos ) {
+                    std::string command = client.input.substr(0, newline);
+                    client.input.erase(0, newline + 1);
+                    if ( !command.empty() && command.back() == '\r' ) {
+                        command.pop_back();
+                    }
+                    if ( command == "quit" ) {
+                        open = false;
+                    } else if ( !command.empty() ) {
+                        open = SendAll(client.fd, Answer(command));
+                    }
+                }
+                open = open && client.input.size() <= MAX_LINE;
+            }
+            if ( open ) {
+                open_clients.push_back(std::move(client));
+            } else {
+                close(client.fd);
+            }
+        }
+        clients = std::move(open_clients);
+
+        if ( fds[0].revents & POLLIN ) {
+            int fd = accept(_listen_fd, nullptr, nullptr);
+            if ( fd != -1 ) {
+                clients.push_back({fd, ""});
+            }
+        }
+    }
+    for ( const Client& client : clients ) {
+        close(client.fd);
+    }
+}
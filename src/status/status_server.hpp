@@ -0,0 +1,98 @@
+#ifndef STATUS_SERVER_HPP
+#define STATUS_SERVER_HPP
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tree_estimator.hpp"
+
+/**
+ * @brief state of one rank at a gather
+ */
+struct RankStatus {
+    long nodes = 0;             // nodes processed since the start of the search
+    long queue_size = 0;        // nodes in its queue
+    long steals = 0;            // nodes it received after a work request
+};
+
+/**
+ * @brief state of a running search, assembled by rank 0 at every gather
+ */
+struct StatusSnapshot {
+    bool running = false;       // false before the first gather and after the search
+    double elapsed = 0;         // seconds since the start of the search
+    unsigned short best_ub = 0;
+    unsigned short global_lb = 0;
+    long nodes = 0;
+    double nodes_per_second = 0;    // since the previous gather
+    double steals_per_second = 0;   // since the previous gather
+    bool estimated = false;         // whether progress holds tree estimates (--progress)
+    ProgressEstimate progress;
+    std::vector<RankStatus> ranks;
+};
+
+/**
+ * @brief serves the last snapshot of the search on a Unix domain socket, to watch a long
+ *        run without logging (e.g. `nc -U <path>` or `socat - UNIX-CONNECT:<path>`)
+ *
+ * @details line based protocol, one command per line, every answer ends with a line "end": <br>
+ *          status: `<key> <value>` lines, elapsed, best_ub, global_lb, nodes, nodes_per_second,
+ *          steals_per_second, queued (sum over the ranks), ranks, and with the estimates
+ *          estimated_tree_size and estimated_nodes_left (-1 while unknown) <br>
+ *          ranks: a line `<rank> <nodes> <queue_size> <steals>` per rank <br>
+ *          help: the commands <br>
+ *          quit: closes the connection <br>
+ *          The snapshot is only as recent as the last gather (--sol_gather_period). A thread of
+ *          its own answers the clients, so the solver threads only pay for Publish.
+ */
+class StatusServer {
+    public:
+        StatusServer() = default;
+        ~StatusServer();
+
+        StatusServer(const StatusServer&) = delete;
+        StatusServer& operator=(const StatusServer&) = delete;
+
+        /**
+         * @brief listens on path, replacing a stale socket file, and starts answering
+         *
+         * @param error set when the socket cannot be created
+         * @return false if the socket cannot be created
+         */
+        bool Start(const std::string& path, std::string& error);
+
+        /**
+         * @brief stops answering, closes the connections and removes the socket file
+         */
+        void Stop();
+
+        /**
+         * @brief replaces the snapshot served
+         */
+        void Publish(const StatusSnapshot& snapshot);
+
+        /**
+         * @brief the snapshot served
+         */
+        StatusSnapshot Snapshot();
+
+        /**
+         * @brief answer to one command line, "end" terminated
+         */
+        std::string Answer(const std::string& command);
+
+    private:
+        std::string _path;
+        int _listen_fd = -1;
+        std::atomic<bool> _stop = false;
+        std::thread _thread;
+        std::mutex _snapshot_mutex;
+        StatusSnapshot _snapshot;
+
+        void Serve();
+};
+
+#endif // STATUS_SERVER_HPP
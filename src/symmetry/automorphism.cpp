@@ -0,0 +1,251 @@
+#include "automorphism.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+AutomorphismFinder::AutomorphismFinder(const Graph& graph, long node_budget)
+: _labels{graph.GetVertices()}, _budget{node_budget}
+{
+    _index.assign(graph.GetHighestVertex() + 1, -1);
+    for ( size_t i = 0; i < _labels.size(); i++ ) {
+        _index[_labels[i]] = i;
+    }
+
+    _adj.resize(_labels.size());
+    std::vector<int> neighbours;
+    for ( size_t i = 0; i < _labels.size(); i++ ) {
+        neighbours.clear();
+        graph.GetNeighbours(_labels[i], neighbours);
+        for ( int neighbour : neighbours ) {
+            _adj[i].push_back(_index[neighbour]);
+        }
+        std::sort(_adj[i].begin(), _adj[i].end());
+    }
+}
+
+void AutomorphismFinder::Refine(Partition& cells) const
+{
+    const size_t n = cells.size();
+    if ( n == 0 ) {
+        return;
+    }
+
+    int num_cells = *std::max_element(cells.begin(), cells.end()) + 1;
+    std::vector<std::vector<int>> signatures(n);
+    std::vector<int> order(n);
+
+    while ( num_cells < (int)n ) {
+        // the signature starts with the old cell, so that sorting refines the old partition
+        for ( size_t i = 0; i < n; i++ ) {
+            std::vector<int>& signature = signatures[i];
+            signature.clear();
+            signature.push_back(cells[i]);
+            for ( int neighbour : _adj[i] ) {
+                signature.push_back(cells[neighbour]);
+            }
+            std::sort(signature.begin() + 1, signature.end());
+        }
+
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&signatures](int a, int b) {
+            return signatures[a] < signatures[b];
+        });
+
+        int cell = 0;
+        cells[order[0]] = 0;
+        for ( size_t k = 1; k < n; k++ ) {
+            if ( signatures[order[k]] != signatures[order[k-1]] ) {
+                cell++;
+            }
+            cells[order[k]] = cell;
+        }
+
+        if ( cell + 1 == num_cells ) {
+            break;  // equitable
+        }
+        num_cells = cell + 1;
+    }
+}
+
+AutomorphismFinder::Partition AutomorphismFinder::Individualize(const Partition& cells, int x) const
+{
+    Partition result(cells.size());
+    for ( size_t i = 0; i < cells.size(); i++ ) {
+        bool after_x = cells[i] > cells[x] || ( cells[i] == cells[x] && (int)i != x );
+        result[i] = cells[i] + ( after_x ? 1 : 0 );
+    }
+    return result;
+}
+
+bool AutomorphismFinder::Search(const Partition& a, const Partition& b, std::vector<int>& perm)
+{
+    const size_t n = a.size();
+    std::vector<int> sizes_a(n, 0), sizes_b(n, 0);
+    for ( size_t i = 0; i < n; i++ ) {
+        sizes_a[a[i]]++;
+        sizes_b[b[i]]++;
+    }
+    if ( sizes_a != sizes_b ) {
+        return false;
+    }
+
+    auto target = std::find_if(sizes_a.begin(), sizes_a.end(), [](int size) { return size > 1; });
+    if ( target == sizes_a.end() ) {
+        // both partitions are discrete: the bijection maps cell to cell
+        std::vector<int> vertex_of_cell(n);
+        for ( size_t i = 0; i < n; i++ ) {
+            vertex_of_cell[b[i]] = i;
+        }
+        perm.resize(n);
+        for ( size_t i = 0; i < n; i++ ) {
+            perm[i] = vertex_of_cell[a[i]];
+        }
+        return IsAutomorphism(perm);
+    }
+
+    int target_cell = target - sizes_a.begin();
+    int x = std::find(a.begin(), a.end(), target_cell) - a.begin();
+    Partition next_a = Individualize(a, x);
+    Refine(next_a);
+
+    for ( size_t y = 0; y < n; y++ ) {
+        if ( b[y] != target_cell ) {
+            continue;
+        }
+        if ( _budget-- <= 0 ) {
+            return false;
+        }
+        Partition next_b = Individualize(b, y);
+        Refine(next_b);
+        if ( Search(next_a, next_b, perm) ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool AutomorphismFinder::IsAutomorphism(const std::vector<int>& perm) const
+{
+    for ( size_t i = 0; i < _adj.size(); i++ ) {
+        const std::vector<int>& image_row = _adj[perm[i]];
+        if ( _adj[i].size() != image_row.size() ) {
+            return false;
+        }
+        for ( int neighbour : _adj[i] ) {
+            if ( !std::binary_search(image_row.begin(), image_row.end(), perm[neighbour]) ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+AutomorphismFinder::Partition AutomorphismFinder::FixedPartition(const std::vector<int>& fixed) const
+{
+    Partition cells(_labels.size(), 0);
+    Refine(cells);
+    for ( int x : fixed ) {
+        cells = Individualize(cells, x);
+        Refine(cells);
+    }
+    return cells;
+}
+
+int AutomorphismFinder::Find(std::vector<int>& parent, int i)
+{
+    while ( parent[i] != i ) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void AutomorphismFinder::Join(std::vector<int>& parent, const std::vector<int>& perm)
+{
+    for ( size_t i = 0; i < perm.size(); i++ ) {
+        int root_i = Find(parent, i), root_image = Find(parent, perm[i]);
+        if ( root_i != root_image ) {
+            parent[std::max(root_i, root_image)] = std::min(root_i, root_image);
+        }
+    }
+}
+
+std::vector<std::vector<int>> AutomorphismFinder::Orbits()
+{
+    const size_t n = _labels.size();
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    Partition base = FixedPartition({});
+    // vertices of each cell known to lie in different orbits
+    std::vector<std::vector<int>> representatives(n);
+    std::vector<int> perm;
+    for ( size_t i = 0; i < n; i++ ) {
+        bool joined = false;
+        for ( int r : representatives[base[i]] ) {
+            if ( Find(parent, r) == Find(parent, i) ) {
+                joined = true;
+                break;
+            }
+            if ( _budget <= 0 ) {
+                continue;
+            }
+            Partition a = Individualize(base, r), b = Individualize(base, i);
+            Refine(a);
+            Refine(b);
+            if ( Search(a, b, perm) ) {
+                _num_automorphisms++;
+                Join(parent, perm);
+                joined = true;
+                break;
+            }
+        }
+        if ( !joined ) {
+            representatives[base[i]].push_back(i);
+        }
+    }
+
+    std::vector<std::vector<int>> orbits;
+    std::vector<int> orbit_of_root(n, -1);
+    for ( size_t i = 0; i < n; i++ ) {
+        int root = Find(parent, i);
+        if ( orbit_of_root[root] == -1 ) {
+            orbit_of_root[root] = orbits.size();
+            orbits.emplace_back();
+        }
+        orbits[orbit_of_root[root]].push_back(_labels[i]);
+    }
+    return orbits;
+}
+
+std::vector<int> AutomorphismFinder::StabilizerOrbit(int u, int v)
+{
+    const size_t n = _labels.size();
+    const int iu = _index[u], iv = _index[v];
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    Partition base = FixedPartition({iu});
+    std::vector<int> perm;
+    for ( size_t w = 0; w < n && _budget > 0; w++ ) {
+        if ( base[w] != base[iv] || Find(parent, w) == Find(parent, iv) ) {
+            continue;
+        }
+        Partition a = Individualize(base, iv), b = Individualize(base, w);
+        Refine(a);
+        Refine(b);
+        if ( Search(a, b, perm) ) {
+            _num_automorphisms++;
+            Join(parent, perm);
+        }
+    }
+
+    std::vector<int> orbit;
+    for ( size_t w = 0; w < n; w++ ) {
+        if ( Find(parent, w) == Find(parent, iv) ) {
+            orbit.push_back(_labels[w]);
+        }
+    }
+    return orbit;
+}
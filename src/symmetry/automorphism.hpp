@@ -0,0 +1,95 @@
+#ifndef AUTOMORPHISM_HPP
+#define AUTOMORPHISM_HPP
+
+#include <vector>
+
+#include "graph.hpp"
+
+/**
+ * @brief finds automorphisms of a graph by partition refinement (individualize and refine,
+ *        as in nauty) and uses them to compute orbits of vertices
+ *
+ * @details
+ * The vertices are split into cells by repeatedly refining on the multiset of the cells
+ * of the neighbours (the refinement is invariant under isomorphism). Two vertices of
+ * the same cell are then individualized in two copies of the partition, which are refined
+ * and searched in parallel until both are discrete: the resulting bijection is kept only
+ * if it is verified to be an automorphism. <br>
+ * Every automorphism found is sound, but the search is bounded by a budget of nodes,
+ * hence the orbits returned may be finer than the real ones.
+ */
+class AutomorphismFinder {
+    public:
+        /**
+         * @brief builds the finder on a copy of the adjacency of graph
+         *
+         * @param graph graph whose automorphisms are searched
+         * @param node_budget maximum number of search nodes, summed over all the queries
+         */
+        AutomorphismFinder(const Graph& graph, long node_budget = 20000);
+
+        /**
+         * @brief orbits of the automorphism group of the graph
+         *
+         * @return vertices (labels) of each orbit, orbits with a single vertex included
+         */
+        std::vector<std::vector<int>> Orbits();
+
+        /**
+         * @brief orbit of v under the automorphisms of the graph that fix u
+         *
+         * @return vertices (labels) w such that an automorphism fixing u maps v to w, v included
+         */
+        std::vector<int> StabilizerOrbit(int u, int v);
+
+        /**
+         * @brief number of verified automorphisms found so far
+         */
+        size_t GetNumAutomorphisms() const { return _num_automorphisms; }
+
+    private:
+        using Partition = std::vector<int>;    // cell of each vertex (index), cells are 0..k-1
+
+        std::vector<int> _labels;               // index -> vertex label
+        std::vector<int> _index;                // vertex label -> index
+        std::vector<std::vector<int>> _adj;     // sorted adjacency, on indices
+        long _budget;
+        size_t _num_automorphisms = 0;
+
+        /**
+         * @brief refines the partition until it is equitable (every vertex of a cell has the
+         *        same number of neighbours in each cell)
+         */
+        void Refine(Partition& cells) const;
+
+        /**
+         * @brief moves x to a new cell, placed just before the rest of its old cell
+         */
+        Partition Individualize(const Partition& cells, int x) const;
+
+        /**
+         * @brief searches a bijection mapping the partition a onto the partition b which is
+         *        an automorphism
+         *
+         * @param a refined partition
+         * @param b refined partition
+         * @param perm if found, perm[i] is the image of vertex i
+         * @return true if an automorphism was found
+         */
+        bool Search(const Partition& a, const Partition& b, std::vector<int>& perm);
+
+        bool IsAutomorphism(const std::vector<int>& perm) const;
+
+        /**
+         * @brief partition in which the vertices of fixed are individualized (in order)
+         */
+        Partition FixedPartition(const std::vector<int>& fixed) const;
+
+        /**
+         * @brief joins the cycles of perm in the union-find parent
+         */
+        static void Join(std::vector<int>& parent, const std::vector<int>& perm);
+        static int Find(std::vector<int>& parent, int i);
+};
+
+#endif // AUTOMORPHISM_HPP
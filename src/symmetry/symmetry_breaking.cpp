@@ -0,0 +1,19 @@
+#include "symmetry_breaking.hpp"
+#include "automorphism.hpp"
+
+#include <utility>
+
+int AddSymmetricEdges(const Graph& parent, Graph& child, int u, int v, long node_budget)
+{
+    AutomorphismFinder finder(parent, node_budget);
+    int added = 0;
+    for ( auto [fixed, moved] : { std::make_pair(u, v), std::make_pair(v, u) } ) {
+        for ( int w : finder.StabilizerOrbit(fixed, moved) ) {
+            if ( w != fixed && !child.HasEdge(fixed, w) ) {
+                child.AddEdge(fixed, w);
+                added++;
+            }
+        }
+    }
+    return added;
+}
@@ -0,0 +1,23 @@
+#ifndef SYMMETRY_BREAKING_HPP
+#define SYMMETRY_BREAKING_HPP
+
+#include "graph.hpp"
+
+/**
+ * @brief strengthens the add-edge child of a Zykov branching on (u, v) with the symmetries
+ *        of the parent graph
+ *
+ * @details
+ * If an automorphism of the parent fixes u and maps v to w, every coloring in which u and w 
+ * share a color is mapped to one in which u and v share a color, which the merge child 
+ * already explores. Hence u-w can be added to the add-edge child for every w in the orbit 
+ * of v under the stabilizer of u (and symmetrically for v), without losing the optimum.
+ *
+ * @param parent graph that was branched on
+ * @param child parent with the edge u-v added
+ * @param node_budget search budget of the automorphism finder
+ * @return number of edges added to child
+ */
+int AddSymmetricEdges(const Graph& parent, Graph& child, int u, int v, long node_budget = 20000);
+
+#endif // SYMMETRY_BREAKING_HPP
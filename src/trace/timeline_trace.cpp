@@ -0,0 +1,177 @@
+#include "timeline_trace.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    char phase;         // 'X' span, 's' flow start, 'f' flow end
+    const char* name;
+    double start;
+    double end;
+    uint64_t id;        // flows only
+    int tag;            // flows only
+};
+
+struct ThreadTrace {
+    int tid;
+    const char* name = nullptr;
+    std::vector<TraceEvent> events;
+};
+
+// the events of every thread that ever recorded, a deque never moves them
+std::mutex registry_mutex;
+std::deque<ThreadTrace> registry;
+
+std::mutex flow_mutex;
+// (sender, receiver, tag) -> messages sent, or received, so far
+std::map<std::tuple<int, int, int>, uint32_t> sent_messages;
+std::map<std::tuple<int, int, int>, uint32_t> received_messages;
+
+int world_rank = 0;
+double origin = 0;
+
+ThreadTrace& Local() {
+    thread_local ThreadTrace* local = nullptr;
+    if ( local == nullptr ) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        local = &registry.emplace_back();
+        local->tid = registry.size() - 1;
+    }
+    return *local;
+}
+
+int WorldRank(MPI_Comm comm, int rank) {
+    if ( comm == MPI_COMM_WORLD ) {
+        return rank;
+    }
+    MPI_Group group, world_group;
+    MPI_Comm_group(comm, &group);
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    int translated;
+    MPI_Group_translate_ranks(group, 1, &rank, world_group, &translated);
+    MPI_Group_free(&group);
+    MPI_Group_free(&world_group);
+    return translated;
+}
+
+void Append(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+void Append(std::string& out, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    out.append(buffer, std::min<int>(length, sizeof(buffer) - 1));
+}
+
+}
+
+std::atomic<bool> TimelineTrace::_enabled = false;
+
+void TimelineTrace::Start(MPI_Comm comm)
+{
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for ( ThreadTrace& thread : registry ) {
+            thread.events.clear();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(flow_mutex);
+        sent_messages.clear();
+        received_messages.clear();
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    MPI_Barrier(comm);
+    origin = MPI_Wtime();
+    _enabled.store(true);
+}
+
+void TimelineTrace::NameThread(const char* name)
+{
+    if ( Enabled() ) {
+        Local().name = name;
+    }
+}
+
+void TimelineTrace::Span(const char* name, double start, double end)
+{
+    Local().events.push_back({'X', name, start, end, 0, 0});
+}
+
+void TimelineTrace::MessageSent(MPI_Comm comm, int rank, int tag)
+{
+    if ( Enabled() ) {
+        Flow(true, comm, rank, tag);
+    }
+}
+
+void TimelineTrace::MessageReceived(MPI_Comm comm, int rank, int tag)
+{
+    if ( Enabled() ) {
+        Flow(false, comm, rank, tag);
+    }
+}
+
+void TimelineTrace::Flow(bool sent, MPI_Comm comm, int rank, int tag)
+{
+    int peer = WorldRank(comm, rank);
+    int sender = sent ? world_rank : peer;
+    int receiver = sent ? peer : world_rank;
+    uint32_t position;
+    {
+        std::lock_guard<std::mutex> lock(flow_mutex);
+        auto& counts = sent ? sent_messages : received_messages;
+        position = counts[{sender, receiver, tag}]++;
+    }
+    // unique over the run as long as ranks, tags and messages fit their bits
+    uint64_t id = ((uint64_t) (sender & 0xffff) << 48) | ((uint64_t) (receiver & 0xffff) << 32) |
+                  ((uint64_t) (tag & 0xff) << 24) | (position & 0xffffff);
+    double now = MPI_Wtime();
+    Local().events.push_back({sent ? 's' : 'f', "message", now, now, id, tag});
+}
+
+bool TimelineTrace::Write(const std::string& file_name)
+{
+    _enabled.store(false);
+
+    std::string out = "{\"traceEvents\": [\n";
+    Append(out, "{\"ph\": \"M\", \"name\": \"process_name\", \"pid\": %d, \"args\": {\"name\": \"rank %d\"}}",
+           world_rank, world_rank);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for ( const ThreadTrace& thread : registry ) {
+        if ( thread.name != nullptr ) {
+            Append(out, ",\n{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": %d, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                   world_rank, thread.tid, thread.name);
+        }
+        for ( const TraceEvent& event : thread.events ) {
+            double ts = (event.start - origin) * 1e6;
+            if ( event.phase == 'X' ) {
+                Append(out, ",\n{\"ph\": \"X\", \"name\": \"%s\", \"pid\": %d, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                       event.name, world_rank, thread.tid, ts, (event.end - event.start) * 1e6);
+            } else {
+                Append(out, ",\n{\"ph\": \"%c\", \"name\": \"%s\", \"cat\": \"mpi\", \"id\": %llu, \"pid\": %d, "
+                            "\"tid\": %d, \"ts\": %.3f, %s\"args\": {\"tag\": %d}}",
+                       event.phase, event.name, (unsigned long long) event.id, world_rank, thread.tid, ts,
+                       event.phase == 'f' ? "\"bp\": \"e\", " : "", event.tag);
+            }
+        }
+    }
+    Append(out, "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"rank\": %d}}\n", world_rank);
+
+    std::ofstream file(file_name, std::ios::binary);
+    if ( !file.is_open() ) {
+        return false;
+    }
+    file.write(out.data(), out.size());
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,94 @@
+#ifndef TIMELINE_TRACE_HPP
+#define TIMELINE_TRACE_HPP
+
+#include <mpi.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief timeline of the threads of a rank, written in the Chrome trace format
+ *        (chrome://tracing, ui.perfetto.dev)
+ *
+ * @details records spans (a named interval of a thread: node evaluation, clique, color,
+ *          branching, clone, serialization, MPI waits, idle time, work requests) and flow
+ *          events, which link the span sending an MPI message to the one receiving it on
+ *          the other rank. A message is identified by its sender, receiver, tag and its
+ *          position among the messages with the same ones, which both sides count in the
+ *          same order (MPI does not overtake messages between two ranks with the same tag). <br>
+ *          Timestamps are MPI_Wtime, shifted so that 0 is the barrier of Start on every rank,
+ *          which aligns ranks whose clocks are not synchronized. <br>
+ *          Every rank writes its own file, scripts/merge_traces.py merges them into one trace.
+ *          Spans are buffered per thread, nothing is recorded until Start.
+ */
+class TimelineTrace {
+    public:
+        static bool Enabled() { return _enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief starts recording, with a barrier on comm to align the clocks (collective)
+         */
+        static void Start(MPI_Comm comm);
+
+        /**
+         * @brief stops recording and writes the events of this rank as a Chrome trace
+         *
+         * @return false if the file could not be written
+         */
+        static bool Write(const std::string& file_name);
+
+        /**
+         * @brief names the current thread in the timeline, e.g. by its role
+         */
+        static void NameThread(const char* name);
+
+        /**
+         * @brief records a span of the current thread
+         *
+         * @param name static string
+         * @param start MPI_Wtime at its start
+         * @param end MPI_Wtime at its end
+         */
+        static void Span(const char* name, double start, double end);
+
+        /**
+         * @brief records the start of a flow: a message sent to rank of comm, to be called
+         *        while the sending span is open
+         */
+        static void MessageSent(MPI_Comm comm, int rank, int tag);
+
+        /**
+         * @brief records the end of a flow: a message received from rank of comm, to be called
+         *        while the receiving span is open
+         */
+        static void MessageReceived(MPI_Comm comm, int rank, int tag);
+
+    private:
+        static std::atomic<bool> _enabled;
+
+        static void Flow(bool sent, MPI_Comm comm, int rank, int tag);
+};
+
+/**
+ * @brief records the scope it lives in as a span, when the trace is enabled
+ */
+class TraceSpan {
+    public:
+        explicit TraceSpan(const char* name)
+        : _name{name}, _start{TimelineTrace::Enabled() ? MPI_Wtime() : -1} {}
+        ~TraceSpan() {
+            if ( _start >= 0 ) {
+                TimelineTrace::Span(_name, _start, MPI_Wtime());
+            }
+        }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        const char* _name;
+        double _start;
+};
+
+#endif // TIMELINE_TRACE_HPP
@@ -0,0 +1,104 @@
+#include "instance_features.hpp"
+
+#include <algorithm>
+
+#include "color.hpp"
+#include "connected_components.hpp"
+#include "fastwclq.hpp"
+
+namespace {
+
+/**
+ * @brief degeneracy by repeatedly removing a vertex of minimum degree, with the vertices
+ *        kept in buckets by degree so that the cost is linear in the size of the graph
+ */
+int Degeneracy(const CSRGraph& graph)
+{
+    const std::vector<int>& vertices = graph.GetVertices();
+    std::vector<int> degree(graph.GetHighestVertex() + 1, 0);
+    int max_degree = 0;
+    for ( int vertex : vertices ) {
+        degree[vertex] = graph.GetAdjacency(vertex).size();
+        max_degree = std::max(max_degree, degree[vertex]);
+    }
+
+    std::vector<std::vector<int>> buckets(max_degree + 1);
+    for ( int vertex : vertices ) {
+        buckets[degree[vertex]].push_back(vertex);
+    }
+
+    // a vertex may sit in several buckets, only the one of its current degree counts
+    std::vector<char> removed(degree.size(), 0);
+    int degeneracy = 0;
+    int lowest = 0;
+    for ( size_t num_removed = 0; num_removed < vertices.size(); ) {
+        while ( buckets[lowest].empty() ) {
+            lowest++;
+        }
+        int vertex = buckets[lowest].back();
+        buckets[lowest].pop_back();
+        if ( removed[vertex] || degree[vertex] != lowest ) {
+            continue;
+        }
+
+        removed[vertex] = 1;
+        num_removed++;
+        degeneracy = std::max(degeneracy, lowest);
+        for ( int neighbour : graph.GetAdjacency(vertex) ) {
+            if ( !removed[neighbour] ) {
+                buckets[--degree[neighbour]].push_back(neighbour);
+            }
+        }
+        // a neighbour may have dropped one below the current bucket
+        lowest = std::max(lowest - 1, 0);
+    }
+    return degeneracy;
+}
+
+}
+
+InstanceFeatures ExtractFeatures(GraphLoader& loader, const CSRGraph& graph, size_t histogram_bins)
+{
+    InstanceFeatures features;
+    features.num_vertices = graph.GetNumVertices();
+    features.num_edges = graph.GetNumEdges();
+    if ( features.num_vertices > 1 ) {
+        features.density = 2.0 * features.num_edges / ((double) features.num_vertices * (features.num_vertices - 1));
+        features.mean_degree = 2.0 * features.num_edges / features.num_vertices;
+    }
+
+    features.degree_histogram.resize(histogram_bins);
+    loader.calculateGraphStats(features.max_degree, features.min_degree, features.degree_histogram);
+
+    features.degeneracy = Degeneracy(graph);
+    features.num_components = ConnectedComponents(graph).size();
+
+    FastCliqueStrategy clique_strategy;
+    features.clique_size = clique_strategy.FindClique(graph);
+
+    // coloring changes the graph, a copy is colored
+    std::unique_ptr<Graph> copy = graph.Clone();
+    unsigned short greedy_colors;
+    GreedyColorStrategy().Color(*copy, greedy_colors);
+    features.greedy_colors = greedy_colors;
+
+    return features;
+}
+
+std::vector<std::pair<std::string, double>> NamedFeatures(const InstanceFeatures& features)
+{
+    return {
+        {"vertices",    (double) features.num_vertices},
+        {"edges",       (double) features.num_edges},
+        {"density",     features.density},
+        {"min_degree",  (double) features.min_degree},
+        {"max_degree",  (double) features.max_degree},
+        {"mean_degree", features.mean_degree},
+        {"degeneracy",  (double) features.degeneracy},
+        {"clique",      (double) features.clique_size},
+        {"greedy",      (double) features.greedy_colors},
+        {"gap",         (double) (features.greedy_colors - features.clique_size)},
+        {"components",  (double) features.num_components},
+        {"high_degree", features.degree_histogram.empty() ? 0.0 : features.degree_histogram[0]}
+    };
+}
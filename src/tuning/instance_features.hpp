@@ -0,0 +1,46 @@
+#ifndef INSTANCE_FEATURES_HPP
+#define INSTANCE_FEATURES_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "graph_loader.hpp"
+
+/**
+ * @brief cheap structural features of an instance, used to pick the strategies
+ */
+struct InstanceFeatures {
+    int num_vertices = 0;
+    long num_edges = 0;
+    double density = 0;
+    int min_degree = 0;
+    int max_degree = 0;
+    double mean_degree = 0;
+    // fraction of the vertices in each degree band, see GraphLoader::calculateGraphStats
+    std::vector<float> degree_histogram;
+    // largest minimum degree of a subgraph, greedy in degeneracy order uses at most one color more
+    int degeneracy = 0;
+    int clique_size = 0;        // lower bound of the heuristic clique
+    int greedy_colors = 0;      // upper bound of the greedy coloring
+    int num_components = 0;
+};
+
+/**
+ * @brief extracts the features of a graph just loaded
+ *
+ * @param loader loader which read the graph, gives the degree statistics
+ * @param graph the graph, it is not modified
+ * @param histogram_bins number of bands of the degree histogram
+ */
+InstanceFeatures ExtractFeatures(GraphLoader& loader, const CSRGraph& graph, size_t histogram_bins = 10);
+
+/**
+ * @brief the scalar features by name, as used in the tuning rules: vertices, edges, density,
+ *        min_degree, max_degree, mean_degree, degeneracy, clique, greedy, gap (greedy - clique),
+ *        components, and high_degree (fraction of the vertices in the top band of the histogram)
+ */
+std::vector<std::pair<std::string, double>> NamedFeatures(const InstanceFeatures& features);
+
+#endif // INSTANCE_FEATURES_HPP
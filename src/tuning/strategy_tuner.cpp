@@ -0,0 +1,184 @@
+#include "strategy_tuner.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// built-in table, hand-written defaults rather than learnt from runs: a table learnt with
+// train_tuning_rules.py replaces it through --tuning_rules
+const char* DEFAULT_RULES[] = {
+    "when gap<=0 use color=0 balanced=0 period=10 "
+        "because the greedy coloring already meets the clique, the search only has to confirm it",
+    "when vertices>=300 density<0.2 use color=2 balanced=1 period=5 "
+        "because large sparse graphs get far better colorings from DSatur than from greedy, "
+        "and the balanced split spreads their large tree",
+    "when density>=0.4 use color=1 balanced=0 period=2 "
+        "because dense graphs are decided by the proof: recoloring keeps the incumbent tight "
+        "and frequent gathers share it early",
+    "use color=0 balanced=1 period=10 "
+        "because no rule matched, the defaults of run_instance"
+};
+
+bool ParseNumber(const std::string& text, double& value) {
+    std::istringstream in(text);
+    return (in >> value) && in.eof();
+}
+
+bool Holds(double feature, const std::string& op, double value) {
+    if ( op == "<" )  return feature < value;
+    if ( op == "<=" ) return feature <= value;
+    if ( op == ">" )  return feature > value;
+    if ( op == ">=" ) return feature >= value;
+    return feature == value;
+}
+
+std::string FormatValue(double value) {
+    std::ostringstream out;
+    out << value;
+    return out.str();
+}
+
+}
+
+StrategyTuner::StrategyTuner()
+{
+    std::string error;
+    for ( const char* rule : DEFAULT_RULES ) {
+        AddRule(rule, error);
+    }
+}
+
+bool StrategyTuner::LoadRules(const std::string& file_name, std::string& error)
+{
+    std::ifstream in(file_name);
+    if ( !in.is_open() ) {
+        error = "Could not open tuning rules " + file_name;
+        return false;
+    }
+
+    _rules.clear();
+    std::string line;
+    while ( std::getline(in, line) ) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if ( start == std::string::npos || line[start] == '#' ) {
+            continue;
+        }
+        if ( !AddRule(line, error) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StrategyTuner::AddRule(const std::string& line, std::string& error)
+{
+    static const std::vector<std::string> feature_names = [] {
+        std::vector<std::string> names;
+        for ( const auto& [name, value] : NamedFeatures(InstanceFeatures{}) ) {
+            names.push_back(name);
+        }
+        return names;
+    }();
+
+    Rule rule;
+    std::istringstream words(line);
+    std::string word;
+    // 0: conditions, 1: settings, 2: reason
+    int part = -1;
+    while ( words >> word ) {
+        if ( part == -1 && word == "when" )     { part = 0; continue; }
+        if ( part <= 0 && word == "use" )       { part = 1; continue; }
+        if ( part == 1 && word == "because" )   { part = 2; continue; }
+
+        if ( part == 0 ) {
+            size_t op_start = word.find_first_of("<>=");
+            size_t op_end = word.find_first_not_of("<>=", op_start);
+            Condition condition;
+            if ( op_start != std::string::npos && op_end != std::string::npos ) {
+                condition.feature = word.substr(0, op_start);
+                condition.op = word.substr(op_start, op_end - op_start);
+            }
+            bool known = std::find(feature_names.begin(), feature_names.end(), condition.feature) != feature_names.end();
+            bool valid_op = condition.op == "<" || condition.op == "<=" || condition.op == ">" ||
+                            condition.op == ">=" || condition.op == "=";
+            if ( !known || !valid_op || !ParseNumber(word.substr(op_end), condition.value) ) {
+                error = "Invalid condition `" + word + "` in tuning rule: " + line;
+                return false;
+            }
+            rule.conditions.push_back(condition);
+        } else if ( part == 1 ) {
+            size_t equal = word.find('=');
+            std::string key = word.substr(0, equal);
+            double value;
+            if ( equal == std::string::npos || !ParseNumber(word.substr(equal + 1), value) || value < 0 ) {
+                key.clear();
+            }
+            if ( key == "color" && value <= 3 )      rule.color_strategy = value;
+            else if ( key == "balanced" && value <= 1 ) rule.balanced = value;
+            else if ( key == "period" && value >= 1 )   rule.sol_gather_period = value;
+            else {
+                error = "Invalid setting `" + word + "` in tuning rule: " + line;
+                return false;
+            }
+        } else if ( part == 2 ) {
+            rule.reason += ( rule.reason.empty() ? "" : " " ) + word;
+        } else {
+            error = "A tuning rule starts with `when` or `use`: " + line;
+            return false;
+        }
+    }
+    if ( part < 1 ) {
+        error = "Tuning rule without settings: " + line;
+        return false;
+    }
+
+    size_t start = line.find_first_not_of(" \t");
+    size_t end = line.find_last_not_of(" \t\r");
+    rule.text = line.substr(start, end - start + 1);
+    _rules.push_back(rule);
+    return true;
+}
+
+TuningChoice StrategyTuner::Choose(const InstanceFeatures& features, const TuningChoice& defaults) const
+{
+    std::vector<std::pair<std::string, double>> named = NamedFeatures(features);
+    auto feature = [&named](const std::string& name) {
+        for ( const auto& [feature_name, value] : named ) {
+            if ( feature_name == name ) return value;
+        }
+        return 0.0;
+    };
+
+    for ( const Rule& rule : _rules ) {
+        bool matches = true;
+        std::string matched;
+        for ( const Condition& condition : rule.conditions ) {
+            double value = feature(condition.feature);
+            if ( !Holds(value, condition.op, condition.value) ) {
+                matches = false;
+                break;
+            }
+            matched += ( matched.empty() ? "" : ", " ) + condition.feature + " = " + FormatValue(value);
+        }
+        if ( !matches ) {
+            continue;
+        }
+
+        TuningChoice choice = defaults;
+        if ( rule.color_strategy != -1 )    choice.color_strategy = rule.color_strategy;
+        if ( rule.balanced != -1 )          choice.balanced = rule.balanced;
+        if ( rule.sol_gather_period != -1 ) choice.sol_gather_period = rule.sol_gather_period;
+        choice.rule = rule.text;
+        choice.rationale = rule.reason;
+        if ( !matched.empty() ) {
+            choice.rationale += ( choice.rationale.empty() ? "(" : " (" ) + matched + ")";
+        }
+        return choice;
+    }
+
+    TuningChoice choice = defaults;
+    choice.rationale = "no rule matched, the command line settings are kept";
+    return choice;
+}
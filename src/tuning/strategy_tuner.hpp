@@ -0,0 +1,79 @@
+#ifndef STRATEGY_TUNER_HPP
+#define STRATEGY_TUNER_HPP
+
+#include <string>
+#include <vector>
+
+#include "instance_features.hpp"
+
+/**
+ * @brief settings chosen for an instance, with the reason of the choice
+ */
+struct TuningChoice {
+    int color_strategy = 0;         // as --color_strategy
+    int balanced = 1;               // as --balanced
+    int sol_gather_period = 10;     // as --sol_gather_period
+    std::string rule;               // the rule which matched, as written in the table
+    std::string rationale;          // why: the reason of the rule and the values which matched
+};
+
+/**
+ * @brief picks the solver settings of an instance from its features with an ordered rule
+ *        table: the first rule whose conditions all hold gives the settings. A rule is a line
+ *
+ *        when <conditions> use <settings> because <reason>
+ *
+ *        where the conditions are `<feature><op><value>` with op among <, <=, >, >=, = and
+ *        the features of NamedFeatures, and the settings are `color=`, `balanced=` and
+ *        `period=` (settings left out keep their defaults). A rule without `when` always
+ *        matches. Tables can be written by hand or learnt from past runs with
+ *        src/scripts/train_tuning_rules.py
+ */
+class StrategyTuner {
+    public:
+        /**
+         * @brief a tuner with the built-in table
+         */
+        StrategyTuner();
+
+        /**
+         * @brief replaces the table with the rules of a file, one per line. Blank lines and
+         *        lines starting with '#' are skipped
+         *
+         * @param error set to a description of the problem when false is returned
+         * @return false if the file could not be opened or has a malformed rule
+         */
+        bool LoadRules(const std::string& file_name, std::string& error);
+
+        /**
+         * @brief appends a rule to the table
+         * @return false if the rule is malformed, error tells why
+         */
+        bool AddRule(const std::string& line, std::string& error);
+
+        /**
+         * @param defaults settings returned when no rule matches
+         */
+        TuningChoice Choose(const InstanceFeatures& features, const TuningChoice& defaults) const;
+
+    private:
+        struct Condition {
+            std::string feature;
+            std::string op;
+            double value;
+        };
+
+        struct Rule {
+            std::vector<Condition> conditions;
+            // settings left out are -1
+            int color_strategy = -1;
+            int balanced = -1;
+            int sol_gather_period = -1;
+            std::string reason;
+            std::string text;
+        };
+
+        std::vector<Rule> _rules;
+};
+
+#endif // STRATEGY_TUNER_HPP
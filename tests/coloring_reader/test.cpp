@@ -0,0 +1,115 @@
+#include "branch_n_bound_par.hpp"
+#include "branching_strategy.hpp"
+#include "clique_strategy.hpp"
+#include "coloring_reader.hpp"
+#include "csr_graph.hpp"
+#include "dimacs.hpp"
+#include "dsatur_color.hpp"
+#include "result_writer.hpp"
+
+#include "test_common.hpp"
+
+#include <mpi.h>
+
+#include <climits>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// reads the file as run_instance does, resized to the graph and verified
+bool read_initial_coloring(const std::string& file_name, const CSRGraph& graph,
+                           std::vector<unsigned short>& coloring) {
+    std::string error;
+    bool read = ReadColoring(file_name, coloring, error);
+    std::cout << "  read: " << read << " " << error << std::endl;
+    if ( !read ) {
+        return false;
+    }
+    coloring.resize(graph.GetFullColoring().size(), 0);
+    bool valid = VerifyColoring(graph, coloring);
+    std::cout << "  coloring: " << TestFunctions::VecToString(coloring) << " valid: " << valid << std::endl;
+    return valid;
+}
+
+int main(int argc, char** argv) {
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+
+    // triangle 1-2-3 with the pendant vertex 4 on 3, chromatic number 3
+    std::string graph_file = "coloring_reader_test_graph.col";
+    {
+        std::ofstream out(graph_file);
+        out << "p edge 4 4\n";
+        out << "e 1 2\ne 2 3\ne 1 3\ne 3 4\n";
+    }
+    Dimacs dimacs;
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(graph_file, dimacs);
+    std::vector<unsigned short> coloring;
+
+    std::ofstream("coloring_reader_test_results.txt") << "problem_instance_file_name coloring_reader_test\n"
+                                                      << "number_of_vertices 4\n"
+                                                      << "number_of_colors 3\n"
+                                                      << "1 1\n2 2\n3 3\n4 1\n";
+    std::cout << "File in the format of results/ (expected read 1, coloring 0 1 2 3 1, valid 1):" << std::endl;
+    read_initial_coloring("coloring_reader_test_results.txt", graph, coloring);
+
+    std::ofstream("coloring_reader_test_plain.txt") << "4 2\n1 1\n3 3\n\n2 2 \n";
+    std::cout << "Plain lines in any order (expected read 1, coloring 0 1 2 3 2, valid 1):" << std::endl;
+    read_initial_coloring("coloring_reader_test_plain.txt", graph, coloring);
+
+    std::ofstream("coloring_reader_test_vertex.txt") << "1 1\n" << (long) INT_MAX + 1 << " 2\n";
+    std::cout << "Vertex out of range (expected read 0):" << std::endl;
+    read_initial_coloring("coloring_reader_test_vertex.txt", graph, coloring);
+
+    std::ofstream("coloring_reader_test_color.txt") << "1 1\n2 " << USHRT_MAX + 1 << "\n";
+    std::cout << "Color out of range (expected read 0):" << std::endl;
+    read_initial_coloring("coloring_reader_test_color.txt", graph, coloring);
+
+    std::ofstream("coloring_reader_test_empty.txt") << "number_of_colors 3\n";
+    std::cout << "No coloring line (expected read 0):" << std::endl;
+    read_initial_coloring("coloring_reader_test_empty.txt", graph, coloring);
+
+    std::cout << "Missing file (expected read 0):" << std::endl;
+    read_initial_coloring("coloring_reader_test_missing.txt", graph, coloring);
+
+    std::ofstream("coloring_reader_test_conflict.txt") << "1 1\n2 2\n3 3\n4 3\n";
+    std::cout << "Pendant vertex with the color of its neighbour (expected read 1, valid 0):" << std::endl;
+    read_initial_coloring("coloring_reader_test_conflict.txt", graph, coloring);
+
+    std::ofstream("coloring_reader_test_partial.txt") << "1 1\n2 2\n3 3\n";
+    std::cout << "Vertex left uncolored (expected read 1, valid 0):" << std::endl;
+    read_initial_coloring("coloring_reader_test_partial.txt", graph, coloring);
+
+    NeighboursBranchingStrategy branching_strategy;
+    FastCliqueStrategy clique_strategy;
+    DSaturColorStrategy color_strategy;
+    double optimum_time;
+
+    // the seed is the incumbent: already at the expected chromatic number, nothing is searched
+    std::ofstream("coloring_reader_test_seed.txt") << "1 1\n2 2\n3 3\n4 2\n";
+    read_initial_coloring("coloring_reader_test_seed.txt", graph, coloring);
+    {
+        BranchNBoundPar solver(branching_strategy, clique_strategy, color_strategy, "coloring_reader_test_log.bin", false);
+        solver.SetInitialColoring(coloring);
+        std::unique_ptr<Graph> g = graph.Clone();
+        int chi = solver.Solve(*g, optimum_time, 10, 1, 3);
+        std::cout << "Seed at the expected chromatic number: " << chi << " (expected 3), coloring "
+                  << TestFunctions::VecToString(g->GetFullColoring()) << "(expected the seed 0 1 2 3 2)" << std::endl;
+    }
+
+    // a seed with a color too many only bounds the search, which still finds 3
+    std::ofstream("coloring_reader_test_loose.txt") << "1 1\n2 2\n3 3\n4 4\n";
+    read_initial_coloring("coloring_reader_test_loose.txt", graph, coloring);
+    {
+        BranchNBoundPar solver(branching_strategy, clique_strategy, color_strategy, "coloring_reader_test_log.bin", false);
+        solver.SetInitialColoring(coloring);
+        std::unique_ptr<Graph> g = graph.Clone();
+        int chi = solver.Solve(*g, optimum_time, 10, 1);
+        std::cout << "Seed with 4 colors: " << chi << " (expected 3), coloring valid: "
+                  << VerifyColoring(graph, g->GetFullColoring()) << " (expected 1)" << std::endl;
+    }
+
+    MPI_Finalize();
+    return 0;
+}
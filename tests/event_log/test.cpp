@@ -0,0 +1,46 @@
+#include "event_log.hpp"
+
+#include "test_common.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+
+#include <iostream>
+#include <vector>
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    std::string file_name = "event_log_test.bin";
+    {
+        EventLog log(file_name, true);
+        LOG_EVENT(log, INIT_BOUNDS, 0, 3, 5);
+        // more records than a buffer holds, from several threads
+        #pragma omp parallel num_threads(3)
+        {
+            for ( size_t i = 0; i < EventLog::BUFFER_RECORDS; i++ ) {
+                LOG_EVENT(log, PROCESS_NODE, 2, omp_get_thread_num(), (int) i);
+            }
+        }
+        LOG_EVENT(log, PRUNE_BEST, 1, 4, 6, 6);
+        EventLog disabled("event_log_disabled.bin", false);
+        int evaluated = 0;
+        LOG_EVENT(disabled, GATHERED_UB, 0, ++evaluated);
+        std::cout << "Arguments evaluated when disabled: " << evaluated << " (expected 0)" << std::endl;
+    }
+
+    int rank;
+    std::vector<EventRecord> records;
+    std::cout << "Read: " << EventLog::Read(file_name, rank, records) << " (expected 1)" << std::endl;
+    std::cout << "Records: " << records.size() << " (expected " << 3 * EventLog::BUFFER_RECORDS + 2 << ")" << std::endl;
+    bool sorted = true;
+    for ( size_t i = 1; i < records.size(); i++ ) {
+        sorted = sorted && records[i - 1].time <= records[i].time;
+    }
+    std::cout << "Sorted by time: " << sorted << " (expected 1)" << std::endl;
+    std::cout << EventLog::Render(records.front(), rank) << std::endl;
+    std::cout << EventLog::Render(records[1], rank) << std::endl;
+    std::cout << EventLog::Render(records.back(), rank) << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "graph_generators.hpp"
+#include "dsatur_color.hpp"
+#include "result_writer.hpp"
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+static bool Simple(const GeneratedGraph& graph) {
+    std::set<std::pair<int, int>> distinct(graph.edges.begin(), graph.edges.end());
+    return distinct.size() == graph.edges.size() &&
+           std::all_of(graph.edges.begin(), graph.edges.end(), [&graph](const std::pair<int, int>& edge) {
+               return 1 <= edge.first && edge.first < edge.second && edge.second <= graph.num_vertices;
+           });
+}
+
+static int DSaturColors(const GeneratedGraph& generated) {
+    std::unique_ptr<CSRGraph> graph = generated.ToCSRGraph();
+    DSaturColorStrategy dsatur;
+    unsigned short colors;
+    dsatur.Color(*graph, colors);
+    return VerifyColoring(*graph, graph->GetFullColoring()) ? colors : -1;
+}
+
+int main() {
+    GeneratedGraph first = GraphGenerator::Random(300, 0.05, 7);
+    GeneratedGraph again = GraphGenerator::Random(300, 0.05, 7);
+    GeneratedGraph other = GraphGenerator::Random(300, 0.05, 8);
+    std::cout << "G(n, p) edges: " << first.edges.size() << " (expected about " << 0.05 * 300 * 299 / 2 << ")" << std::endl;
+    std::cout << "Same seed, same graph: " << (first.edges == again.edges) << ", other seed: "
+              << (first.edges == other.edges) << " (expected 1, 0)" << std::endl;
+    std::cout << "Simple: " << Simple(first) << " (expected 1)" << std::endl;
+    std::cout << "Complete: " << GraphGenerator::Random(10, 1, 1).edges.size() << ", empty: "
+              << GraphGenerator::Random(10, 0, 1).edges.size() << " (expected 45, 0)" << std::endl;
+
+    std::unique_ptr<CSRGraph> graph = first.ToCSRGraph();
+    std::cout << "CSRGraph: " << graph->GetNumVertices() << " vertices, " << graph->GetNumEdges() << " edges (expected 300, "
+              << first.edges.size() << ")" << std::endl;
+    bool written = first.WriteDimacs("generated_test.col");
+    std::unique_ptr<CSRGraph> loaded(CSRGraph::LoadFromDimacs("generated_test.col"));
+    bool same = loaded->GetNumVertices() == graph->GetNumVertices() && loaded->GetNumEdges() == graph->GetNumEdges() &&
+                std::all_of(first.edges.begin(), first.edges.end(), [&loaded](const std::pair<int, int>& edge) {
+                    return loaded->HasEdge(edge.first, edge.second);
+                });
+    std::cout << "DIMACS round trip: " << (written && same) << " (expected 1)" << std::endl;
+
+    GeneratedGraph leighton = GraphGenerator::Leighton(150, 5, 1500, 3);
+    std::cout << "Leighton: " << leighton.edges.size() << " edges, chi " << leighton.chromatic_number << ", simple "
+              << Simple(leighton) << ", DSatur colors >= chi " << (DSaturColors(leighton) >= 5)
+              << " (expected >= 1500, 5, 1, 1)" << std::endl;
+
+    GeneratedGraph queen = GraphGenerator::Queen(5);
+    std::cout << "Queen 5x5: " << queen.num_vertices << " vertices, " << queen.edges.size() << " edges, chi "
+              << queen.chromatic_number << " (expected 25, 160, 5 as queen5_5.col)" << std::endl;
+    std::cout << "Queen 8x8 chi: " << GraphGenerator::Queen(8).chromatic_number << " (expected 0, unknown)" << std::endl;
+
+    GeneratedGraph mycielski = GraphGenerator::Mycielski(4);
+    std::cout << "Mycielski(4): " << mycielski.num_vertices << " vertices, " << mycielski.edges.size() << " edges, "
+              << "DSatur colors " << DSaturColors(mycielski) << " (expected 11, 20, 4 as myciel3.col)" << std::endl;
+
+    GeneratedGraph planted = GraphGenerator::Planted(200, 4, 0.3, false, 5);
+    std::cout << "Planted: simple " << Simple(planted) << ", 4-colorable by construction, DSatur colors "
+              << DSaturColors(planted) << " (expected 1, at least 4)" << std::endl;
+
+    GeneratedGraph flat = GraphGenerator::Planted(200, 4, 0.3, true, 5);
+    std::vector<int> degree(201, 0);
+    for ( const auto& [v, w] : flat.edges ) {
+        degree[v]++;
+        degree[w]++;
+    }
+    auto [lowest, highest] = std::minmax_element(degree.begin() + 1, degree.end());
+    std::cout << "Flat: " << flat.edges.size() << " edges, simple " << Simple(flat) << ", degrees " << *lowest << ".."
+              << *highest << " (expected 6 * 750 = 4500, 1, 45..45)" << std::endl;
+
+    GeneratedGraph interference = GraphGenerator::Interference(20000, 6, 11);
+    double mean_degree = 2.0 * interference.edges.size() / interference.num_vertices;
+    std::cout << "Interference: mean degree " << mean_degree << ", simple " << Simple(interference) << ", DSatur colors "
+              << DSaturColors(interference) << " >= chi " << interference.chromatic_number
+              << " (expected about 6, 1, chi of an interval graph)" << std::endl;
+
+    GeneratedGraph from_spec;
+    std::string error;
+    bool parsed = GraphGenerator::FromSpec("leighton:n=150,k=5,m=1500,seed=3", from_spec, error);
+    std::cout << "Spec: " << parsed << " " << from_spec.name << ", same as the call " << (from_spec.edges == leighton.edges)
+              << " (expected 1 leighton_n150_k5_m1500_seed3, 1)" << std::endl;
+    std::cout << "Unknown family: " << GraphGenerator::FromSpec("petersen:n=10", from_spec, error) << " (" << error << ")"
+              << ", missing parameter: " << GraphGenerator::FromSpec("gnp:n=10", from_spec, error) << " (" << error << ")"
+              << ", bad value: " << GraphGenerator::FromSpec("queen:n=x", from_spec, error) << " (" << error << ")"
+              << " (expected 0, 0, 0)" << std::endl;
+    return 0;
+}
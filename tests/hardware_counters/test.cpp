@@ -0,0 +1,102 @@
+#include "hardware_counters.hpp"
+#include "solver_stats.hpp"
+
+#include "test_common.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// pointer chasing over a large array, which misses the caches
+static long Chase(int steps) {
+    static std::vector<int> next;
+    if ( next.empty() ) {
+        const int size = 1 << 22;
+        next.resize(size);
+        for ( int i = 0; i < size; i++ ) {
+            next[i] = (int) ((i * 2654435761u + 12345) % size);
+        }
+    }
+    long sum = 0;
+    int position = 0;
+    for ( int i = 0; i < steps; i++ ) {
+        position = next[position];
+        sum += position;
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+
+    bool available = HardwareCounters::Enable(true);
+    std::cout << "Hardware counters available: " << available << ", enabled: " << HardwareCounters::Enabled()
+              << " (1, 1 where perf_event_open gives them, else 0, 0 and the values below are 0)" << std::endl;
+
+    SolverStats::Reset();
+    long sum = 0;
+    #pragma omp parallel num_threads(2) reduction(+:sum)
+    {
+        for ( int i = 0; i < 100; i++ ) {
+            SolverStats::Count(StatCounter::NODES_PROCESSED);
+            PhaseTimer timer(StatPhase::CLIQUE);
+            sum += Chase(10000);
+        }
+    }
+    StatsReport report = SolverStats::Reduce(MPI_COMM_WORLD);
+    const HardwareValues& clique = report.events[static_cast<size_t>(StatPhase::CLIQUE)];
+    std::cout << "Clique phase: " << clique[static_cast<size_t>(HardwareEvent::CYCLES)] << " cycles, "
+              << clique[static_cast<size_t>(HardwareEvent::INSTRUCTIONS)] << " instructions, IPC "
+              << report.Ipc(StatPhase::CLIQUE) << ", " << report.PerNode(StatPhase::CLIQUE, HardwareEvent::LLC_MISSES)
+              << " LLC misses and " << report.PerNode(StatPhase::CLIQUE, HardwareEvent::BRANCH_MISSES)
+              << " branch misses per node (expected, if available, IPC > 0 and up to 10000 LLC misses per node)"
+              << std::endl;
+    std::cout << "Other phases counted: " << report.events[static_cast<size_t>(StatPhase::COLOR)][0]
+              << " cycles (expected 0), has events: " << report.HasHardwareEvents() << " (expected " << available << ")"
+              << std::endl;
+    int named_ipc = 0;
+    for ( const auto& [name, value] : report.Named() ) {
+        named_ipc += name == "clique_ipc";
+    }
+    std::cout << "clique_ipc in the named statistics: " << named_ipc << " (expected " << available << ")" << std::endl;
+
+    // cost of a timed phase with the counters, against the few nanoseconds without
+    const int repetitions = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < repetitions; i++ ) {
+        PhaseTimer timer(StatPhase::BRANCHING);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Overhead of a timer with the counters: " << seconds / repetitions * 1e9 << " ns (checksum " << sum % 10
+              << ")" << std::endl;
+
+    // a group multiplexed out before the interval and always running in it: the cumulative values
+    // scaled on their own (2000, then 1100) would go backwards, the interval has 100 events
+    HardwareSample before, after;
+    HardwareValues delta;
+    before.values.fill(1000);
+    before.enabled = 100;
+    before.running = 50;
+    after.values.fill(1100);
+    after.enabled = 200;
+    after.running = 150;
+    bool kept = HardwareCounters::Delta(before, after, delta);
+    std::cout << "Interval running all the time: " << kept << ", " << delta[0] << " events (expected 1, 100)"
+              << std::endl;
+    after.enabled = 300;
+    kept = HardwareCounters::Delta(before, after, delta);
+    std::cout << "Interval running half the time: " << kept << ", " << delta[0] << " events (expected 1, 200)"
+              << std::endl;
+    after.running = before.running;
+    kept = HardwareCounters::Delta(before, after, delta);
+    std::cout << "Interval not running: " << kept << ", " << delta[0] << " events (expected 0, 0)" << std::endl;
+
+    HardwareCounters::Enable(false);
+    std::cout << "Disabled: " << HardwareCounters::Enabled() << " (expected 0)" << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "csr_graph.hpp"
+#include "nogood_index.hpp"
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void print_prunes(const std::string& message, NogoodIndex& index, const Graph& child, int u, int v, int min_size) {
+    std::cout << message << ": " << (index.Prunes(child, u, v, min_size) ? "pruned" : "not pruned") << std::endl;
+}
+
+int main() {
+    // 5-cycle 1-2-3-4-5: triangle free, so every triangle comes from the branching
+    std::string cycle_file_name = "nogood_test_cycle.col";
+    {
+        std::ofstream out(cycle_file_name);
+        out << "p edge 5 5\n";
+        out << "e 1 2\ne 2 3\ne 3 4\ne 4 5\ne 5 1\n";
+    }
+    CSRGraph& root = *CSRGraph::LoadFromDimacs(cycle_file_name);
+    NogoodIndex index(root, 4);
+
+    // adding 1-3 makes the triangle 1 2 3
+    std::cout << "Record {1, 2, 3}: " << index.Record({1, 2, 3}) << " (expected 1)" << std::endl;
+    std::cout << "Record {3, 2, 1} again: " << index.Record({3, 2, 1}) << " (expected 0)" << std::endl;
+    std::cout << "Record the root edge {1, 2}: " << index.Record({1, 2}) << " (expected 0)" << std::endl;
+
+    CSRGraph add_edge(root);
+    add_edge.AddEdge(1, 3);
+    print_prunes("Adding 1-3, 3 colors", index, add_edge, 1, 3, 3);
+    print_prunes("Adding 1-3, 4 colors", index, add_edge, 1, 3, 4);
+
+    // merging 5 into 3 makes 1 and 3 adjacent without adding 1-3: same triangle
+    CSRGraph merge(root);
+    merge.MergeVertices(3, 5);
+    print_prunes("Merging 5 into 3", index, merge, 3, 5, 3);
+
+    // merging 3 into 1 puts them in the same class
+    CSRGraph merge_pair(root);
+    merge_pair.MergeVertices(1, 3);
+    print_prunes("Merging 3 into 1", index, merge_pair, 1, 3, 3);
+
+    // the triangle is made adjacent at 1 and 3, a child changing 2 and 4 cannot satisfy it
+    CSRGraph other(add_edge);
+    other.AddEdge(2, 4);
+    print_prunes("Adding 1-3 then 2-4, checked at 2 and 4", index, other, 2, 4, 3);
+
+    std::cout << "Hits: " << index.GetNumHits() << " (expected 2), most used: " 
+              << TestFunctions::VecToString(index.MostUsed(1).at(0)) << std::endl;
+
+    // a full index replaces its least used nogood
+    NogoodIndex small(root, 1);
+    small.Record({1, 2, 3});
+    small.Record({2, 3, 4});
+    std::cout << "Nogoods kept with capacity 1: " << small.GetNumNogoods() << std::endl;
+    CSRGraph add_edge_24(root);
+    add_edge_24.AddEdge(2, 4);
+    print_prunes("Capacity 1, adding 1-3", small, add_edge, 1, 3, 3);
+    print_prunes("Capacity 1, adding 2-4", small, add_edge_24, 2, 4, 3);
+
+    return 0;
+}
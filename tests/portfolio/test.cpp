@@ -0,0 +1,60 @@
+#include "portfolio.hpp"
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void print_groups(const std::vector<PortfolioConfig>& configs, int num_ranks) {
+    std::cout << num_ranks << " ranks:";
+    std::vector<int> group_of_rank = AssignGroups(configs, num_ranks);
+    if ( group_of_rank.empty() ) {
+        std::cout << " groups do not fit";
+    }
+    for ( int group : group_of_rank ) {
+        std::cout << " " << group;
+    }
+    std::cout << std::endl;
+}
+
+int main() {
+    std::string file_name = "portfolio_test.txt";
+    {
+        std::ofstream out(file_name);
+        out << "# two groups racing\n";
+        out << "ranks=2 branching=neighbours color=0 selection=depth\n";
+        out << "\n";
+        out << "ranks=1 branching=random color=2 selection=gap seed=7\n";
+    }
+
+    std::vector<PortfolioConfig> configs;
+    std::string error;
+    std::cout << "Read: " << ReadPortfolio(file_name, configs, error) << " (expected 1)" << std::endl;
+    for ( size_t group = 0; group < configs.size(); group++ ) {
+        std::cout << "Group " << group << ": " << configs[group].description 
+                  << " (ranks " << configs[group].ranks << ", seed " << configs[group].seed << ")" << std::endl;
+    }
+    print_groups(configs, 3);
+    print_groups(configs, 4);
+
+    {
+        std::ofstream out(file_name);
+        out << "ranks=2 selection=breadth\n";
+    }
+    std::cout << "Read invalid selection: " << ReadPortfolio(file_name, configs, error) << " (expected 0)" << std::endl;
+    std::cout << error << std::endl;
+
+    std::cout << "Read missing file: " << ReadPortfolio("missing_portfolio.txt", configs, error) << " (expected 0)" << std::endl;
+    std::cout << error << std::endl;
+
+    // a queue ordered by gap pops the node with the smallest gap first
+    BranchOrder order{NodeSelection::GAP};
+    Branch narrow, wide;
+    narrow.lb = 4; narrow.ub = 5;
+    wide.lb = 2; wide.ub = 6;
+    std::cout << "Gap order processes the wide node after the narrow one: " << order(wide, narrow) << " (expected 1)" << std::endl;
+
+    return 0;
+}
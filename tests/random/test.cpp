@@ -0,0 +1,81 @@
+#include "fast_random.hpp"
+#include "tree_estimator.hpp"
+#include "graph_generators.hpp"
+
+#include <omp.h>
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+
+static std::vector<uint64_t> Draw(Xoshiro256& generator, int count) {
+    std::vector<uint64_t> values;
+    for ( int i = 0; i < count; i++ ) {
+        values.push_back(generator());
+    }
+    return values;
+}
+
+int main() {
+    Xoshiro256 first(42), again(42), other(43);
+    std::vector<uint64_t> drawn = Draw(first, 100);
+    std::cout << "Same seed, same numbers: " << (drawn == Draw(again, 100)) << ", other seed: "
+              << (drawn == Draw(other, 100)) << " (expected 1, 0)" << std::endl;
+
+    Xoshiro256 generator(7);
+    bool in_range = true;
+    std::vector<int> counts(6, 0);
+    double lowest = 1, highest = 0;
+    for ( int i = 0; i < 60000; i++ ) {
+        uint64_t value = generator.Below(6);
+        in_range = in_range && value < 6;
+        if ( value < 6 ) counts[value]++;
+        double uniform = generator.Uniform();
+        lowest = std::min(lowest, uniform);
+        highest = std::max(highest, uniform);
+    }
+    std::cout << "Below(6) in range: " << in_range << ", counts";
+    for ( int count : counts ) std::cout << " " << count;
+    std::cout << " (expected 1, about 10000 each)" << std::endl;
+    std::cout << "Uniform in [0, 1): " << (lowest >= 0 && highest < 1) << " (expected 1)" << std::endl;
+
+    // streams of the threads of two ranks
+    std::set<uint64_t> starts;
+    std::vector<uint64_t> rank_0(4), rank_0_again(4), rank_1(4);
+    for ( int rank : {0, 1} ) {
+        ThreadRandom::Seed(1234, rank);
+        #pragma omp parallel num_threads(4)
+        {
+            uint64_t value = ThreadRandom::Get()();
+            (rank == 0 ? rank_0 : rank_1)[omp_get_thread_num()] = value;
+        }
+    }
+    ThreadRandom::Seed(1234, 0);
+    #pragma omp parallel num_threads(4)
+    {
+        rank_0_again[omp_get_thread_num()] = ThreadRandom::Get()();
+    }
+    starts.insert(rank_0.begin(), rank_0.end());
+    starts.insert(rank_1.begin(), rank_1.end());
+    std::cout << "Seed again, same streams: " << (rank_0 == rank_0_again) << ", distinct streams of 2 ranks x 4 threads: "
+              << starts.size() << " (expected 1, 8)" << std::endl;
+
+    ThreadRandom::Seed(0, 0);
+    std::cout << "Seed 0 draws a seed: " << (ThreadRandom::GetSeed() != 0) << " (expected 1)" << std::endl;
+
+    std::unique_ptr<CSRGraph> graph = GraphGenerator::Random(60, 0.3, 5).ToCSRGraph();
+    std::atomic<bool> stop(false);
+    std::vector<double> probes[2];
+    for ( std::vector<double>& estimates : probes ) {
+        ThreadRandom::Seed(99, 0);
+        TreeSizeEstimator estimator;
+        for ( int i = 0; i < 20; i++ ) {
+            estimates.push_back(estimator.Probe(*graph, 60, stop));
+        }
+    }
+    std::cout << "Estimators seeded from the same stream, same dives: " << (probes[0] == probes[1]) << " (expected 1)"
+              << std::endl;
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <memory>
 #include <chrono>
 #include <cmath>
+#include <algorithm>
 
 #include "graph.hpp"
 #include "csr_graph.hpp"
@@ -0,0 +1,143 @@
+#include "csr_graph.hpp"
+#include "dimacs.hpp"
+#include "graph_reducer.hpp"
+#include "connected_components.hpp"
+#include "k_core.hpp"
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <memory>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief writes a small graph: the wheel with hub 1 and rim 2-3-4-5-6 (chromatic number 4,
+ *        largest clique 3), the path 2-7-8 and vertex 9 attached to 1 and 2
+ */
+void write_test_graph(const std::string& file_name) {
+    std::ofstream out(file_name);
+    out << "c wheel 1-(2..6), path 2-7-8, vertex 9 attached to 1 and 2\n";
+    out << "p edge 9 14\n";
+    out << "e 1 2\ne 1 3\ne 1 4\ne 1 5\ne 1 6\n";
+    out << "e 2 3\ne 3 4\ne 4 5\ne 5 6\ne 6 2\n";
+    out << "e 2 7\ne 7 8\n";
+    out << "e 9 1\ne 9 2\n";
+}
+
+void test_peeling(const std::string& file_name, int lb) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+    CSRGraph reduced(graph);
+    GraphReducer reducer(reduced);
+
+    int removed = reducer.PeelLowDegree(lb);
+    std::cout << "Peeling with lb = " << lb << std::endl;
+    std::cout << "  Removed vertices:   " << removed << std::endl;
+    std::cout << "  Remaining vertices: " << TestFunctions::VecToString(reduced.GetVertices()) << std::endl;
+    std::cout << "  Remaining edges:    " << reduced.GetNumEdges() << std::endl;
+
+    // coloring the reduced graph with one color per vertex, it is valid though not optimal
+    std::vector<unsigned short> coloring(graph.GetFullColoring().size(), 0);
+    unsigned short color = 1;
+    for ( int vertex : reduced.GetVertices() ) {
+        coloring[vertex] = color++;
+    }
+
+    reducer.RestoreColoring(coloring);
+    graph.SetFullColoring(coloring);
+    std::cout << "  Restored coloring:  " << TestFunctions::VecToString(coloring) << std::endl;
+    std::cout << "  Coloring is " << (TestFunctions::CheckColoring(graph) ? "valid" : "NOT valid") << std::endl;
+}
+
+void test_dominated(const std::string& file_name) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+    CSRGraph reduced(graph);
+    GraphReducer reducer(reduced);
+
+    int removed = reducer.RemoveDominated();
+    std::cout << "Removing dominated vertices" << std::endl;
+    std::cout << "  Removed vertices:   " << removed << std::endl;
+    std::cout << "  Remaining vertices: " << TestFunctions::VecToString(reduced.GetVertices()) << std::endl;
+
+    std::vector<unsigned short> coloring(graph.GetFullColoring().size(), 0);
+    unsigned short color = 1;
+    for ( int vertex : reduced.GetVertices() ) {
+        coloring[vertex] = color++;
+    }
+
+    reducer.RestoreColoring(coloring);
+    graph.SetFullColoring(coloring);
+    std::cout << "  Restored coloring:  " << TestFunctions::VecToString(coloring) << std::endl;
+    std::cout << "  Coloring is " << (TestFunctions::CheckColoring(graph) ? "valid" : "NOT valid") << std::endl;
+}
+
+void test_components(const std::string& file_name) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+
+    std::vector<std::vector<int>> components = ConnectedComponents(graph);
+    std::cout << "Connected components: " << components.size() << std::endl;
+    for ( const std::vector<int>& component_vertices : components ) {
+        std::unique_ptr<CSRGraph> component = graph.InducedSubgraph(component_vertices);
+        std::cout << "  Vertices: " << TestFunctions::VecToString(component->GetVertices()) 
+                  << "- edges: " << component->GetNumEdges() << std::endl;
+    }
+}
+
+void test_k_core(const std::string& file_name, int k) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+    CSRGraph core(graph);
+
+    std::vector<int> peeled = PeelKCore(core, k);
+    std::cout << "Peeling the " << k << "-core" << std::endl;
+    std::cout << "  Peeled vertices: " << TestFunctions::VecToString(peeled) << std::endl;
+    std::cout << "  Core vertices:   " << TestFunctions::VecToString(core.GetVertices()) << std::endl;
+
+    // one color per core vertex, then the peeled ones are colored greedily
+    std::vector<unsigned short> coloring(graph.GetFullColoring().size(), 0);
+    unsigned short color = 1;
+    for ( int vertex : core.GetVertices() ) {
+        coloring[vertex] = color++;
+    }
+    unsigned short num_colors = ExtendCoreColoring(graph, peeled, coloring);
+    graph.SetFullColoring(coloring);
+    std::cout << "  Colors used:     " << num_colors << std::endl;
+    std::cout << "  Coloring is " << (TestFunctions::CheckColoring(graph) ? "valid" : "NOT valid") << std::endl;
+}
+
+int main() {
+    std::string file_name = "reduction_test_graph.col";
+    write_test_graph(file_name);
+
+    // lb = 3 (a triangle): only the wheel is left
+    test_peeling(file_name, 3);
+    // lb = 4 (the chromatic number): the rim has degree 3, so everything is peeled
+    test_peeling(file_name, 4);
+    // lb = 1 removes nothing
+    test_peeling(file_name, 1);
+
+    // N(8) = {7} is contained in N(2) and N(9) = {1, 2} in N(3): 8 and 9 are dominated
+    test_dominated(file_name);
+    // in the 4-cycle the opposite vertices are twins: it collapses to a single edge
+
+    std::string cycle_file_name = "reduction_test_cycle.col";
+    {
+        std::ofstream out(cycle_file_name);
+        out << "p edge 4 4\ne 1 2\ne 2 3\ne 3 4\ne 4 1\n";
+    }
+    test_dominated(cycle_file_name);
+
+    // a triangle, an edge and an isolated vertex: three components, triangle first
+    std::string components_file_name = "reduction_test_components.col";
+    {
+        std::ofstream out(components_file_name);
+        out << "p edge 6 4\ne 4 5\ne 1 2\ne 2 3\ne 3 1\n";
+    }
+    test_components(components_file_name);
+
+    // the 3-core is the wheel; with 4 colors everything is peeled and colored greedily
+    test_k_core(file_name, 3);
+    test_k_core(file_name, 4);
+
+    return 0;
+}
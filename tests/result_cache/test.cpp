@@ -0,0 +1,79 @@
+#include "csr_graph.hpp"
+#include "dimacs.hpp"
+#include "graph_fingerprint.hpp"
+#include "result_cache.hpp"
+
+#include "test_common.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+uint64_t fingerprint_of(const std::string& file_name, const std::string& content) {
+    std::ofstream(file_name) << content;
+    Dimacs dimacs;
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name, dimacs);
+    return GraphFingerprint(graph);
+}
+
+void print_entry(const std::string& message, const ResultCache& cache, uint64_t fingerprint) {
+    CacheEntry entry;
+    bool found = cache.Lookup(fingerprint, entry);
+    std::cout << message << ": found " << found << ", bounds " << entry.lower_bound << ".." << entry.upper_bound
+              << ", optimal " << entry.optimal << ", coloring " << TestFunctions::VecToString(entry.coloring) << std::endl;
+}
+
+int main() {
+    // triangle 1-2-3 with the pendant vertex 4 on 3
+    uint64_t fingerprint = fingerprint_of("result_cache_test_graph.col", "p edge 4 4\ne 1 2\ne 2 3\ne 1 3\ne 3 4\n");
+    uint64_t shuffled = fingerprint_of("result_cache_test_shuffled.col", "p edge 4 4\ne 4 3\ne 3 1\ne 2 1\ne 3 2\n");
+    uint64_t isolated = fingerprint_of("result_cache_test_isolated.col", "p edge 5 4\ne 1 2\ne 2 3\ne 1 3\ne 3 4\n");
+    uint64_t other = fingerprint_of("result_cache_test_other.col", "p edge 4 4\ne 1 2\ne 2 3\ne 1 3\ne 2 4\n");
+    std::cout << "Fingerprint: " << FingerprintToString(fingerprint) << " (expected 16 hexadecimal digits)" << std::endl;
+    std::cout << "Same edges in another order: " << (shuffled == fingerprint) << " (expected 1)" << std::endl;
+    std::cout << "With an isolated vertex: " << (isolated == fingerprint) << " (expected 0)" << std::endl;
+    std::cout << "Pendant vertex on another vertex: " << (other == fingerprint) << " (expected 0)" << std::endl;
+
+    std::string directory = "result_cache_test";
+    std::filesystem::remove_all(directory);
+    ResultCache cache(directory);
+    print_entry("Empty cache (expected found 0)", cache, fingerprint);
+
+    CacheEntry entry;
+    entry.lower_bound = 3;
+    entry.upper_bound = 4;
+    entry.coloring = {0, 1, 2, 3, 4};
+    std::cout << "Store: " << cache.Store(fingerprint, "result_cache_test", entry) << " (expected 1)" << std::endl;
+    print_entry("Round trip (expected bounds 3..4, optimal 0, coloring 0 1 2 3 4)", cache, fingerprint);
+    print_entry("Other graph (expected found 0)", cache, other);
+
+    // a worse coloring is not kept, a higher lower bound is
+    entry.lower_bound = 2;
+    entry.upper_bound = 5;
+    entry.coloring = {0, 1, 2, 3, 5};
+    cache.Store(fingerprint, "result_cache_test", entry);
+    print_entry("Worse run merged (expected bounds 3..4, coloring 0 1 2 3 4)", cache, fingerprint);
+
+    // reaching the lower bound proves the coloring optimal
+    entry.lower_bound = 0;
+    entry.upper_bound = 3;
+    entry.coloring = {0, 1, 2, 3, 1};
+    cache.Store(fingerprint, "result_cache_test", entry);
+    print_entry("Better run merged (expected bounds 3..3, optimal 1, coloring 0 1 2 3 1)", cache, fingerprint);
+
+    std::string path = directory + "/" + FingerprintToString(fingerprint) + ".txt";
+    std::ofstream(path) << "lower_bound 3\nupper_bound 3\noptimal 1\n1 1\n99999999999999999999999 2\n";
+    print_entry("Vertex out of range (expected found 0, bounds 0..65535)", cache, fingerprint);
+    std::ofstream(path) << "lower_bound 3\nupper_bound 3\noptimal 1\n1 1\n2x 2\n";
+    print_entry("Vertex which is not a number (expected found 0)", cache, fingerprint);
+
+    entry.lower_bound = 2;
+    entry.upper_bound = 4;
+    entry.optimal = false;
+    entry.coloring = {0, 1, 2, 3, 4};
+    cache.Store(fingerprint, "result_cache_test", entry);
+    print_entry("Corrupt entry replaced (expected bounds 2..4, optimal 0)", cache, fingerprint);
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "csr_graph.hpp"
+#include "dimacs.hpp"
+#include "result_writer.hpp"
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+std::string read_file(const std::string& file_name) {
+    std::ifstream in(file_name);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+int main() {
+    // triangle 1-2-3 with the pendant vertex 4 on 3
+    std::string file_name = "result_writer_test_graph.col";
+    {
+        std::ofstream out(file_name);
+        out << "p edge 4 4\n";
+        out << "e 1 2\ne 2 3\ne 1 3\ne 3 4\n";
+    }
+    Dimacs dimacs;
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name, dimacs);
+    std::cout << "Vertices: " << TestFunctions::VecToString(graph.GetVertices()) << std::endl;
+
+    // the coloring is indexed by vertex, whatever the first vertex is
+    std::vector<unsigned short> coloring(graph.GetFullColoring().size(), 0);
+    std::vector<unsigned short> colors = {1, 2, 3, 1};
+    for ( size_t i = 0; i < graph.GetVertices().size(); i++ ) {
+        coloring[graph.GetVertices()[i]] = colors[i];
+    }
+    std::cout << "Valid coloring: " << VerifyColoring(graph, coloring) << " (expected 1)" << std::endl;
+
+    std::vector<unsigned short> conflict = coloring;
+    conflict[graph.GetVertices()[3]] = 3;
+    std::cout << "Pendant vertex with the color of its neighbour: " << VerifyColoring(graph, conflict)
+              << " (expected 0)" << std::endl;
+
+    std::vector<unsigned short> uncolored = coloring;
+    uncolored[graph.GetVertices()[1]] = 0;
+    std::cout << "Uncolored vertex: " << VerifyColoring(graph, uncolored) << " (expected 0)" << std::endl;
+
+    // vertices 3 and 4 are past its end, also as neighbours of 1 and 2: none of them is read
+    std::vector<unsigned short> short_coloring(coloring.begin(), coloring.begin() + graph.GetVertices()[2]);
+    std::cout << "Coloring shorter than the graph: " << VerifyColoring(graph, short_coloring) << " (expected 0)"
+              << std::endl;
+
+    ResultWriter writer("result_writer_test");
+    writer.SetCommandLine("run_instance result_writer_test_graph.col");
+    writer.SetGraphSize(graph.GetNumVertices(), graph.GetNumEdges());
+    writer.SetTimeLimit(60);
+    writer.SetResources(2, 4);
+    writer.SetWallTime(1.5);
+    writer.SetColoring(graph.GetVertices(), coloring);
+    writer.AddTiming("read", 0.25);
+    writer.AddCounter("nodes", 12);
+    writer.AddFeature("density", 0.5);
+    writer.AddStatistic("clones", 1234567890123);
+    std::cout << "Number of colors: " << writer.GetNumberOfColors() << " (expected 3)" << std::endl;
+
+    std::cout << "Write text: " << writer.WriteText("result_writer_test.txt") << " (expected 1)" << std::endl;
+    std::cout << read_file("result_writer_test.txt")
+              << "(expected the format of results/, with the four vertices colored 1 2 3 1 and clones 1234567890123)"
+              << std::endl;
+    std::cout << "Write JSON: " << writer.WriteJson("result_writer_test.json") << " (expected 1)" << std::endl;
+    std::cout << read_file("result_writer_test.json")
+              << "(expected the same result with the timing read, the counter nodes and the feature density)"
+              << std::endl;
+
+    std::cout << "Write to a missing directory: " << writer.WriteText("missing_directory/result.txt")
+              << " (expected 0)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "csr_graph.hpp"
+#include "cdcl_solver.hpp"
+#include "sat_coloring.hpp"
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+std::string ResultToString(CDCLSolver::Result result) {
+    switch ( result ) {
+        case CDCLSolver::Result::SAT:   return "SAT";
+        case CDCLSolver::Result::UNSAT: return "UNSAT";
+        default:                        return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief pigeonhole principle: `pigeons` pigeons in `holes` holes, each hole with at most 
+ *        one pigeon. Satisfiable if and only if pigeons <= holes
+ */
+void test_pigeonhole(int pigeons, int holes) {
+    CDCLSolver solver;
+    for ( int var = 0; var < pigeons * holes; var++ ) {
+        solver.NewVar();
+    }
+
+    for ( int p = 0; p < pigeons; p++ ) {
+        std::vector<int> clause;
+        for ( int h = 0; h < holes; h++ ) {
+            clause.push_back(CDCLSolver::Lit(p * holes + h));
+        }
+        solver.AddClause(clause);
+    }
+    for ( int h = 0; h < holes; h++ ) {
+        for ( int p = 0; p < pigeons; p++ ) {
+            for ( int q = p + 1; q < pigeons; q++ ) {
+                solver.AddClause({ CDCLSolver::Lit(p * holes + h, true), CDCLSolver::Lit(q * holes + h, true) });
+            }
+        }
+    }
+
+    CDCLSolver::Result result = solver.Solve(100000);
+    std::cout << "Pigeonhole " << pigeons << " in " << holes << ": " << ResultToString(result) 
+              << " (" << solver.GetNumConflicts() << " conflicts)" << std::endl;
+}
+
+void test_coloring(const std::string& file_name, int k) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+
+    CDCLSolver::Result result = SatColor(graph, k, {}, 100000);
+    std::cout << file_name << " with " << k << " colors: " << ResultToString(result);
+    if ( result == CDCLSolver::Result::SAT ) {
+        std::cout << ", coloring is " << (TestFunctions::CheckColoring(graph) ? "valid" : "NOT valid");
+    }
+    std::cout << std::endl;
+}
+
+int main() {
+    test_pigeonhole(4, 4);
+    test_pigeonhole(5, 4);
+    test_pigeonhole(7, 6);
+
+    // Petersen graph: chromatic number 3
+    std::string petersen_file_name = "sat_test_petersen.col";
+    {
+        std::ofstream out(petersen_file_name);
+        out << "p edge 10 15\n";
+        out << "e 1 2\ne 2 3\ne 3 4\ne 4 5\ne 5 1\n";
+        out << "e 1 6\ne 2 7\ne 3 8\ne 4 9\ne 5 10\n";
+        out << "e 6 8\ne 8 10\ne 10 7\ne 7 9\ne 9 6\n";
+    }
+    test_coloring(petersen_file_name, 2);
+    test_coloring(petersen_file_name, 3);
+
+    // Grotzsch graph (myciel4 of the 5-cycle): triangle free, chromatic number 4
+    std::string grotzsch_file_name = "sat_test_grotzsch.col";
+    {
+        std::ofstream out(grotzsch_file_name);
+        out << "p edge 11 20\n";
+        out << "e 1 2\ne 2 3\ne 3 4\ne 4 5\ne 5 1\n";
+        out << "e 6 2\ne 6 5\ne 7 1\ne 7 3\ne 8 2\ne 8 4\ne 9 3\ne 9 5\ne 10 4\ne 10 1\n";
+        out << "e 11 6\ne 11 7\ne 11 8\ne 11 9\ne 11 10\n";
+    }
+    test_coloring(grotzsch_file_name, 3);
+    test_coloring(grotzsch_file_name, 4);
+
+    return 0;
+}
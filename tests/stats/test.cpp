@@ -0,0 +1,71 @@
+#include "solver_stats.hpp"
+#include "csr_graph.hpp"
+
+#include "test_common.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    SolverStats::Reset();
+
+    // every thread counts on its own
+    #pragma omp parallel num_threads(4)
+    {
+        for ( int i = 0; i < 1000; i++ ) {
+            SolverStats::Count(StatCounter::NODES_PROCESSED);
+        }
+        SolverStats::Count(StatCounter::BYTES_SENT, 10);
+    }
+
+    {
+        PhaseTimer timer(StatPhase::MPI);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    auto graph = std::make_unique<CSRGraph>();
+    auto clone = graph->Clone();
+
+    // a thread which does not count, as the progress estimator, drops what it counts
+    std::thread([&graph]() {
+        SolverStats::SetCounted(false);
+        SolverStats::Count(StatCounter::NODES_PROCESSED, 500);
+        auto uncounted_clone = graph->Clone();
+        PhaseTimer timer(StatPhase::CLIQUE);
+    }).join();
+
+    StatsReport report = SolverStats::Reduce(MPI_COMM_WORLD);
+    std::cout << "Nodes processed: " << report.counters[static_cast<size_t>(StatCounter::NODES_PROCESSED)] 
+              << " (expected 4000)" << std::endl;
+    std::cout << "Bytes sent: " << report.counters[static_cast<size_t>(StatCounter::BYTES_SENT)] 
+              << " (expected 40)" << std::endl;
+    std::cout << "Clones: " << report.counters[static_cast<size_t>(StatCounter::CLONES)] 
+              << " (expected 1)" << std::endl;
+    std::cout << "Clique phase: " << report.calls[static_cast<size_t>(StatPhase::CLIQUE)] << " calls (expected 0)"
+              << std::endl;
+    std::cout << "MPI phase: " << report.seconds[static_cast<size_t>(StatPhase::MPI)] << " s in " 
+              << report.calls[static_cast<size_t>(StatPhase::MPI)] << " call (expected about 0.1 s in 1)" << std::endl;
+
+    // cost of a timed phase, to be compared with the microseconds of the phases timed
+    const int repetitions = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < repetitions; i++ ) {
+        PhaseTimer timer(StatPhase::BRANCHING);
+        SolverStats::Count(StatCounter::PRUNED_BEST);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Overhead of a timer and a counter: " << seconds / repetitions * 1e9 << " ns" << std::endl;
+
+    SolverStats::Reset();
+    report = SolverStats::Collect();
+    std::cout << "After reset: " << report.counters[static_cast<size_t>(StatCounter::NODES_PROCESSED)] 
+              << " nodes (expected 0)" << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "status_server.hpp"
+
+#include "test_common.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// sends the commands to the socket and returns everything received until it is closed
+static std::string Query(const std::string& path, const std::string& commands) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if ( connect(fd, (sockaddr*) &address, sizeof(address)) == -1 ) {
+        close(fd);
+        return "cannot connect";
+    }
+    send(fd, commands.data(), commands.size(), 0);
+    std::string answer;
+    char buffer[256];
+    ssize_t received;
+    while ( (received = recv(fd, buffer, sizeof(buffer), 0)) > 0 ) {
+        answer.append(buffer, received);
+    }
+    close(fd);
+    return answer;
+}
+
+int main() {
+    StatusServer server;
+    StatusSnapshot snapshot;
+    snapshot.running = true;
+    snapshot.elapsed = 12.5;
+    snapshot.best_ub = 15;
+    snapshot.global_lb = 13;
+    snapshot.nodes = 3000;
+    snapshot.nodes_per_second = 250;
+    snapshot.steals_per_second = 0.5;
+    snapshot.ranks = {RankStatus{1000, 4, 1}, RankStatus{2000, 6, 2}};
+    server.Publish(snapshot);
+
+    std::cout << "Answer to status:\n" << server.Answer("status")
+              << "(expected running 1, best_ub 15, global_lb 13, nodes 3000, queued 10, ranks 2, no estimates)" << std::endl;
+    std::cout << "Answer to ranks:\n" << server.Answer("ranks") << "(expected 0 1000 4 1 and 1 2000 6 2)" << std::endl;
+    std::cout << "Answer to an unknown command: " << server.Answer("stop") << "(expected error unknown command stop)"
+              << std::endl;
+
+    std::string path = "status_test.sock";
+    std::string error;
+    bool started = server.Start(path, error);
+    std::cout << "Started: " << started << " " << error << " (expected 1)" << std::endl;
+
+    snapshot.estimated = true;
+    snapshot.progress.remaining = 40000;
+    server.Publish(snapshot);
+    std::string answer = Query(path, "ranks\nstatus\nquit\n");
+    std::cout << "Over the socket:\n" << answer << "(expected the ranks, then the status with estimated_nodes_left 40000, "
+              << "then closed by quit)" << std::endl;
+    std::cout << "Two commands in one line are one unknown command: " << Query(path, "status ranks\nquit\n")
+              << "(expected error)" << std::endl;
+
+    server.Stop();
+    std::cout << "Socket removed after Stop: " << (access(path.c_str(), F_OK) != 0) << " (expected 1)" << std::endl;
+    std::string file = "status_test.txt";
+    std::ofstream(file) << "not a socket\n";
+    std::cout << "Regular file as path: " << server.Start(file, error) << " " << error << " (expected 0)" << std::endl;
+    std::cout << "File kept: " << (access(file.c_str(), F_OK) == 0) << " (expected 1)" << std::endl;
+    unlink(file.c_str());
+    std::cout << "Invalid path: " << server.Start(std::string(200, 'x'), error) << " " << error << " (expected 0)"
+              << std::endl;
+    return 0;
+}
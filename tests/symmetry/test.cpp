@@ -0,0 +1,86 @@
+#include "csr_graph.hpp"
+#include "automorphism.hpp"
+#include "symmetry_breaking.hpp"
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void test_orbits(const std::string& file_name) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+    AutomorphismFinder finder(graph);
+
+    std::vector<std::vector<int>> orbits = finder.Orbits();
+    std::cout << "Orbits of " << file_name << ": " << orbits.size() << std::endl;
+    for ( const std::vector<int>& orbit : orbits ) {
+        std::cout << "  " << TestFunctions::VecToString(orbit) << std::endl;
+    }
+    std::cout << "  Automorphisms found: " << finder.GetNumAutomorphisms() << std::endl;
+}
+
+void test_stabilizer_orbit(const std::string& file_name, int u, int v) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+    AutomorphismFinder finder(graph);
+
+    std::cout << "Orbit of " << v << " fixing " << u << " in " << file_name << ": " 
+              << TestFunctions::VecToString(finder.StabilizerOrbit(u, v)) << std::endl;
+}
+
+void test_symmetric_edges(const std::string& file_name, int u, int v) {
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name);
+    CSRGraph child(graph);
+    child.AddEdge(u, v);
+
+    int added = AddSymmetricEdges(graph, child, u, v);
+    std::cout << "Branching on (" << u << ", " << v << ") in " << file_name 
+              << ": added " << added << " edges, " << child.GetNumEdges() << " in total" << std::endl;
+}
+
+int main() {
+    // wheel with hub 1: the hub is fixed, the rim is a single orbit
+    std::string wheel_file_name = "symmetry_test_wheel.col";
+    {
+        std::ofstream out(wheel_file_name);
+        out << "p edge 6 10\n";
+        out << "e 1 2\ne 1 3\ne 1 4\ne 1 5\ne 1 6\n";
+        out << "e 2 3\ne 3 4\ne 4 5\ne 5 6\ne 6 2\n";
+    }
+    test_orbits(wheel_file_name);
+
+    // Petersen graph: vertex transitive, fixing 1 its 3 neighbours and its 6 
+    // non-neighbours are two orbits
+    std::string petersen_file_name = "symmetry_test_petersen.col";
+    {
+        std::ofstream out(petersen_file_name);
+        out << "p edge 10 15\n";
+        out << "e 1 2\ne 2 3\ne 3 4\ne 4 5\ne 5 1\n";
+        out << "e 1 6\ne 2 7\ne 3 8\ne 4 9\ne 5 10\n";
+        out << "e 6 8\ne 8 10\ne 10 7\ne 7 9\ne 9 6\n";
+    }
+    test_orbits(petersen_file_name);
+    test_stabilizer_orbit(petersen_file_name, 1, 2);
+    test_stabilizer_orbit(petersen_file_name, 1, 3);
+
+    // a path has only the reversal: fixing an end nothing moves
+    std::string path_file_name = "symmetry_test_path.col";
+    {
+        std::ofstream out(path_file_name);
+        out << "p edge 4 3\ne 1 2\ne 2 3\ne 3 4\n";
+    }
+    test_orbits(path_file_name);
+    test_stabilizer_orbit(path_file_name, 1, 3);
+
+    // 6-cycle: fixing 1 the reflection swaps 3 and 5, so 1-5 is added, and fixing 3
+    // it swaps 1 and 5, so 3-5 is added as well
+    std::string cycle_file_name = "symmetry_test_cycle.col";
+    {
+        std::ofstream out(cycle_file_name);
+        out << "p edge 6 6\ne 1 2\ne 2 3\ne 3 4\ne 4 5\ne 5 6\ne 6 1\n";
+    }
+    test_symmetric_edges(cycle_file_name, 1, 3);
+
+    return 0;
+}
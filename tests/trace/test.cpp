@@ -0,0 +1,67 @@
+#include "timeline_trace.hpp"
+#include "solver_stats.hpp"
+
+#include "test_common.hpp"
+
+#include <mpi.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static int Occurrences(const std::string& text, const std::string& pattern) {
+    int count = 0;
+    for ( size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1) ) {
+        count++;
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    {
+        TraceSpan before("not recorded");
+    }
+    std::cout << "Enabled before Start: " << TimelineTrace::Enabled() << " (expected 0)" << std::endl;
+
+    TimelineTrace::Start(MPI_COMM_WORLD);
+    TimelineTrace::NameThread("worker");
+    {
+        TraceSpan span("evaluate node");
+        PhaseTimer timer(StatPhase::COLOR);
+    }
+    // a message to this rank, both ends of the flow
+    {
+        TraceSpan span("steal request");
+        TimelineTrace::MessageSent(MPI_COMM_WORLD, 0, 1);
+        TimelineTrace::MessageSent(MPI_COMM_WORLD, 0, 1);
+    }
+    {
+        TraceSpan span("steal response");
+        TimelineTrace::MessageReceived(MPI_COMM_WORLD, 0, 1);
+        TimelineTrace::MessageReceived(MPI_COMM_WORLD, 0, 1);
+    }
+    std::string file_name = "trace_test.json";
+    std::cout << "Written: " << TimelineTrace::Write(file_name) << " (expected 1)" << std::endl;
+    {
+        TraceSpan after("not recorded");
+    }
+
+    std::ifstream in(file_name);
+    std::stringstream text;
+    text << in.rdbuf();
+    std::string trace = text.str();
+    std::cout << "Spans: " << Occurrences(trace, "\"ph\": \"X\"") << " (expected 4)" << std::endl;
+    std::cout << "Phase spans: " << Occurrences(trace, "\"name\": \"color\"") << " (expected 1)" << std::endl;
+    std::cout << "Flow starts: " << Occurrences(trace, "\"ph\": \"s\"") << ", ends: " << Occurrences(trace, "\"ph\": \"f\"")
+              << " (expected 2, 2)" << std::endl;
+    // the n-th message sent and the n-th received share their id
+    std::cout << "Ids of the first message: " << Occurrences(trace, "\"id\": 16777216,") 
+              << ", of the second: " << Occurrences(trace, "\"id\": 16777217,") << " (expected 2, 2)" << std::endl;
+    std::cout << "Thread named: " << Occurrences(trace, "\"args\": {\"name\": \"worker\"}") << " (expected 1)" << std::endl;
+    std::cout << "Not recorded: " << Occurrences(trace, "not recorded") << " (expected 0)" << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
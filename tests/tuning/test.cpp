@@ -0,0 +1,63 @@
+#include "csr_graph.hpp"
+#include "dimacs.hpp"
+#include "instance_features.hpp"
+#include "strategy_tuner.hpp"
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void print_choice(const std::string& message, const TuningChoice& choice) {
+    std::cout << message << ": color " << choice.color_strategy << ", balanced " << choice.balanced
+              << ", period " << choice.sol_gather_period << ", " << choice.rationale << std::endl;
+}
+
+int main() {
+    // triangle 1-2-3 with a pendant path 3-4-5, and the isolated edge 6-7
+    std::string file_name = "tuning_test_graph.col";
+    {
+        std::ofstream out(file_name);
+        out << "p edge 7 6\n";
+        out << "e 1 2\ne 2 3\ne 1 3\ne 3 4\ne 4 5\ne 6 7\n";
+    }
+    Dimacs dimacs;
+    CSRGraph& graph = *CSRGraph::LoadFromDimacs(file_name, dimacs);
+    InstanceFeatures features = ExtractFeatures(dimacs, graph, 4);
+
+    std::cout << "Min degree: " << features.min_degree << " (expected 1)" << std::endl;
+    std::cout << "Max degree: " << features.max_degree << " (expected 3)" << std::endl;
+    std::cout << "Degeneracy: " << features.degeneracy << " (expected 2)" << std::endl;
+    std::cout << "Clique: " << features.clique_size << " (expected 3)" << std::endl;
+    std::cout << "Components: " << features.num_components << " (expected 2)" << std::endl;
+    float total = 0;
+    std::cout << "Degree histogram:";
+    for ( float fraction : features.degree_histogram ) {
+        std::cout << " " << fraction;
+        total += fraction;
+    }
+    std::cout << " (sums to " << total << ", expected 1)" << std::endl;
+
+    StrategyTuner tuner;
+    TuningChoice defaults;
+    print_choice("Built-in table", tuner.Choose(features, defaults));
+
+    std::string error;
+    StrategyTuner custom;
+    std::ofstream("tuning_test_rules.txt") << "# hand-written table\n"
+                                           << "when components>=2 density<0.5 use color=2 period=3 because split graphs\n"
+                                           << "use balanced=0 because otherwise\n";
+    std::cout << "Load rules: " << custom.LoadRules("tuning_test_rules.txt", error) << " (expected 1)" << std::endl;
+    print_choice("First rule matches (color 2, balanced 1, period 3)", custom.Choose(features, defaults));
+    features.num_components = 1;
+    print_choice("Fallback rule (color 0, balanced 0, period 10)", custom.Choose(features, defaults));
+
+    std::cout << "Unknown feature: " << custom.AddRule("when colors>2 use color=1", error) << " (expected 0)" << std::endl;
+    std::cout << error << std::endl;
+    std::cout << "Missing settings: " << custom.AddRule("when gap>2 because", error) << " (expected 0)" << std::endl;
+    std::cout << error << std::endl;
+
+    return 0;
+}